@@ -170,6 +170,22 @@ PyAPI_FUNC(int) PyCode_Addr2Line(PyCodeObject *, int);
 
 PyAPI_FUNC(int) PyCode_Addr2Location(PyCodeObject *, int, int *, int *, int *, int *);
 
+/* Code object watchers */
+
+typedef enum {
+    PY_CODE_EVENT_CREATE,
+    PY_CODE_EVENT_DESTROY,
+} PyCodeEvent;
+
+/* Callback invoked after a code object is created and before it is
+   destroyed.  The callback must not create or destroy code objects. */
+typedef int (*PyCode_WatchCallback)(PyCodeEvent event, PyCodeObject *co);
+
+/* Register or unregister a code watcher callback.  Watchers are notified
+   of the events of all the code objects of the interpreter. */
+PyAPI_FUNC(int) PyCode_AddWatcher(PyCode_WatchCallback callback);
+PyAPI_FUNC(int) PyCode_ClearWatcher(int watcher_id);
+
 /* for internal use only */
 struct _opaque {
     int computed_line;
@@ -83,3 +83,30 @@ typedef struct {
 
 PyAPI_FUNC(PyObject *) _PyDictView_New(PyObject *, PyTypeObject *);
 PyAPI_FUNC(PyObject *) _PyDictView_Intersect(PyObject* self, PyObject *other);
+
+/* Dictionary watchers */
+
+typedef enum {
+    PyDict_EVENT_ADDED,
+    PyDict_EVENT_MODIFIED,
+    PyDict_EVENT_DELETED,
+    PyDict_EVENT_CLONED,
+    PyDict_EVENT_CLEARED,
+    PyDict_EVENT_DEALLOCATED,
+} PyDict_WatchEvent;
+
+// Callback invoked before a watched dict is modified, cleared or
+// deallocated.  key and new_value are NULL for the clear and dealloc
+// events; key is the dict being copied for the clone event; new_value is
+// NULL for the delete event.
+typedef int(*PyDict_WatchCallback)(PyDict_WatchEvent event, PyObject* dict,
+                                   PyObject* key, PyObject* new_value);
+
+// Register or unregister a dict watcher callback.
+PyAPI_FUNC(int) PyDict_AddWatcher(PyDict_WatchCallback callback);
+PyAPI_FUNC(int) PyDict_ClearWatcher(int watcher_id);
+
+// Mark the given dictionary as watched (or no longer watched) by the
+// given watcher.
+PyAPI_FUNC(int) PyDict_Watch(int watcher_id, PyObject* dict);
+PyAPI_FUNC(int) PyDict_Unwatch(int watcher_id, PyObject* dict);
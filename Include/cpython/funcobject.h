@@ -129,6 +129,29 @@ PyAPI_DATA(PyTypeObject) PyStaticMethod_Type;
 PyAPI_FUNC(PyObject *) PyClassMethod_New(PyObject *);
 PyAPI_FUNC(PyObject *) PyStaticMethod_New(PyObject *);
 
+/* Function watchers */
+
+typedef enum {
+    PyFunction_EVENT_CREATE,
+    PyFunction_EVENT_DESTROY,
+    PyFunction_EVENT_MODIFY_CODE,
+    PyFunction_EVENT_MODIFY_DEFAULTS,
+    PyFunction_EVENT_MODIFY_KWDEFAULTS,
+} PyFunction_WatchEvent;
+
+// Callback invoked when a function is created, before it is destroyed and
+// before its __code__, __defaults__ or __kwdefaults__ is modified.
+// new_value is the new value of the modified attribute (NULL if it is
+// deleted), and NULL for the create and destroy events.
+typedef int (*PyFunction_WatchCallback)(PyFunction_WatchEvent event,
+                                        PyFunctionObject *func,
+                                        PyObject *new_value);
+
+// Register or unregister a function watcher callback.  Watchers are
+// notified of the events of all the functions of the interpreter.
+PyAPI_FUNC(int) PyFunction_AddWatcher(PyFunction_WatchCallback callback);
+PyAPI_FUNC(int) PyFunction_ClearWatcher(int watcher_id);
+
 #ifdef __cplusplus
 }
 #endif
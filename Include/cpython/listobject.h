@@ -22,6 +22,12 @@ typedef struct {
 } PyListObject;
 
 PyAPI_FUNC(PyObject *) _PyList_Extend(PyListObject *, PyObject *);
+/* Make room for appending n items without reallocating the list. */
+PyAPI_FUNC(int) _PyList_Reserve(PyObject *, Py_ssize_t n);
+/* Append the n items of an array; new references are taken to the items.
+   The array must not be the list's own storage, which may be reallocated. */
+PyAPI_FUNC(int) _PyList_AppendArray(PyObject *, PyObject *const *items,
+                                    Py_ssize_t n);
 PyAPI_FUNC(void) _PyList_DebugMallocStats(FILE *out);
 
 /* Cast argument to PyListObject* type. */
@@ -224,6 +224,9 @@ struct _typeobject {
 
     destructor tp_finalize;
     vectorcallfunc tp_vectorcall;
+
+    /* bitset of which type-watchers care about this type */
+    unsigned char tp_watched;
 };
 
 /* This struct is used by the specializer
@@ -269,6 +272,20 @@ PyAPI_FUNC(PyObject *) _PyType_GetDocFromInternalDoc(const char *, const char *)
 PyAPI_FUNC(PyObject *) _PyType_GetTextSignatureFromInternalDoc(const char *, const char *);
 PyAPI_FUNC(PyObject *) PyType_GetModuleByDef(PyTypeObject *, PyModuleDef *);
 
+/* Type watchers */
+
+// Callback invoked when a watched type is modified (see PyType_Modified()).
+typedef int(*PyType_WatchCallback)(PyTypeObject *);
+
+// Register or unregister a type watcher callback.
+PyAPI_FUNC(int) PyType_AddWatcher(PyType_WatchCallback callback);
+PyAPI_FUNC(int) PyType_ClearWatcher(int watcher_id);
+
+// Mark the given type as watched (or no longer watched) by the given
+// watcher.
+PyAPI_FUNC(int) PyType_Watch(int watcher_id, PyObject *type);
+PyAPI_FUNC(int) PyType_Unwatch(int watcher_id, PyObject *type);
+
 PyAPI_FUNC(int) PyObject_Print(PyObject *, FILE *, int);
 PyAPI_FUNC(void) _Py_BreakPoint(void);
 PyAPI_FUNC(void) _PyObject_Dump(PyObject *);
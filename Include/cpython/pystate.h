@@ -184,6 +184,12 @@ struct _ts {
     PyObject **datastack_limit;
     /* XXX signal handlers should also be here */
 
+    /* Number of GIL acquisitions and time spent waiting for the GIL (in
+       nanoseconds) by this thread, counted while GIL statistics are
+       enabled. */
+    uint64_t gil_acquisitions;
+    int64_t gil_wait_time;
+
     /* The following fields are here to avoid allocation during init.
        The data is exposed through PyThreadState pointer fields.
        These fields should not be accessed directly outside of init.
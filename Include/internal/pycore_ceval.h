@@ -88,6 +88,9 @@ extern void _PyEval_FiniGIL(PyInterpreterState *interp);
 
 extern void _PyEval_ReleaseLock(PyThreadState *tstate);
 
+extern void _PyEval_SetGILStats(int enabled);
+extern PyObject* _PyEval_GetGILStats(void);
+
 extern void _PyEval_DeactivateOpCache(void);
 
 
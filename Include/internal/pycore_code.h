@@ -4,6 +4,8 @@
 extern "C" {
 #endif
 
+#define CODE_MAX_WATCHERS 8
+
 /* PEP 659
  * Specialization and quickening structs and helper functions
  */
@@ -85,6 +87,12 @@ typedef struct {
 
 #define INLINE_CACHE_ENTRIES_STORE_SUBSCR CACHE_ENTRIES(_PyStoreSubscrCache)
 
+typedef struct {
+    _Py_CODEUNIT counter;
+} _PyBinarySliceCache;
+
+#define INLINE_CACHE_ENTRIES_BINARY_SLICE CACHE_ENTRIES(_PyBinarySliceCache)
+
 typedef struct {
     _Py_CODEUNIT counter;
 } _PyForIterCache;
@@ -241,6 +249,8 @@ extern int _Py_Specialize_StoreAttr(PyObject *owner, _Py_CODEUNIT *instr,
 extern int _Py_Specialize_LoadGlobal(PyObject *globals, PyObject *builtins, _Py_CODEUNIT *instr, PyObject *name);
 extern int _Py_Specialize_BinarySubscr(PyObject *sub, PyObject *container, _Py_CODEUNIT *instr);
 extern int _Py_Specialize_StoreSubscr(PyObject *container, PyObject *sub, _Py_CODEUNIT *instr);
+extern void _Py_Specialize_BinarySlice(PyObject *container, PyObject *start,
+                                       PyObject *stop, _Py_CODEUNIT *instr);
 extern int _Py_Specialize_Call(PyObject *callable, _Py_CODEUNIT *instr,
                                int nargs, PyObject *kwnames);
 extern void _Py_Specialize_BinaryOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr,
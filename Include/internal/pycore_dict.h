@@ -26,6 +26,16 @@ extern void _PyDict_Fini(PyInterpreterState *interp);
 #  define PyDict_MAXFREELIST 80
 #endif
 
+/* The ids of the watchers of a dict are stored in the low bits of its
+   ma_version_tag. */
+#define DICT_MAX_WATCHERS 8
+
+/* Watcher used by the specializer for the globals and builtins of
+   specialized LOAD_GLOBAL instructions (see Python/specialize.c).  The
+   keys version of a dict it watches is kept when keys are added or
+   deleted: the watcher resets it when needed. */
+#define DICT_SPECIALIZER_WATCHER 0
+
 struct _Py_dict_state {
 #if PyDict_MAXFREELIST > 0
     /* Dictionary reuse scheme to save calls to malloc and free */
@@ -34,6 +44,7 @@ struct _Py_dict_state {
     PyDictKeysObject *keys_free_list[PyDict_MAXFREELIST];
     int keys_numfree;
 #endif
+    PyDict_WatchCallback watchers[DICT_MAX_WATCHERS];
 };
 
 typedef struct {
@@ -163,7 +174,42 @@ struct _dictvalues {
 
 extern uint64_t _pydict_global_version;
 
-#define DICT_NEXT_VERSION() (++_pydict_global_version)
+#define DICT_VERSION_INCREMENT (1 << DICT_MAX_WATCHERS)
+#define DICT_VERSION_MASK (DICT_VERSION_INCREMENT - 1)
+
+#define DICT_NEXT_VERSION() \
+    (_pydict_global_version += DICT_VERSION_INCREMENT)
+
+extern void _PyDict_SendEvent(int watcher_bits, PyDict_WatchEvent event,
+                              PyDictObject *mp, PyObject *key,
+                              PyObject *value);
+
+/* Notify the watchers of mp, if any, of an event about to happen to it, and
+   return the next version of mp (keeping its watcher bits). */
+static inline uint64_t
+_PyDict_NotifyEvent(PyDict_WatchEvent event, PyDictObject *mp,
+                    PyObject *key, PyObject *value)
+{
+    int watcher_bits = mp->ma_version_tag & DICT_VERSION_MASK;
+    if (watcher_bits) {
+        _PyDict_SendEvent(watcher_bits, event, mp, key, value);
+        return DICT_NEXT_VERSION() | watcher_bits;
+    }
+    return DICT_NEXT_VERSION();
+}
+
+/* Is mp watched by the specializer's watcher? */
+static inline int
+_PyDict_IsWatchedBySpecializer(PyDictObject *mp)
+{
+    return (mp->ma_version_tag & (1 << DICT_SPECIALIZER_WATCHER)) != 0;
+}
+
+/* Watch mp with the specializer's watcher, which must be set */
+extern void _PyDict_WatchForSpecializer(PyDictObject *mp);
+
+/* Invalidate the specializations depending on the keys version of mp */
+extern void _PyDict_ResetKeysVersion(PyDictObject *mp);
 
 extern PyObject *_PyObject_MakeDictFromInstanceAttributes(PyObject *obj, PyDictValues *values);
 extern PyObject *_PyDict_FromItems(
@@ -20,6 +20,44 @@ extern "C" {
 #undef FORCE_SWITCHING
 #define FORCE_SWITCHING
 
+/* Why the GIL was dropped (see sys._getgilstats()). */
+enum _PyGIL_drop_reason {
+    /* Released around a blocking call, or explicitly */
+    _PyGIL_DROP_RELEASE,
+    /* Asked for by a waiter after the switch interval elapsed */
+    _PyGIL_DROP_INTERVAL,
+    /* Asked for by a priority waiter (see sys._setgilpriority()) */
+    _PyGIL_DROP_PRIORITY,
+    _PyGIL_DROP_REASONS
+};
+
+/* Number of buckets of the wait and hold time histograms: bucket 0 counts
+   durations below 1 microsecond, bucket i durations in [2**(i-1), 2**i)
+   microseconds, and the last bucket everything longer. */
+#define _PyGIL_HIST_SIZE 24
+
+/* GIL statistics, only maintained while `enabled` is set.  Protected by
+   the GIL mutex. */
+struct _gil_stats {
+    int enabled;
+    uint64_t acquisitions;
+    /* Acquisitions which had to wait for another thread */
+    uint64_t contended;
+    /* Acquisitions by another thread than the last holder */
+    uint64_t switches;
+    /* Drops where the dropping thread made sure another one took the GIL
+       before going on (FORCE_SWITCHING) */
+    uint64_t forced_switches;
+    uint64_t drops[_PyGIL_DROP_REASONS];
+    /* Total wait and hold times, in nanoseconds */
+    _PyTime_t wait_time;
+    _PyTime_t hold_time;
+    uint64_t wait_hist[_PyGIL_HIST_SIZE];
+    uint64_t hold_hist[_PyGIL_HIST_SIZE];
+    /* When the GIL was last taken, 0 if unknown */
+    _PyTime_t hold_start;
+};
+
 struct _gil_runtime_state {
     /* microseconds (the Python API uses seconds, though) */
     unsigned long interval;
@@ -31,6 +69,16 @@ struct _gil_runtime_state {
     _Py_atomic_int locked;
     /* Number of GIL switches since the beginning. */
     unsigned long switch_number;
+    /* Non-zero if threads coming back from a blocking call (through
+       PyEval_RestoreThread()) are handed the GIL ahead of other waiters
+       and without waiting for the switch interval to elapse. */
+    int io_priority;
+    /* Number of threads waiting in take_gil() with priority. Other
+       waiters hold back while it is non-zero. */
+    int priority_waiters;
+    /* Non-zero if gil_drop_request was set by a priority waiter. */
+    int priority_request;
+    struct _gil_stats stats;
     /* This condition variable allows one or several threads to wait
        until the GIL is released. In addition, the mutex also protects
        the above variables. */
@@ -40,6 +40,12 @@ struct _Py_list_state {
 extern int
 _PyList_AppendTakeRefListResize(PyListObject *self, PyObject *newitem);
 
+// Like _PyList_AppendArray(), but steals the references to the items on
+// success.
+PyAPI_FUNC(int)
+_PyList_AppendArrayTakeRefs(PyObject *self, PyObject *const *items,
+                            Py_ssize_t n);
+
 static inline int
 _PyList_AppendTakeRef(PyListObject *self, PyObject *newitem)
 {
@@ -75,6 +81,8 @@ typedef struct {
     PyListObject *it_seq; /* Set to NULL when iterator is exhausted */
 } _PyListIterObject;
 
+extern PyObject *_PyList_FromArraySteal(PyObject *const *src, Py_ssize_t n);
+
 #ifdef __cplusplus
 }
 #endif
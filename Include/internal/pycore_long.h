@@ -47,6 +47,32 @@ PyObject *_PyLong_Add(PyLongObject *left, PyLongObject *right);
 PyObject *_PyLong_Multiply(PyLongObject *left, PyLongObject *right);
 PyObject *_PyLong_Subtract(PyLongObject *left, PyLongObject *right);
 
+/* Return 1 if a and b are both exact ints and are equal, 0 otherwise.
+   The set and dict lookups try it before PyObject_RichCompareBool(): it runs
+   no user code, so the table cannot be mutated behind their back. */
+static inline int
+_PyLong_ExactEqual(PyObject *a, PyObject *b)
+{
+    if (!PyLong_CheckExact(a) || !PyLong_CheckExact(b)) {
+        return 0;
+    }
+    PyLongObject *left = (PyLongObject *)a;
+    PyLongObject *right = (PyLongObject *)b;
+    Py_ssize_t size = Py_SIZE(left);
+    if (size != Py_SIZE(right)) {
+        return 0;
+    }
+    if (size < 0) {
+        size = -size;
+    }
+    for (Py_ssize_t i = 0; i < size; i++) {
+        if (left->ob_digit[i] != right->ob_digit[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 int _PyLong_AssignValue(PyObject **target, Py_ssize_t value);
 
 /* Used by Python/mystrtoul.c, _PyBytes_FromHex(),
@@ -27,16 +27,26 @@ struct type_cache_entry {
     PyObject *value;       // borrowed reference or NULL
 };
 
-#define MCACHE_SIZE_EXP 12
-#define MCACHE_STATS 0
+// The cache has 2**MCACHE_MIN_SIZE_EXP entries, and doubles (up to
+// 2**MCACHE_MAX_SIZE_EXP entries) whenever the number of live types with a
+// valid version tag exceeds size >> MCACHE_ENTRIES_PER_TYPE_EXP, so that
+// programs with many classes don't keep evicting each other's entries.  It
+// halves again when that number falls under a quarter of the threshold.
+#define MCACHE_MIN_SIZE_EXP 12
+#define MCACHE_MAX_SIZE_EXP 16
+#define MCACHE_ENTRIES_PER_TYPE_EXP 3
 
 struct type_cache {
-    struct type_cache_entry hashtable[1 << MCACHE_SIZE_EXP];
-#if MCACHE_STATS
+    struct type_cache_entry *hashtable;
+    unsigned int mask;        // number of entries in hashtable - 1
+    size_t versioned_types;   // types with Py_TPFLAGS_VALID_VERSION_TAG
+    // statistics, see sys._get_type_cache_stats()
     size_t hits;
     size_t misses;
     size_t collisions;
-#endif
+    size_t resizes;
+    // single entry table, used if hashtable cannot be allocated
+    struct type_cache_entry fallback_entry;
 };
 
 /* For now we hard-code this to a value for which we are confident
@@ -60,10 +70,14 @@ _PyStaticType_GET_WEAKREFS_LISTPTR(static_builtin_state *state)
     return &state->tp_weaklist;
 }
 
+/* The ids of the watchers of a type are stored in its tp_watched bitset */
+#define TYPE_MAX_WATCHERS 8
+
 struct types_state {
     struct type_cache type_cache;
     size_t num_builtins_initialized;
     static_builtin_state builtins[_Py_MAX_STATIC_BUILTIN_TYPES];
+    PyType_WatchCallback watchers[TYPE_MAX_WATCHERS];
 };
 
 
@@ -74,6 +88,12 @@ extern static_builtin_state * _PyStaticType_GetState(PyTypeObject *);
 extern void _PyStaticType_ClearWeakRefs(PyTypeObject *type);
 extern void _PyStaticType_Dealloc(PyTypeObject *type);
 
+extern PyObject *_PyType_GetCacheStats(PyInterpreterState *interp);
+
+/* tp_getattro slots of classes defining __getattribute__ or __getattr__ */
+extern PyObject *_Py_slot_tp_getattro(PyObject *self, PyObject *name);
+extern PyObject *_Py_slot_tp_getattr_hook(PyObject *self, PyObject *name);
+
 
 #ifdef __cplusplus
 }
@@ -12,6 +12,13 @@ extern "C" {
 
 void _PyUnicode_ExactDealloc(PyObject *op);
 
+/* Borrowed reference to the cached one-character string of a Latin-1
+   character (0 <= ch < 256). */
+#define _Py_LATIN1_CHR(ch) \
+    ((ch) < 128 \
+     ? (PyObject*)&_Py_SINGLETON(strings).ascii[(ch)] \
+     : (PyObject*)&_Py_SINGLETON(strings).latin1[(ch) - 128])
+
 /* runtime lifecycle */
 
 extern void _PyUnicode_InitState(PyInterpreterState *);
@@ -98,6 +98,7 @@ extern "C" {
 #define DELETE_DEREF                           139
 #define JUMP_BACKWARD                          140
 #define CALL_FUNCTION_EX                       142
+#define LOAD_FAST_AND_CLEAR                    143
 #define EXTENDED_ARG                           144
 #define LIST_APPEND                            145
 #define SET_ADD                                146
@@ -132,7 +133,8 @@ extern "C" {
 #define POP_JUMP_IF_NONE                       264
 #define POP_JUMP_IF_NOT_NONE                   265
 #define LOAD_METHOD                            266
-#define MAX_PSEUDO_OPCODE                      266
+#define STORE_FAST_MAYBE_NULL                  267
+#define MAX_PSEUDO_OPCODE                      267
 #define BINARY_OP_ADAPTIVE                       3
 #define BINARY_OP_ADD_FLOAT                      4
 #define BINARY_OP_ADD_INT                        5
@@ -142,69 +144,80 @@ extern "C" {
 #define BINARY_OP_MULTIPLY_INT                  13
 #define BINARY_OP_SUBTRACT_FLOAT                14
 #define BINARY_OP_SUBTRACT_INT                  16
-#define BINARY_SUBSCR_ADAPTIVE                  17
-#define BINARY_SUBSCR_DICT                      18
-#define BINARY_SUBSCR_GETITEM                   19
-#define BINARY_SUBSCR_LIST_INT                  20
-#define BINARY_SUBSCR_TUPLE_INT                 21
-#define CALL_ADAPTIVE                           22
-#define CALL_PY_EXACT_ARGS                      23
-#define CALL_PY_WITH_DEFAULTS                   24
-#define CALL_BOUND_METHOD_EXACT_ARGS            28
-#define CALL_BUILTIN_CLASS                      29
-#define CALL_BUILTIN_FAST_WITH_KEYWORDS         34
-#define CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS  38
-#define CALL_NO_KW_BUILTIN_FAST                 39
-#define CALL_NO_KW_BUILTIN_O                    40
-#define CALL_NO_KW_ISINSTANCE                   41
-#define CALL_NO_KW_LEN                          42
-#define CALL_NO_KW_LIST_APPEND                  43
-#define CALL_NO_KW_METHOD_DESCRIPTOR_FAST       44
-#define CALL_NO_KW_METHOD_DESCRIPTOR_NOARGS     45
-#define CALL_NO_KW_METHOD_DESCRIPTOR_O          46
-#define CALL_NO_KW_STR_1                        47
-#define CALL_NO_KW_TUPLE_1                      48
-#define CALL_NO_KW_TYPE_1                       55
-#define COMPARE_OP_ADAPTIVE                     56
-#define COMPARE_OP_FLOAT_JUMP                   57
-#define COMPARE_OP_INT_JUMP                     58
-#define COMPARE_OP_STR_JUMP                     59
-#define EXTENDED_ARG_QUICK                      62
-#define FOR_ITER_ADAPTIVE                       63
-#define FOR_ITER_LIST                           64
-#define FOR_ITER_RANGE                          65
-#define JUMP_BACKWARD_QUICK                     66
-#define LOAD_ATTR_ADAPTIVE                      67
-#define LOAD_ATTR_CLASS                         72
-#define LOAD_ATTR_INSTANCE_VALUE                73
-#define LOAD_ATTR_MODULE                        76
-#define LOAD_ATTR_PROPERTY                      77
-#define LOAD_ATTR_SLOT                          78
-#define LOAD_ATTR_WITH_HINT                     79
-#define LOAD_ATTR_METHOD_LAZY_DICT              80
-#define LOAD_ATTR_METHOD_NO_DICT                81
-#define LOAD_ATTR_METHOD_WITH_DICT              86
-#define LOAD_ATTR_METHOD_WITH_VALUES           113
-#define LOAD_CONST__LOAD_FAST                  121
-#define LOAD_FAST__LOAD_CONST                  141
-#define LOAD_FAST__LOAD_FAST                   143
-#define LOAD_GLOBAL_ADAPTIVE                   153
-#define LOAD_GLOBAL_BUILTIN                    154
-#define LOAD_GLOBAL_MODULE                     158
-#define RESUME_QUICK                           159
-#define STORE_ATTR_ADAPTIVE                    160
-#define STORE_ATTR_INSTANCE_VALUE              161
-#define STORE_ATTR_SLOT                        166
-#define STORE_ATTR_WITH_HINT                   167
-#define STORE_FAST__LOAD_FAST                  168
-#define STORE_FAST__STORE_FAST                 169
-#define STORE_SUBSCR_ADAPTIVE                  170
-#define STORE_SUBSCR_DICT                      177
-#define STORE_SUBSCR_LIST_INT                  178
-#define UNPACK_SEQUENCE_ADAPTIVE               179
-#define UNPACK_SEQUENCE_LIST                   180
-#define UNPACK_SEQUENCE_TUPLE                  181
-#define UNPACK_SEQUENCE_TWO_TUPLE              182
+#define BINARY_SLICE_ADAPTIVE                   17
+#define BINARY_SLICE_BYTES_INT                  18
+#define BINARY_SLICE_LIST_INT                   19
+#define BINARY_SUBSCR_ADAPTIVE                  20
+#define BINARY_SUBSCR_BYTEARRAY_INT             21
+#define BINARY_SUBSCR_BYTES_INT                 22
+#define BINARY_SUBSCR_DICT                      23
+#define BINARY_SUBSCR_GETITEM                   24
+#define BINARY_SUBSCR_LIST_INT                  28
+#define BINARY_SUBSCR_STR_INT                   29
+#define BINARY_SUBSCR_TUPLE_INT                 34
+#define CALL_ADAPTIVE                           38
+#define CALL_PY_EXACT_ARGS                      39
+#define CALL_PY_WITH_DEFAULTS                   40
+#define CALL_PY_WITH_KEYWORDS                   41
+#define CALL_BOUND_METHOD_EXACT_ARGS            42
+#define CALL_BUILTIN_CLASS                      43
+#define CALL_BUILTIN_FAST_WITH_KEYWORDS         44
+#define CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS  45
+#define CALL_NO_KW_BUILTIN_FAST                 46
+#define CALL_NO_KW_BUILTIN_O                    47
+#define CALL_NO_KW_ISINSTANCE                   48
+#define CALL_NO_KW_LEN                          55
+#define CALL_NO_KW_LIST_APPEND                  56
+#define CALL_NO_KW_METHOD_DESCRIPTOR_FAST       57
+#define CALL_NO_KW_METHOD_DESCRIPTOR_NOARGS     58
+#define CALL_NO_KW_METHOD_DESCRIPTOR_O          59
+#define CALL_NO_KW_STR_1                        62
+#define CALL_NO_KW_TUPLE_1                      63
+#define CALL_NO_KW_TYPE_1                       64
+#define COMPARE_OP_ADAPTIVE                     65
+#define COMPARE_OP_FLOAT_JUMP                   66
+#define COMPARE_OP_INT_JUMP                     67
+#define COMPARE_OP_STR_JUMP                     72
+#define EXTENDED_ARG_QUICK                      73
+#define FOR_ITER_ADAPTIVE                       76
+#define FOR_ITER_LIST                           77
+#define FOR_ITER_RANGE                          78
+#define JUMP_BACKWARD_QUICK                     79
+#define LOAD_ATTR_ADAPTIVE                      80
+#define LOAD_ATTR_CLASS                         81
+#define LOAD_ATTR_DESCRIPTOR                    86
+#define LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN      113
+#define LOAD_ATTR_GETATTR_HOOK                 121
+#define LOAD_ATTR_INSTANCE_VALUE               141
+#define LOAD_ATTR_MODULE                       153
+#define LOAD_ATTR_PROPERTY                     154
+#define LOAD_ATTR_SLOT                         158
+#define LOAD_ATTR_WITH_HINT                    159
+#define LOAD_ATTR_METHOD_LAZY_DICT             160
+#define LOAD_ATTR_METHOD_NO_DICT               161
+#define LOAD_ATTR_METHOD_WITH_DICT             166
+#define LOAD_ATTR_METHOD_WITH_VALUES           167
+#define LOAD_CONST__LOAD_FAST                  168
+#define LOAD_FAST__LOAD_CONST                  169
+#define LOAD_FAST__LOAD_FAST                   170
+#define LOAD_GLOBAL_ADAPTIVE                   177
+#define LOAD_GLOBAL_BUILTIN                    178
+#define LOAD_GLOBAL_MODULE                     179
+#define RESUME_QUICK                           180
+#define STORE_ATTR_ADAPTIVE                    181
+#define STORE_ATTR_INSTANCE_VALUE              182
+#define STORE_ATTR_SLOT                        183
+#define STORE_ATTR_WITH_HINT                   184
+#define STORE_FAST__LOAD_FAST                  185
+#define STORE_FAST__STORE_FAST                 186
+#define STORE_SUBSCR_ADAPTIVE                  187
+#define STORE_SUBSCR_BYTEARRAY_INT             188
+#define STORE_SUBSCR_DICT                      189
+#define STORE_SUBSCR_LIST_INT                  190
+#define UNPACK_SEQUENCE_ADAPTIVE               191
+#define UNPACK_SEQUENCE_LIST                   192
+#define UNPACK_SEQUENCE_TUPLE                  193
+#define UNPACK_SEQUENCE_TWO_TUPLE              194
 #define DO_TRACING                             255
 
 #define HAS_ARG(op) ((((op) >= HAVE_ARGUMENT) && (!IS_PSEUDO_OPCODE(op)))\
@@ -215,6 +228,7 @@ extern "C" {
     || ((op) == POP_JUMP_IF_NONE) \
     || ((op) == POP_JUMP_IF_NOT_NONE) \
     || ((op) == LOAD_METHOD) \
+    || ((op) == STORE_FAST_MAYBE_NULL) \
     )
 
 #define HAS_CONST(op) (false\
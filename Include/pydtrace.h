@@ -37,6 +37,9 @@ static inline void PyDTrace_INSTANCE_DELETE_DONE(int arg0) {}
 static inline void PyDTrace_IMPORT_FIND_LOAD_START(const char *arg0) {}
 static inline void PyDTrace_IMPORT_FIND_LOAD_DONE(const char *arg0, int arg1) {}
 static inline void PyDTrace_AUDIT(const char *arg0, void *arg1) {}
+static inline void PyDTrace_GIL_WAIT_START(void) {}
+static inline void PyDTrace_GIL_ACQUIRE(int arg0) {}
+static inline void PyDTrace_GIL_DROP(int arg0) {}
 
 static inline int PyDTrace_LINE_ENABLED(void) { return 0; }
 static inline int PyDTrace_FUNCTION_ENTRY_ENABLED(void) { return 0; }
@@ -50,6 +53,9 @@ static inline int PyDTrace_INSTANCE_DELETE_DONE_ENABLED(void) { return 0; }
 static inline int PyDTrace_IMPORT_FIND_LOAD_START_ENABLED(void) { return 0; }
 static inline int PyDTrace_IMPORT_FIND_LOAD_DONE_ENABLED(void) { return 0; }
 static inline int PyDTrace_AUDIT_ENABLED(void) { return 0; }
+static inline int PyDTrace_GIL_WAIT_START_ENABLED(void) { return 0; }
+static inline int PyDTrace_GIL_ACQUIRE_ENABLED(void) { return 0; }
+static inline int PyDTrace_GIL_DROP_ENABLED(void) { return 0; }
 
 #endif /* !WITH_DTRACE */
 
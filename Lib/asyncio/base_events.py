@@ -1890,11 +1890,12 @@ def _run_once(self):
         # they will be run the next time (after another I/O poll).
         # Use an idiom that is thread-safe without using locks.
         ntodo = len(self._ready)
-        for i in range(ntodo):
-            handle = self._ready.popleft()
-            if handle._cancelled:
-                continue
-            if self._debug:
+        popleft = self._ready.popleft
+        if self._debug:
+            for i in range(ntodo):
+                handle = popleft()
+                if handle._cancelled:
+                    continue
                 try:
                     self._current_handle = handle
                     t0 = self.time()
@@ -1905,8 +1906,11 @@ def _run_once(self):
                                        _format_handle(handle), dt)
                 finally:
                     self._current_handle = None
-            else:
-                handle._run()
+        else:
+            for i in range(ntodo):
+                handle = popleft()
+                if not handle._cancelled:
+                    handle._run()
         handle = None  # Needed to break cycles when an exception occurs.
 
     def _set_coroutine_origin_tracking(self, enabled):
@@ -15,8 +15,10 @@ def _task_repr_info(task):
 
     info.insert(1, 'name=%r' % task.get_name())
 
-    coro = coroutines._format_coroutine(task._coro)
-    info.insert(2, f'coro=<{coro}>')
+    # The coroutine is dropped once an eagerly started task completes.
+    if task._coro is not None:
+        coro = coroutines._format_coroutine(task._coro)
+        info.insert(2, f'coro=<{coro}>')
 
     if task._fut_waiter is not None:
         info.insert(3, f'wait_for={task._fut_waiter!r}')
@@ -117,27 +117,27 @@ def __hash__(self):
         return hash(self._when)
 
     def __lt__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when < other._when
         return NotImplemented
 
     def __le__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when < other._when or self.__eq__(other)
         return NotImplemented
 
     def __gt__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when > other._when
         return NotImplemented
 
     def __ge__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return self._when > other._when or self.__eq__(other)
         return NotImplemented
 
     def __eq__(self, other):
-        if isinstance(other, TimerHandle):
+        if isinstance(other, _PyTimerHandle):
             return (self._when == other._when and
                     self._callback == other._callback and
                     self._args == other._args and
@@ -817,6 +817,8 @@ def set_child_watcher(watcher):
 
 
 # Alias pure-Python implementations for testing purposes.
+_PyHandle = Handle
+_PyTimerHandle = TimerHandle
 _py__get_running_loop = _get_running_loop
 _py__set_running_loop = _set_running_loop
 _py_get_running_loop = get_running_loop
@@ -839,3 +841,15 @@ def set_child_watcher(watcher):
     _c_get_running_loop = get_running_loop
     _c_get_event_loop = get_event_loop
     _c__get_event_loop = _get_event_loop
+
+try:
+    # Every callback scheduled on the event loop goes through a handle;
+    # the C implementation avoids a Python frame per callback run and
+    # makes timer heap comparisons cheap.
+    from _asyncio import Handle, TimerHandle
+except ImportError:
+    pass
+else:
+    # Alias C implementations for testing purposes.
+    _CHandle = Handle
+    _CTimerHandle = TimerHandle
@@ -1127,11 +1127,27 @@ class _SelectorDatagramTransport(_SelectorTransport):
 
     _buffer_factory = collections.deque
 
+    # recvmmsg_into() reads each datagram into its own max_size slot.  The
+    # transport starts with one slot, doubles them (up to _recv_batch_size)
+    # whenever a call fills them all, and releases them once no datagram
+    # arrived for _recv_idle_timeout seconds.
+    _recv_batch_size = 8
+    _recv_idle_timeout = 1.0
+
     def __init__(self, loop, sock, protocol, address=None,
                  waiter=None, extra=None):
         super().__init__(loop, sock, protocol, extra)
         self._address = address
         self._buffer_size = 0
+        self._recv_slots = None
+        self._recv_active = False
+        self._recv_idle_handle = None
+        if (hasattr(sock, 'recvmmsg_into') and
+                sock.family in (socket.AF_INET, socket.AF_INET6,
+                                socket.AF_UNIX)):
+            self._read_ready_cb = self._read_ready__recvmmsg
+        else:
+            self._read_ready_cb = self._read_ready__recvfrom
         self._loop.call_soon(self._protocol.connection_made, self)
         # only start reading when connection_made() has been called
         self._loop.call_soon(self._add_reader,
@@ -1145,6 +1161,59 @@ def get_write_buffer_size(self):
         return self._buffer_size
 
     def _read_ready(self):
+        self._read_ready_cb()
+
+    def _alloc_recv_slots(self, count):
+        size = self.max_size
+        buf = memoryview(bytearray(count * size))
+        self._recv_slots = [buf[i:i + size] for i in range(0, len(buf), size)]
+
+    def _release_idle_recv_slots(self):
+        if self._recv_active:
+            self._recv_active = False
+            self._recv_idle_handle = self._loop.call_later(
+                self._recv_idle_timeout, self._release_idle_recv_slots)
+        else:
+            self._recv_idle_handle = None
+            self._recv_slots = None
+
+    def _read_ready__recvmmsg(self):
+        if self._conn_lost:
+            return
+        if self._recv_slots is None:
+            self._alloc_recv_slots(1)
+            self._recv_idle_handle = self._loop.call_later(
+                self._recv_idle_timeout, self._release_idle_recv_slots)
+        slots = self._recv_slots
+        try:
+            received = self._sock.recvmmsg_into(slots)
+        except (BlockingIOError, InterruptedError):
+            pass
+        except OSError as exc:
+            self._protocol.error_received(exc)
+        except (SystemExit, KeyboardInterrupt):
+            raise
+        except BaseException as exc:
+            self._fatal_error(exc, 'Fatal read error on datagram transport')
+        else:
+            self._recv_active = True
+            for slot, (nbytes, addr) in zip(slots, received):
+                if self._closing:
+                    return
+                self._protocol.datagram_received(bytes(slot[:nbytes]), addr)
+            if (len(received) == len(slots) and
+                    len(slots) < self._recv_batch_size):
+                self._alloc_recv_slots(
+                    min(2 * len(slots), self._recv_batch_size))
+
+    def _call_connection_lost(self, exc):
+        if self._recv_idle_handle is not None:
+            self._recv_idle_handle.cancel()
+            self._recv_idle_handle = None
+        self._recv_slots = None
+        super()._call_connection_lost(exc)
+
+    def _read_ready__recvfrom(self):
         if self._conn_lost:
             return
         try:
@@ -19,6 +19,8 @@
 
 
 _DEFAULT_LIMIT = 2 ** 16  # 64 KiB
+# Chunks at least this large are copied out of the buffer via a memoryview.
+_LARGE_CHUNK = 2 ** 15  # 32 KiB
 
 
 async def open_connection(host=None, port=None, *,
@@ -495,6 +497,24 @@ def feed_data(self, data):
             else:
                 self._paused = True
 
+    def _take(self, n):
+        """Remove and return the first `n` bytes of the buffer."""
+        buf = self._buffer
+        if n >= len(buf):
+            data = bytes(buf)
+            buf.clear()
+        elif n < _LARGE_CHUNK:
+            data = bytes(buf[:n])
+            del buf[:n]
+        else:
+            # Slicing the bytearray would copy the chunk twice: into a
+            # temporary bytearray, then into the bytes object.  Go through
+            # a memoryview to copy large chunks only once.
+            with memoryview(buf) as view:
+                data = bytes(view[:n])
+            del buf[:n]
+        return data
+
     async def _wait_for_data(self, func_name):
         """Wait until feed_data() or feed_eof() is called.
 
@@ -640,10 +660,9 @@ async def readuntil(self, separator=b'\n'):
             raise exceptions.LimitOverrunError(
                 'Separator is found, but chunk is longer than limit', isep)
 
-        chunk = self._buffer[:isep + seplen]
-        del self._buffer[:isep + seplen]
+        chunk = self._take(isep + seplen)
         self._maybe_resume_transport()
-        return bytes(chunk)
+        return chunk
 
     async def read(self, n=-1):
         """Read up to `n` bytes from the stream.
@@ -689,8 +708,7 @@ async def read(self, n=-1):
             await self._wait_for_data('read')
 
         # This will work right even if buffer is less than n bytes
-        data = bytes(self._buffer[:n])
-        del self._buffer[:n]
+        data = self._take(n)
 
         self._maybe_resume_transport()
         return data
@@ -727,12 +745,7 @@ async def readexactly(self, n):
 
             await self._wait_for_data('readexactly')
 
-        if len(self._buffer) == n:
-            data = bytes(self._buffer)
-            self._buffer.clear()
-        else:
-            data = bytes(self._buffer[:n])
-            del self._buffer[:n]
+        data = self._take(n)
         self._maybe_resume_transport()
         return data
 
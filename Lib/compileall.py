@@ -18,9 +18,10 @@
 import filecmp
 
 from functools import partial
+from itertools import groupby
 from pathlib import Path
 
-__all__ = ["compile_dir","compile_file","compile_path"]
+__all__ = ["compile_dir","compile_file","compile_files","compile_path"]
 
 def _walk_dir(dir, maxlevels, quiet=0):
     if quiet < 2 and isinstance(dir, os.PathLike):
@@ -45,6 +46,22 @@ def _walk_dir(dir, maxlevels, quiet=0):
             yield from _walk_dir(fullname, maxlevels=maxlevels - 1,
                                  quiet=quiet)
 
+def _process_pool_executor(workers):
+    """Check workers, and return the ProcessPoolExecutor class to compile
+    with them in parallel, or None to compile in this process."""
+    if workers < 0:
+        raise ValueError('workers must be greater or equal to 0')
+    if workers == 1:
+        return None
+    # Check if this is a system where ProcessPoolExecutor can function.
+    from concurrent.futures.process import _check_system_limits
+    try:
+        _check_system_limits()
+    except NotImplementedError:
+        return None
+    from concurrent.futures import ProcessPoolExecutor
+    return ProcessPoolExecutor
+
 def compile_dir(dir, maxlevels=None, ddir=None, force=False,
                 rx=None, quiet=0, legacy=False, optimize=-1, workers=1,
                 invalidation_mode=None, *, stripdir=None,
@@ -73,7 +90,6 @@ def compile_dir(dir, maxlevels=None, ddir=None, force=False,
                    the defined path
     hardlink_dupes: hardlink duplicated pyc files
     """
-    ProcessPoolExecutor = None
     if ddir is not None and (stripdir is not None or prependdir is not None):
         raise ValueError(("Destination dir (ddir) cannot be used "
                           "in combination with stripdir or prependdir"))
@@ -81,24 +97,40 @@ def compile_dir(dir, maxlevels=None, ddir=None, force=False,
         stripdir = dir
         prependdir = ddir
         ddir = None
-    if workers < 0:
-        raise ValueError('workers must be greater or equal to 0')
-    if workers != 1:
-        # Check if this is a system where ProcessPoolExecutor can function.
-        from concurrent.futures.process import _check_system_limits
-        try:
-            _check_system_limits()
-        except NotImplementedError:
-            workers = 1
-        else:
-            from concurrent.futures import ProcessPoolExecutor
     if maxlevels is None:
         maxlevels = sys.getrecursionlimit()
+    # compile_files() checks workers before the lazy walk starts
     files = _walk_dir(dir, quiet=quiet, maxlevels=maxlevels)
+    return compile_files(files, ddir, force, rx, quiet, legacy, optimize,
+                         workers, invalidation_mode, stripdir=stripdir,
+                         prependdir=prependdir, limit_sl_dest=limit_sl_dest,
+                         hardlink_dupes=hardlink_dupes)
+
+def compile_files(files, ddir=None, force=False, rx=None, quiet=0,
+                  legacy=False, optimize=-1, workers=1,
+                  invalidation_mode=None, *, stripdir=None,
+                  prependdir=None, limit_sl_dest=None, hardlink_dupes=False):
+    """Byte-compile a batch of files.
+
+    Arguments (only files is required):
+
+    files:     an iterable of the files to byte-compile
+    workers:   maximum number of parallel workers
+
+    The other arguments are as for compile_file().  With several workers,
+    the files are handed out to the worker processes in chunks, rather
+    than one at a time.
+    """
+    ProcessPoolExecutor = _process_pool_executor(workers)
     success = True
-    if workers != 1 and ProcessPoolExecutor is not None:
+    if ProcessPoolExecutor is not None:
+        files = list(files)
         # If workers == 0, let ProcessPoolExecutor choose
         workers = workers or None
+        # Four chunks per worker, like multiprocessing.Pool.map(), balance
+        # the load without paying for a round trip per file.
+        chunksize = max(len(files) // (4 * (workers or os.cpu_count() or 1)),
+                        1)
         with ProcessPoolExecutor(max_workers=workers) as executor:
             results = executor.map(partial(compile_file,
                                            ddir=ddir, force=force,
@@ -110,7 +142,7 @@ def compile_dir(dir, maxlevels=None, ddir=None, force=False,
                                            prependdir=prependdir,
                                            limit_sl_dest=limit_sl_dest,
                                            hardlink_dupes=hardlink_dupes),
-                                   files)
+                                   files, chunksize=chunksize)
             success = min(results, default=True)
     else:
         for file in files:
@@ -424,18 +456,22 @@ def main():
     success = True
     try:
         if compile_dests:
-            for dest in compile_dests:
-                if os.path.isfile(dest):
-                    if not compile_file(dest, args.ddir, args.force, args.rx,
-                                        args.quiet, args.legacy,
-                                        invalidation_mode=invalidation_mode,
-                                        stripdir=args.stripdir,
-                                        prependdir=args.prependdir,
-                                        optimize=args.opt_levels,
-                                        limit_sl_dest=args.limit_sl_dest,
-                                        hardlink_dupes=args.hardlink_dupes):
+            # Compile each run of consecutive files (for example a file
+            # list given with -i) as one batch, in parallel with -j.
+            for isfile, dests in groupby(compile_dests, os.path.isfile):
+                if isfile:
+                    if not compile_files(list(dests), args.ddir, args.force,
+                                         args.rx, args.quiet, args.legacy,
+                                         workers=args.workers,
+                                         invalidation_mode=invalidation_mode,
+                                         stripdir=args.stripdir,
+                                         prependdir=args.prependdir,
+                                         optimize=args.opt_levels,
+                                         limit_sl_dest=args.limit_sl_dest,
+                                         hardlink_dupes=args.hardlink_dupes):
                         success = False
-                else:
+                    continue
+                for dest in dests:
                     if not compile_dir(dest, maxlevels, args.ddir,
                                        args.force, args.rx, args.quiet,
                                        args.legacy, workers=args.workers,
@@ -45,16 +45,18 @@
 
 __author__ = 'Brian Quinlan (brian@sweetapp.com)'
 
+import io
 import os
 from concurrent.futures import _base
+import pickle
 import queue
 import multiprocessing as mp
 import multiprocessing.connection
 from multiprocessing.queues import Queue
+from multiprocessing.reduction import ForkingPickler
 import threading
 import weakref
 from functools import partial
-import itertools
 import sys
 from traceback import format_exception
 
@@ -157,6 +159,71 @@ def __init__(self, work_id, fn, args, kwargs):
         self.args = args
         self.kwargs = kwargs
 
+class _PickledResult(object):
+    """A result pickled by the worker, sent back with its out-of-band buffers.
+
+    Sending the pickle as bytes spares the result queue from pickling the
+    result a second time.
+    """
+    def __init__(self, data, buffers):
+        self.data = data
+        self.buffers = buffers
+
+    def load(self):
+        return pickle.loads(self.data, buffers=self.buffers)
+
+class _SharedMemoryResult(object):
+    """A result sent back through a POSIX shared memory block.
+
+    The block holds the pickled result followed by its out-of-band buffers
+    (pickle protocol 5).  It is unlinked by the process loading it.
+    """
+    def __init__(self, name, data_size, buffer_sizes):
+        self.name = name
+        self.data_size = data_size
+        self.buffer_sizes = buffer_sizes
+
+    def load(self):
+        import _posixshmem
+        from multiprocessing import resource_tracker
+        size = self.data_size + sum(self.buffer_sizes)
+        try:
+            shm = _map_shared_memory(self.name, size)
+        finally:
+            _posixshmem.shm_unlink(self.name)
+            resource_tracker.unregister(self.name, "shared_memory")
+        # The buffers are not copied: the mapping lives as long as the
+        # result needs them.
+        with memoryview(shm) as view:
+            buffers = []
+            offset = self.data_size
+            for buffer_size in self.buffer_sizes:
+                buffers.append(view[offset:offset + buffer_size])
+                offset += buffer_size
+            with view[:self.data_size] as data:
+                return pickle.loads(data, buffers=buffers)
+
+
+def _map_shared_memory(name, size, create=False):
+    """Map the POSIX shared memory block name, faulting its pages in."""
+    import _posixshmem
+    import mmap
+    flags = os.O_RDWR
+    if create:
+        flags |= os.O_CREAT | os.O_EXCL
+    fd = _posixshmem.shm_open(name, flags, mode=0o600)
+    try:
+        if create:
+            os.ftruncate(fd, size)
+        return mmap.mmap(fd, size, flags=mmap.MAP_SHARED |
+                                         getattr(mmap, 'MAP_POPULATE', 0))
+    except BaseException:
+        if create:
+            _posixshmem.shm_unlink(name)
+        raise
+    finally:
+        os.close(fd)
+
 
 class _SafeQueue(Queue):
     """Safe Queue set exception to the future object linked to a job"""
@@ -183,32 +250,60 @@ def _on_queue_feeder_error(self, e, obj):
             super()._on_queue_feeder_error(e, obj)
 
 
-def _get_chunks(*iterables, chunksize):
-    """ Iterates over zip()ed iterables in chunks. """
-    it = zip(*iterables)
-    while True:
-        chunk = tuple(itertools.islice(it, chunksize))
-        if not chunk:
-            return
-        yield chunk
+_get_chunks = _base._get_chunks
+_process_chunk = _base._process_chunk
 
 
-def _process_chunk(fn, chunk):
-    """ Processes a chunk of an iterable passed to map.
+def _pickled_result(buf, data, buffers):
+    data.release()
+    return _PickledResult(buf.getvalue(), [b.tobytes() for b in buffers])
 
-    Runs the function passed to map() on a chunk of the
-    iterable passed to map.
 
-    This function is run in a separate process.
+def _dump_shared_result(result, threshold):
+    """Copy result into a shared memory block if it is large enough.
 
+    Return a _SharedMemoryResult if the pickled result, including its
+    out-of-band buffers, is at least threshold bytes, else a _PickledResult.
     """
-    return [fn(*args) for args in chunk]
+    from multiprocessing import resource_tracker, shared_memory
+    buf = io.BytesIO()
+    buffers = []
+    ForkingPickler(buf, 5, buffer_callback=buffers.append).dump(result)
+    data = buf.getbuffer()
+    try:
+        buffers = [b.raw() for b in buffers]
+    except BufferError:
+        # Non-contiguous buffer: let the result queue pickle it in-band
+        return result
+    size = len(data) + sum(b.nbytes for b in buffers)
+    if size < threshold:
+        return _pickled_result(buf, data, buffers)
+    while True:
+        name = shared_memory._make_filename()
+        try:
+            shm = _map_shared_memory(name, size, create=True)
+        except FileExistsError:
+            continue
+        except OSError:
+            # Out of shared memory: fall back to the result queue
+            return _pickled_result(buf, data, buffers)
+        break
+    resource_tracker.register(name, "shared_memory")
+    with shm:
+        shm[:len(data)] = data
+        offset = len(data)
+        for b in buffers:
+            shm[offset:offset + b.nbytes] = b
+            offset += b.nbytes
+    return _SharedMemoryResult(name, len(data), [b.nbytes for b in buffers])
 
 
 def _sendback_result(result_queue, work_id, result=None, exception=None,
-                     exit_pid=None):
+                     exit_pid=None, shared_memory_threshold=None):
     """Safely send back the given result or exception"""
     try:
+        if shared_memory_threshold is not None and exception is None:
+            result = _dump_shared_result(result, shared_memory_threshold)
         result_queue.put(_ResultItem(work_id, result=result,
                                      exception=exception, exit_pid=exit_pid))
     except BaseException as e:
@@ -217,7 +312,8 @@ def _sendback_result(result_queue, work_id, result=None, exception=None,
                                      exit_pid=exit_pid))
 
 
-def _process_worker(call_queue, result_queue, initializer, initargs, max_tasks=None):
+def _process_worker(call_queue, result_queue, initializer, initargs, max_tasks=None,
+                    shared_memory_threshold=None):
     """Evaluates calls from call_queue and places the results in result_queue.
 
     This worker is run in a separate process.
@@ -229,6 +325,9 @@ def _process_worker(call_queue, result_queue, initializer, initargs, max_tasks=N
             to by the worker.
         initializer: A callable initializer, or None
         initargs: A tuple of args for the initializer
+        max_tasks: The number of tasks to run before exiting, or None
+        shared_memory_threshold: The size in bytes above which results are
+            sent back through shared memory, or None
     """
     if initializer is not None:
         try:
@@ -260,7 +359,8 @@ def _process_worker(call_queue, result_queue, initializer, initargs, max_tasks=N
                              exit_pid=exit_pid)
         else:
             _sendback_result(result_queue, call_item.work_id, result=r,
-                             exit_pid=exit_pid)
+                             exit_pid=exit_pid,
+                             shared_memory_threshold=shared_memory_threshold)
             del r
 
         # Liberate the resource as soon as possible, to avoid holding onto
@@ -440,6 +540,14 @@ def process_result_item(self, result_item):
         else:
             # Received a _ResultItem so mark the future as completed.
             work_item = self.pending_work_items.pop(result_item.work_id, None)
+            if isinstance(result_item.result,
+                          (_PickledResult, _SharedMemoryResult)):
+                # Load it even if the future is gone, to free shared memory
+                try:
+                    result_item.result = result_item.result.load()
+                except BaseException as e:
+                    result_item.exception = e
+                    result_item.result = None
             # work_item can be None if another process terminated (see above)
             if work_item is not None:
                 if result_item.exception:
@@ -588,16 +696,7 @@ def _check_system_limits():
     raise NotImplementedError(_system_limited)
 
 
-def _chain_from_iterable_of_lists(iterable):
-    """
-    Specialized implementation of itertools.chain.from_iterable.
-    Each item in *iterable* should be a list.  This function is
-    careful not to keep references to yielded objects.
-    """
-    for element in iterable:
-        element.reverse()
-        while element:
-            yield element.pop()
+_chain_from_iterable_of_lists = _base._chain_from_iterable_of_lists
 
 
 class BrokenProcessPool(_base.BrokenExecutor):
@@ -609,7 +708,8 @@ class BrokenProcessPool(_base.BrokenExecutor):
 
 class ProcessPoolExecutor(_base.Executor):
     def __init__(self, max_workers=None, mp_context=None,
-                 initializer=None, initargs=(), *, max_tasks_per_child=None):
+                 initializer=None, initargs=(), *, max_tasks_per_child=None,
+                 shared_memory_threshold=None):
         """Initializes a new ProcessPoolExecutor instance.
 
         Args:
@@ -627,6 +727,10 @@ def __init__(self, max_workers=None, mp_context=None,
                 live as long as the executor. Requires a non-'fork' mp_context
                 start method. When given, we default to using 'spawn' if no
                 mp_context is supplied.
+            shared_memory_threshold: If not None, results whose pickle,
+                including its out-of-band buffers, takes at least this many
+                bytes are sent back through a shared memory block instead of
+                the result pipe. Not supported on Windows.
         """
         _check_system_limits()
 
@@ -673,6 +777,24 @@ def __init__(self, max_workers=None, mp_context=None,
                                  " supply a different mp_context.")
         self._max_tasks_per_child = max_tasks_per_child
 
+        if shared_memory_threshold is not None:
+            if (not isinstance(shared_memory_threshold, int) or
+                    isinstance(shared_memory_threshold, bool)):
+                raise TypeError("shared_memory_threshold must be an integer")
+            elif shared_memory_threshold < 0:
+                raise ValueError("shared_memory_threshold must be >= 0")
+            if sys.platform == 'win32':
+                # A block is destroyed on Windows once the worker closes it,
+                # before the result can be loaded.
+                raise ValueError("shared_memory_threshold is not supported"
+                                 " on Windows")
+            from multiprocessing import resource_tracker
+            # Start the tracker now so that workers share it with this
+            # process: blocks are registered by the worker which creates
+            # them, and unregistered here.
+            resource_tracker.ensure_running()
+        self._shared_memory_threshold = shared_memory_threshold
+
         # Management thread
         self._executor_manager_thread = None
 
@@ -755,7 +877,8 @@ def _spawn_process(self):
                   self._result_queue,
                   self._initializer,
                   self._initargs,
-                  self._max_tasks_per_child))
+                  self._max_tasks_per_child,
+                  self._shared_memory_threshold))
         p.start()
         self._processes[p.pid] = p
 
@@ -6,6 +6,7 @@
 __author__ = 'Brian Quinlan (brian@sweetapp.com)'
 
 from concurrent.futures import _base
+from functools import partial
 import itertools
 import queue
 import threading
@@ -65,6 +66,13 @@ def run(self):
 
     __class_getitem__ = classmethod(types.GenericAlias)
 
+_PyWorkItem = _WorkItem
+
+try:
+    from _concurrent_futures import _WorkItem
+except ImportError:
+    pass
+
 
 def _worker(executor_reference, work_queue, initializer, initargs):
     if initializer is not None:
@@ -177,9 +185,40 @@ def submit(self, fn, /, *args, **kwargs):
             return f
     submit.__doc__ = _base.Executor.submit.__doc__
 
+    def map(self, fn, *iterables, timeout=None, chunksize=1):
+        """Returns an iterator equivalent to map(fn, iter).
+
+        Args:
+            fn: A callable that will take as many arguments as there are
+                passed iterables.
+            timeout: The maximum number of seconds to wait. If None, then there
+                is no limit on the wait time.
+            chunksize: If greater than one, the iterables will be chopped into
+                chunks of size chunksize and each chunk is processed by a
+                single worker thread, saving the cost of a future per item.
+                If set to one, the items are submitted one at a time.
+
+        Returns:
+            An iterator equivalent to: map(func, *iterables) but the calls may
+            be evaluated out-of-order.
+
+        Raises:
+            TimeoutError: If the entire result iterator could not be generated
+                before the given timeout.
+            Exception: If fn(*args) raises for any values.
+        """
+        if chunksize <= 1:
+            return super().map(fn, *iterables, timeout=timeout)
+
+        results = super().map(partial(_base._process_chunk, fn),
+                              _base._get_chunks(*iterables,
+                                                chunksize=chunksize),
+                              timeout=timeout)
+        return _base._chain_from_iterable_of_lists(results)
+
     def _adjust_thread_count(self):
         # if idle threads are available, don't spin new threads
-        if self._idle_semaphore.acquire(timeout=0):
+        if self._idle_semaphore.acquire(blocking=False):
             return
 
         # When the executor gets lost, the weakref callback will wake up
@@ -189,6 +189,8 @@ def pseudo_op(name, op, real_ops):
 jrel_op('JUMP_BACKWARD', 140)    # Number of words to skip (backwards)
 
 def_op('CALL_FUNCTION_EX', 142)  # Flags
+def_op('LOAD_FAST_AND_CLEAR', 143)  # Local variable number
+haslocal.append(143)
 
 def_op('EXTENDED_ARG', 144)
 EXTENDED_ARG = 144
@@ -239,6 +241,7 @@ def pseudo_op(name, op, real_ops):
 pseudo_op('POP_JUMP_IF_NONE', 264, ['POP_JUMP_FORWARD_IF_NONE', 'POP_JUMP_BACKWARD_IF_NONE'])
 pseudo_op('POP_JUMP_IF_NOT_NONE', 265, ['POP_JUMP_FORWARD_IF_NOT_NONE', 'POP_JUMP_BACKWARD_IF_NOT_NONE'])
 pseudo_op('LOAD_METHOD', 266, ['LOAD_ATTR'])
+pseudo_op('STORE_FAST_MAYBE_NULL', 267, ['STORE_FAST'])
 
 MAX_PSEUDO_OPCODE = MIN_PSEUDO_OPCODE + len(_pseudo_ops) - 1
 
@@ -290,17 +293,26 @@ def pseudo_op(name, op, real_ops):
         "BINARY_OP_SUBTRACT_FLOAT",
         "BINARY_OP_SUBTRACT_INT",
     ],
+    "BINARY_SLICE": [
+        "BINARY_SLICE_ADAPTIVE",
+        "BINARY_SLICE_BYTES_INT",
+        "BINARY_SLICE_LIST_INT",
+    ],
     "BINARY_SUBSCR": [
         "BINARY_SUBSCR_ADAPTIVE",
+        "BINARY_SUBSCR_BYTEARRAY_INT",
+        "BINARY_SUBSCR_BYTES_INT",
         "BINARY_SUBSCR_DICT",
         "BINARY_SUBSCR_GETITEM",
         "BINARY_SUBSCR_LIST_INT",
+        "BINARY_SUBSCR_STR_INT",
         "BINARY_SUBSCR_TUPLE_INT",
     ],
     "CALL": [
         "CALL_ADAPTIVE",
         "CALL_PY_EXACT_ARGS",
         "CALL_PY_WITH_DEFAULTS",
+        "CALL_PY_WITH_KEYWORDS",
         "CALL_BOUND_METHOD_EXACT_ARGS",
         "CALL_BUILTIN_CLASS",
         "CALL_BUILTIN_FAST_WITH_KEYWORDS",
@@ -338,6 +350,9 @@ def pseudo_op(name, op, real_ops):
         "LOAD_ATTR_ADAPTIVE",
         # These potentially push [NULL, bound method] onto the stack.
         "LOAD_ATTR_CLASS",
+        "LOAD_ATTR_DESCRIPTOR",
+        "LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN",
+        "LOAD_ATTR_GETATTR_HOOK",
         "LOAD_ATTR_INSTANCE_VALUE",
         "LOAD_ATTR_MODULE",
         "LOAD_ATTR_PROPERTY",
@@ -376,6 +391,7 @@ def pseudo_op(name, op, real_ops):
     ],
     "STORE_SUBSCR": [
         "STORE_SUBSCR_ADAPTIVE",
+        "STORE_SUBSCR_BYTEARRAY_INT",
         "STORE_SUBSCR_DICT",
         "STORE_SUBSCR_LIST_INT",
     ],
@@ -420,6 +436,9 @@ def pseudo_op(name, op, real_ops):
         "type_version": 2,
         "func_version": 1,
     },
+    "BINARY_SLICE": {
+        "counter": 1,
+    },
     "FOR_ITER": {
         "counter": 1,
     },
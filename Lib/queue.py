@@ -303,6 +303,34 @@ def put_nowait(self, item):
         '''
         return self.put(item, block=False)
 
+    def put_many(self, items):
+        '''Put all the items from an iterable on the queue.
+
+        This method never blocks.
+        '''
+        items = list(items)
+        self._queue.extend(items)
+        if items:
+            self._count.release(len(items))
+
+    def get_many(self, max_items=None, block=True, timeout=None):
+        '''Remove and return a list of items from the queue.
+
+        Wait for an item to be available as get() does, then return the
+        available items, at most 'max_items' of them if it is not None.
+        '''
+        if max_items is not None and max_items <= 0:
+            raise ValueError("'max_items' must be a positive integer or None")
+        if timeout is not None and timeout < 0:
+            raise ValueError("'timeout' must be a non-negative number")
+        if not self._count.acquire(block, timeout):
+            raise Empty
+        items = [self._queue.popleft()]
+        while ((max_items is None or len(items) < max_items)
+               and self._count.acquire(False)):
+            items.append(self._queue.popleft())
+        return items
+
     def get_nowait(self):
         '''Remove and return an item from the queue without blocking.
 
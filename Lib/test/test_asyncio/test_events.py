@@ -1305,6 +1305,33 @@ def test_create_datagram_endpoint_sock(self):
         tr.close()
         self.loop.run_until_complete(pr.done)
 
+    @unittest.skipUnless(hasattr(socket, 'AF_UNIX'), 'No UNIX Sockets')
+    def test_create_datagram_endpoint_large_datagram(self):
+        # UDP caps datagrams just below 64 KiB, UNIX datagram sockets don't.
+        rsock, wsock = socket.socketpair(socket.AF_UNIX, socket.SOCK_DGRAM)
+        self.addCleanup(wsock.close)
+        rsock.setblocking(False)
+        data = bytes(range(256)) * 400
+        try:
+            wsock.setsockopt(socket.SOL_SOCKET, socket.SO_SNDBUF, 2 * len(data))
+            wsock.send(data)
+        except OSError as exc:
+            rsock.close()
+            self.skipTest(f'cannot send a {len(data)} byte datagram: {exc}')
+
+        received = self.loop.create_future()
+
+        class Proto(asyncio.DatagramProtocol):
+            def datagram_received(self, data, addr):
+                received.set_result(data)
+
+        tr, pr = self.loop.run_until_complete(
+            self.loop.create_datagram_endpoint(Proto, sock=rsock))
+        self.assertEqual(self.loop.run_until_complete(
+            asyncio.wait_for(received, support.SHORT_TIMEOUT)), data)
+        tr.close()
+        test_utils.run_briefly(self.loop)
+
     def test_internal_fds(self):
         loop = self.create_event_loop()
         if not isinstance(loop, selector_events.BaseSelectorEventLoop):
@@ -2118,7 +2145,9 @@ def noop(*args, **kwargs):
     pass
 
 
-class HandleTests(test_utils.TestCase):
+class BaseHandleTests:
+
+    Handle = None
 
     def setUp(self):
         super().setUp()
@@ -2130,7 +2159,7 @@ def callback(*args):
             return args
 
         args = ()
-        h = asyncio.Handle(callback, args, self.loop)
+        h = self.Handle(callback, args, self.loop)
         self.assertIs(h._callback, callback)
         self.assertIs(h._args, args)
         self.assertFalse(h.cancelled())
@@ -2145,7 +2174,7 @@ def callback():
         self.loop = mock.Mock()
         self.loop.call_exception_handler = mock.Mock()
 
-        h = asyncio.Handle(callback, (), self.loop)
+        h = self.Handle(callback, (), self.loop)
         h._run()
 
         self.loop.call_exception_handler.assert_called_with({
@@ -2157,14 +2186,14 @@ def callback():
 
     def test_handle_weakref(self):
         wd = weakref.WeakValueDictionary()
-        h = asyncio.Handle(lambda: None, (), self.loop)
+        h = self.Handle(lambda: None, (), self.loop)
         wd['h'] = h  # Would fail without __weakref__ slot.
 
     def test_handle_repr(self):
         self.loop.get_debug.return_value = False
 
         # simple function
-        h = asyncio.Handle(noop, (1, 2), self.loop)
+        h = self.Handle(noop, (1, 2), self.loop)
         filename, lineno = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<Handle noop(1, 2) at %s:%s>'
@@ -2177,32 +2206,32 @@ def test_handle_repr(self):
 
         # decorated function
         cb = types.coroutine(noop)
-        h = asyncio.Handle(cb, (), self.loop)
+        h = self.Handle(cb, (), self.loop)
         self.assertEqual(repr(h),
                         '<Handle noop() at %s:%s>'
                         % (filename, lineno))
 
         # partial function
         cb = functools.partial(noop, 1, 2)
-        h = asyncio.Handle(cb, (3,), self.loop)
+        h = self.Handle(cb, (3,), self.loop)
         regex = (r'^<Handle noop\(1, 2\)\(3\) at %s:%s>$'
                  % (re.escape(filename), lineno))
         self.assertRegex(repr(h), regex)
 
         # partial function with keyword args
         cb = functools.partial(noop, x=1)
-        h = asyncio.Handle(cb, (2, 3), self.loop)
+        h = self.Handle(cb, (2, 3), self.loop)
         regex = (r'^<Handle noop\(x=1\)\(2, 3\) at %s:%s>$'
                  % (re.escape(filename), lineno))
         self.assertRegex(repr(h), regex)
 
         # partial method
-        method = HandleTests.test_handle_repr
+        method = BaseHandleTests.test_handle_repr
         cb = functools.partialmethod(method)
         filename, lineno = test_utils.get_function_source(method)
-        h = asyncio.Handle(cb, (), self.loop)
+        h = self.Handle(cb, (), self.loop)
 
-        cb_regex = r'<function HandleTests.test_handle_repr .*>'
+        cb_regex = r'<function BaseHandleTests.test_handle_repr .*>'
         cb_regex = fr'functools.partialmethod\({cb_regex}, , \)\(\)'
         regex = fr'^<Handle {cb_regex} at {re.escape(filename)}:{lineno}>$'
         self.assertRegex(repr(h), regex)
@@ -2213,7 +2242,7 @@ def test_handle_repr_debug(self):
         # simple function
         create_filename = __file__
         create_lineno = sys._getframe().f_lineno + 1
-        h = asyncio.Handle(noop, (1, 2), self.loop)
+        h = self.Handle(noop, (1, 2), self.loop)
         filename, lineno = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<Handle noop(1, 2) at %s:%s created at %s:%s>'
@@ -2296,7 +2325,20 @@ def test_coroutine_like_object_debug_formatting(self):
         self.assertEqual(coroutines._format_coroutine(coro), 'AAA()')
 
 
-class TimerTests(unittest.TestCase):
+class PyHandleTests(BaseHandleTests, test_utils.TestCase):
+    Handle = events._PyHandle
+
+
+@unittest.skipUnless(hasattr(events, '_CHandle'),
+                     'requires the C _asyncio module')
+class CHandleTests(BaseHandleTests, test_utils.TestCase):
+    Handle = getattr(events, '_CHandle', None)
+
+
+class BaseTimerTests:
+
+    Handle = None
+    TimerHandle = None
 
     def setUp(self):
         super().setUp()
@@ -2304,13 +2346,13 @@ def setUp(self):
 
     def test_hash(self):
         when = time.monotonic()
-        h = asyncio.TimerHandle(when, lambda: False, (),
+        h = self.TimerHandle(when, lambda: False, (),
                                 mock.Mock())
         self.assertEqual(hash(h), hash(when))
 
     def test_when(self):
         when = time.monotonic()
-        h = asyncio.TimerHandle(when, lambda: False, (),
+        h = self.TimerHandle(when, lambda: False, (),
                                 mock.Mock())
         self.assertEqual(when, h.when())
 
@@ -2320,7 +2362,7 @@ def callback(*args):
 
         args = (1, 2, 3)
         when = time.monotonic()
-        h = asyncio.TimerHandle(when, callback, args, mock.Mock())
+        h = self.TimerHandle(when, callback, args, mock.Mock())
         self.assertIs(h._callback, callback)
         self.assertIs(h._args, args)
         self.assertFalse(h.cancelled())
@@ -2336,7 +2378,7 @@ def test_timer_repr(self):
         self.loop.get_debug.return_value = False
 
         # simple function
-        h = asyncio.TimerHandle(123, noop, (), self.loop)
+        h = self.TimerHandle(123, noop, (), self.loop)
         src = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<TimerHandle when=123 noop() at %s:%s>' % src)
@@ -2352,7 +2394,7 @@ def test_timer_repr_debug(self):
         # simple function
         create_filename = __file__
         create_lineno = sys._getframe().f_lineno + 1
-        h = asyncio.TimerHandle(123, noop, (), self.loop)
+        h = self.TimerHandle(123, noop, (), self.loop)
         filename, lineno = test_utils.get_function_source(noop)
         self.assertEqual(repr(h),
                         '<TimerHandle when=123 noop() '
@@ -2373,8 +2415,8 @@ def callback(*args):
 
         when = time.monotonic()
 
-        h1 = asyncio.TimerHandle(when, callback, (), self.loop)
-        h2 = asyncio.TimerHandle(when, callback, (), self.loop)
+        h1 = self.TimerHandle(when, callback, (), self.loop)
+        h2 = self.TimerHandle(when, callback, (), self.loop)
         # TODO: Use assertLess etc.
         self.assertFalse(h1 < h2)
         self.assertFalse(h2 < h1)
@@ -2390,8 +2432,8 @@ def callback(*args):
         h2.cancel()
         self.assertFalse(h1 == h2)
 
-        h1 = asyncio.TimerHandle(when, callback, (), self.loop)
-        h2 = asyncio.TimerHandle(when + 10.0, callback, (), self.loop)
+        h1 = self.TimerHandle(when, callback, (), self.loop)
+        h2 = self.TimerHandle(when + 10.0, callback, (), self.loop)
         self.assertTrue(h1 < h2)
         self.assertFalse(h2 < h1)
         self.assertTrue(h1 <= h2)
@@ -2403,7 +2445,7 @@ def callback(*args):
         self.assertFalse(h1 == h2)
         self.assertTrue(h1 != h2)
 
-        h3 = asyncio.Handle(callback, (), self.loop)
+        h3 = self.Handle(callback, (), self.loop)
         self.assertIs(NotImplemented, h1.__eq__(h3))
         self.assertIs(NotImplemented, h1.__ne__(h3))
 
@@ -2430,6 +2472,18 @@ def callback(*args):
         self.assertTrue(h1 >= SMALLEST)
 
 
+class PyTimerTests(BaseTimerTests, unittest.TestCase):
+    Handle = events._PyHandle
+    TimerHandle = events._PyTimerHandle
+
+
+@unittest.skipUnless(hasattr(events, '_CTimerHandle'),
+                     'requires the C _asyncio module')
+class CTimerTests(BaseTimerTests, unittest.TestCase):
+    Handle = getattr(events, '_CHandle', None)
+    TimerHandle = getattr(events, '_CTimerHandle', None)
+
+
 class AbstractEventLoopTests(unittest.TestCase):
 
     def test_not_implemented(self):
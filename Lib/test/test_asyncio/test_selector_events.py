@@ -1107,6 +1107,106 @@ def test_read_ready_oserr(self):
         self.assertFalse(transport._fatal_error.called)
         self.protocol.error_received.assert_called_with(err)
 
+    def recvmmsg_transport(self):
+        if not hasattr(socket.socket, 'recvmmsg_into'):
+            self.skipTest('requires socket.recvmmsg_into()')
+        self.sock.family = socket.AF_INET
+        return self.datagram_transport()
+
+    def test_read_ready_recvmmsg(self):
+        transport = self.recvmmsg_transport()
+
+        def recvmmsg_into(buffers):
+            buffers[0][:4] = b'data'
+            if len(buffers) == 1:
+                return [(4, ('0.0.0.0', 1234))]
+            buffers[1][:5] = b'data2'
+            return [(4, ('0.0.0.0', 1234)), (5, ('0.0.0.0', 4321))]
+
+        self.sock.recvmmsg_into.side_effect = recvmmsg_into
+        transport._read_ready()
+        transport._read_ready()
+
+        self.assertFalse(self.sock.recvfrom.called)
+        self.assertEqual(self.protocol.datagram_received.call_args_list,
+                         [mock.call(b'data', ('0.0.0.0', 1234)),
+                          mock.call(b'data', ('0.0.0.0', 1234)),
+                          mock.call(b'data2', ('0.0.0.0', 4321))])
+
+    def test_read_ready_recvmmsg_slots(self):
+        transport = self.recvmmsg_transport()
+        sizes = []
+
+        def recvmmsg_into(buffers):
+            sizes.append([len(b) for b in buffers])
+            return [(0, ('0.0.0.0', 1234))] * len(buffers)
+
+        self.sock.recvmmsg_into.side_effect = recvmmsg_into
+        for i in range(5):
+            transport._read_ready()
+
+        # Every slot fits a datagram of max_size bytes, and the number of
+        # slots only grows while bursts fill them all.
+        size = transport.max_size
+        self.assertEqual(sizes, [[size], [size] * 2, [size] * 4,
+                                 [size] * 8, [size] * 8])
+
+    def test_read_ready_recvmmsg_idle(self):
+        transport = self.recvmmsg_transport()
+        self.assertIsNone(transport._recv_slots)
+
+        self.sock.recvmmsg_into.return_value = [(0, ('0.0.0.0', 1234))]
+        transport._read_ready()
+        self.assertIsNotNone(transport._recv_slots)
+        self.assertIsNotNone(transport._recv_idle_handle)
+
+        # The slots survive a timeout during which datagrams arrived...
+        transport._release_idle_recv_slots()
+        self.assertIsNotNone(transport._recv_slots)
+        self.assertIsNotNone(transport._recv_idle_handle)
+
+        # ...and are released after one without any.
+        transport._release_idle_recv_slots()
+        self.assertIsNone(transport._recv_slots)
+        self.assertIsNone(transport._recv_idle_handle)
+
+        transport._read_ready()
+        self.assertIsNotNone(transport._recv_slots)
+        handle = transport._recv_idle_handle
+        transport._call_connection_lost(None)
+        self.assertTrue(handle.cancelled())
+        self.assertIsNone(transport._recv_slots)
+
+    def test_read_ready_recvmmsg_close(self):
+        transport = self.recvmmsg_transport()
+
+        self.sock.recvmmsg_into.return_value = [(0, ('0.0.0.0', 1234))] * 3
+        self.protocol.datagram_received.side_effect = (
+            lambda data, addr: transport.close())
+        transport._read_ready()
+
+        self.assertEqual(self.protocol.datagram_received.call_count, 1)
+
+    def test_read_ready_recvmmsg_tryagain(self):
+        transport = self.recvmmsg_transport()
+
+        self.sock.recvmmsg_into.side_effect = BlockingIOError
+        transport._fatal_error = mock.Mock()
+        transport._read_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.assertFalse(self.protocol.datagram_received.called)
+
+    def test_read_ready_recvmmsg_oserr(self):
+        transport = self.recvmmsg_transport()
+
+        err = self.sock.recvmmsg_into.side_effect = OSError()
+        transport._fatal_error = mock.Mock()
+        transport._read_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.protocol.error_received.assert_called_with(err)
+
     def test_sendto(self):
         data = b'data'
         transport = self.datagram_transport()
@@ -16,6 +16,7 @@
     ssl = None
 
 import asyncio
+from asyncio import streams
 from test.test_asyncio import utils as test_utils
 
 
@@ -496,6 +497,29 @@ def cb():
         self.assertEqual(self.DATA + self.DATA, data)
         self.assertEqual(self.DATA, stream._buffer)
 
+    def test_readexactly_large_chunks(self):
+        # Large chunks are copied out of the buffer through a memoryview.
+        stream = asyncio.StreamReader(limit=2**20, loop=self.loop)
+        data = bytes(range(1, 256)) * 1024 + b'\0'
+        stream.feed_data(data + data)
+
+        n = streams._LARGE_CHUNK
+        chunk = self.loop.run_until_complete(stream.readexactly(n))
+        self.assertIs(type(chunk), bytes)
+        self.assertEqual(data[:n], chunk)
+
+        line = self.loop.run_until_complete(stream.readuntil(b'\0'))
+        self.assertEqual(data[n:], line)
+        self.assertEqual(data, stream._buffer)
+
+        chunk = self.loop.run_until_complete(stream.read(len(data) - 1))
+        self.assertEqual(data[:-1], chunk)
+        self.assertEqual(b'\0', stream._buffer)
+
+        # The buffer can still be resized once the chunks were taken.
+        stream.feed_data(b'tail')
+        self.assertEqual(b'\0tail', stream._buffer)
+
     def test_readexactly_limit(self):
         stream = asyncio.StreamReader(limit=3, loop=self.loop)
         stream.feed_data(b'chunk')
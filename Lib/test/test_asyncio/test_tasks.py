@@ -9,6 +9,7 @@
 import sys
 import traceback
 import unittest
+import weakref
 from unittest import mock
 from types import GenericAlias
 
@@ -2593,6 +2594,9 @@ class BaseTaskIntrospectionTests:
     _unregister_task = None
     _enter_task = None
     _leave_task = None
+    _register_eager_task = None
+    _unregister_eager_task = None
+    _swap_current_task = None
 
     def test__register_task_1(self):
         class TaskLike:
@@ -2699,12 +2703,36 @@ def test__unregister_task_not_registered(self):
         self._unregister_task(task)
         self.assertEqual(asyncio.all_tasks(loop), set())
 
+    def test__register_eager_task(self):
+        task = mock.Mock()
+        loop = mock.Mock()
+        task.get_loop = lambda: loop
+        task.done = lambda: False
+        self._register_eager_task(task)
+        self.assertEqual(asyncio.all_tasks(loop), {task})
+        self._unregister_eager_task(task)
+        self.assertEqual(asyncio.all_tasks(loop), set())
+
+    def test__swap_current_task(self):
+        task1 = mock.Mock()
+        task2 = mock.Mock()
+        loop = mock.Mock()
+        self.assertIsNone(self._swap_current_task(loop, task1))
+        self.assertIs(asyncio.current_task(loop), task1)
+        self.assertIs(self._swap_current_task(loop, task2), task1)
+        self.assertIs(asyncio.current_task(loop), task2)
+        self.assertIs(self._swap_current_task(loop, None), task2)
+        self.assertIsNone(asyncio.current_task(loop))
+
 
 class PyIntrospectionTests(test_utils.TestCase, BaseTaskIntrospectionTests):
     _register_task = staticmethod(tasks._py_register_task)
     _unregister_task = staticmethod(tasks._py_unregister_task)
     _enter_task = staticmethod(tasks._py_enter_task)
     _leave_task = staticmethod(tasks._py_leave_task)
+    _register_eager_task = staticmethod(tasks._py_register_eager_task)
+    _unregister_eager_task = staticmethod(tasks._py_unregister_eager_task)
+    _swap_current_task = staticmethod(tasks._py_swap_current_task)
 
 
 @unittest.skipUnless(hasattr(tasks, '_c_register_task'),
@@ -2715,8 +2743,79 @@ class CIntrospectionTests(test_utils.TestCase, BaseTaskIntrospectionTests):
         _unregister_task = staticmethod(tasks._c_unregister_task)
         _enter_task = staticmethod(tasks._c_enter_task)
         _leave_task = staticmethod(tasks._c_leave_task)
+        _register_eager_task = staticmethod(tasks._c_register_eager_task)
+        _unregister_eager_task = staticmethod(tasks._c_unregister_eager_task)
+        _swap_current_task = staticmethod(tasks._c_swap_current_task)
     else:
         _register_task = _unregister_task = _enter_task = _leave_task = None
+        _register_eager_task = _unregister_eager_task = None
+        _swap_current_task = None
+
+
+@unittest.skipUnless(hasattr(tasks, '_CTask'),
+                     'requires the C _asyncio module')
+class CNativeTaskRegistryTests(test_utils.TestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.loop = asyncio.new_event_loop()
+        self.set_event_loop(self.loop)
+
+    def new_task(self, cls=None):
+        async def coro():
+            await asyncio.sleep(0)
+        return (cls or tasks._CTask)(coro(), loop=self.loop)
+
+    def test_native_task_not_in_weakset(self):
+        task = self.new_task()
+        self.assertIn(task, asyncio.all_tasks(self.loop))
+        self.assertNotIn(task, tasks._all_tasks)
+        self.loop.run_until_complete(task)
+        self.assertEqual(asyncio.all_tasks(self.loop), set())
+
+    def test_native_task_subclass(self):
+        class SubTask(tasks._CTask):
+            pass
+
+        task = self.new_task(SubTask)
+        self.assertIn(task, asyncio.all_tasks(self.loop))
+        self.assertNotIn(task, tasks._all_tasks)
+        self.loop.run_until_complete(task)
+
+    def test_native_task_unregister(self):
+        task = self.new_task()
+        tasks._c_unregister_task(task)
+        self.assertEqual(asyncio.all_tasks(self.loop), set())
+        # Unregistering twice and registering again are harmless.
+        tasks._c_unregister_task(task)
+        tasks._c_register_task(task)
+        tasks._c_register_task(task)
+        self.assertEqual(asyncio.all_tasks(self.loop), {task})
+        self.loop.run_until_complete(task)
+
+    def test_native_task_unlinked_on_dealloc(self):
+        async def coro():
+            pass
+
+        refs = []
+        for _ in range(10):
+            task = tasks._CTask(coro(), loop=self.loop)
+            task._log_destroy_pending = False
+            task.get_coro().close()
+            refs.append(weakref.ref(task))
+            del task
+        # Drop the scheduled steps, the only other references to the tasks.
+        self.loop._ready.clear()
+        support.gc_collect()
+        self.assertEqual([r() for r in refs], [None] * 10)
+        self.assertEqual(asyncio.all_tasks(self.loop), set())
+
+    def test_other_loops_filtered(self):
+        other = asyncio.new_event_loop()
+        self.addCleanup(other.close)
+        task = self.new_task()
+        self.assertEqual(asyncio.all_tasks(other), set())
+        self.loop.run_until_complete(task)
 
 
 class BaseCurrentLoopTests:
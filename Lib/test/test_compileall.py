@@ -251,6 +251,46 @@ def test_compile_missing_multiprocessing(self, compile_file_mock):
         compileall.compile_dir(self.directory, quiet=True, workers=5)
         self.assertTrue(compile_file_mock.called)
 
+    def test_compile_files(self):
+        self.add_bad_source_file()
+        files = [self.source_path, self.source_path3, 'nosuchfile.py']
+        self.assertTrue(compileall.compile_files(files, quiet=2))
+        self.assertTrue(os.path.isfile(self.bc_path))
+        self.assertFalse(os.path.isfile(self.bc_path2))
+        self.assertTrue(os.path.isfile(
+            importlib.util.cache_from_source(self.source_path3)))
+        self.assertFalse(compileall.compile_files(
+            iter([self.source_path2, self.bad_source_path]), quiet=2))
+        self.assertTrue(os.path.isfile(self.bc_path2))
+
+    @skipUnless(_have_multiprocessing, "requires multiprocessing")
+    def test_compile_files_workers(self):
+        self.add_bad_source_file()
+        files = [self.source_path, self.source_path3]
+        self.assertTrue(compileall.compile_files(files, quiet=2, workers=2))
+        self.assertTrue(os.path.isfile(self.bc_path))
+        self.assertTrue(os.path.isfile(
+            importlib.util.cache_from_source(self.source_path3)))
+        self.assertFalse(compileall.compile_files(
+            iter([self.source_path2, self.bad_source_path]), quiet=2,
+            workers=2))
+        self.assertTrue(os.path.isfile(self.bc_path2))
+
+    @skipUnless(_have_multiprocessing, "requires multiprocessing")
+    @mock.patch('concurrent.futures.ProcessPoolExecutor')
+    def test_compile_files_chunksize(self, pool_mock):
+        executor = pool_mock.return_value.__enter__.return_value
+        files = [f'{i}.py' for i in range(100)]
+        compileall.compile_files(files, quiet=2, workers=5)
+        self.assertEqual(executor.map.call_args[1]['chunksize'], 5)
+        compileall.compile_files(files[:3], quiet=2, workers=5)
+        self.assertEqual(executor.map.call_args[1]['chunksize'], 1)
+
+    def test_compile_files_workers_non_positive(self):
+        with self.assertRaisesRegex(ValueError,
+                                    "workers must be greater or equal to 0"):
+            compileall.compile_files([self.source_path], workers=-1)
+
     def test_compile_dir_maxlevels(self):
         # Test the actual impact of maxlevels parameter
         depth = 3
@@ -746,6 +786,30 @@ def test_include_file_no_arg(self):
         self.assertNotCompiled(f3)
         self.assertNotCompiled(f4)
 
+    @skipUnless(_have_multiprocessing, "requires multiprocessing")
+    def test_include_file_workers(self):
+        f1 = script_helper.make_script(self.pkgdir, 'f1', '')
+        f2 = script_helper.make_script(self.pkgdir, 'f2', '')
+        f3 = script_helper.make_script(self.pkgdir, 'f3', '')
+        with open(os.path.join(self.directory, 'l1'), 'w', encoding="utf-8") as l1:
+            l1.write(f1+os.linesep)
+            l1.write(f2+os.linesep)
+        self.assertRunOK('-j', '2', '-i', os.path.join(self.directory, 'l1'))
+        self.assertCompiled(f1)
+        self.assertCompiled(f2)
+        self.assertNotCompiled(f3)
+
+    @mock.patch('compileall.compile_files')
+    def test_include_file_one_batch(self, compile_files):
+        f1 = script_helper.make_script(self.pkgdir, 'f1', '')
+        f2 = script_helper.make_script(self.pkgdir, 'f2', '')
+        with mock.patch("sys.argv",
+                        new=[sys.executable, f1, f2, "-j0"]):
+            compileall.main()
+        self.assertEqual(compile_files.call_count, 1)
+        self.assertEqual(list(compile_files.call_args[0][0]), [f1, f2])
+        self.assertEqual(compile_files.call_args[1]['workers'], 0)
+
     def test_include_on_stdin(self):
         f1 = script_helper.make_script(self.pkgdir, 'f1', '')
         f2 = script_helper.make_script(self.pkgdir, 'f2', '')
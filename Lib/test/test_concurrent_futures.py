@@ -13,15 +13,18 @@
 import logging
 from logging.handlers import QueueHandler
 import os
+import pickle
 import queue
 import sys
 import threading
 import time
 import unittest
+from unittest import mock
 import weakref
 from pickle import PicklingError
 
 from concurrent import futures
+from concurrent.futures import _base, thread
 from concurrent.futures._base import (
     PENDING, RUNNING, CANCELLED, CANCELLED_AND_NOTIFIED, FINISHED, Future,
     BrokenExecutor)
@@ -38,8 +41,8 @@
     raise unittest.SkipTest("test too slow on ASAN/MSAN build")
 
 
-def create_future(state=PENDING, exception=None, result=None):
-    f = Future()
+def create_future(state=PENDING, exception=None, result=None, cls=Future):
+    f = cls()
     f._state = state
     f._exception = exception
     f._result = result
@@ -959,6 +962,28 @@ def log_n_wait(ident):
         # ident='third' is cancelled because it remained in the collection of futures
         self.assertListEqual(log, ["ident='first' started", "ident='first' stopped"])
 
+    def test_map_chunksize(self):
+        ref = list(map(pow, range(40), range(40)))
+        for chunksize in (0, 1, 6, 40, 50):
+            with self.subTest(chunksize=chunksize):
+                self.assertEqual(
+                    list(self.executor.map(pow, range(40), range(40),
+                                           chunksize=chunksize)),
+                    ref)
+
+    def test_map_chunksize_futures(self):
+        # Each chunk is run by a single work item
+        submitted = []
+        class Executor(self.executor_type):
+            def submit(self, fn, /, *args, **kwargs):
+                submitted.append(fn)
+                return super().submit(fn, *args, **kwargs)
+
+        with Executor(max_workers=1) as executor:
+            results = list(executor.map(abs, range(-10, 0), chunksize=4))
+        self.assertEqual(results, list(range(10, 0, -1)))
+        self.assertEqual(len(submitted), 3)
+
 
 class ProcessPoolExecutorTest(ExecutorTest):
 
@@ -1125,6 +1150,82 @@ def test_max_tasks_early_shutdown(self):
         for i, future in enumerate(futures):
             self.assertEqual(future.result(), mul(i, i))
 
+    def test_shared_memory_threshold_invalid(self):
+        with self.assertRaises(TypeError):
+            self.executor_type(1, shared_memory_threshold=1.0)
+        with self.assertRaises(TypeError):
+            self.executor_type(1, shared_memory_threshold=True)
+        with self.assertRaises(ValueError):
+            self.executor_type(1, shared_memory_threshold=-1)
+
+    @unittest.skipIf(sys.platform == 'win32', 'requires POSIX shared memory')
+    def test_shared_memory_results(self):
+        # not using self.executor as we need to control construction.
+        executor = self.executor_type(
+                2, mp_context=self.get_context(), shared_memory_threshold=1024)
+        with executor:
+            # Small results still go through the result queue
+            self.assertEqual(executor.submit(mul, 6, 7).result(), 42)
+            self.assertEqual(executor.submit(bytes, 100000).result(),
+                             bytes(100000))
+            self.assertEqual(executor.submit(bytearray, 100000).result(),
+                             bytearray(100000))
+            self.assertEqual(
+                list(executor.map(bytes, [10, 2000, 0, 5000])),
+                [bytes(10), bytes(2000), bytes(0), bytes(5000)])
+            with self.assertRaises(Exception) as cm:
+                executor.submit(sleep_and_raise, 0).result()
+            self.assertEqual(cm.exception.args, ('this is an exception',))
+            with self.assertRaises(PicklingError):
+                executor.submit(_return_instance, ErrorAtPickle).result()
+
+
+@unittest.skipIf(sys.platform == 'win32', 'requires POSIX shared memory')
+class SharedMemoryResultTest(BaseTestCase):
+    def test_dump_and_load(self):
+        import _posixshmem
+        from concurrent.futures import process
+
+        # Small results are pickled only once, by the worker
+        data = bytearray(b'spam')
+        result = process._dump_shared_result(
+            [pickle.PickleBuffer(data), b'x'], 1024)
+        self.assertIsInstance(result, process._PickledResult)
+        self.assertEqual(result.buffers, [b'spam'])
+        buffer, x = pickle.loads(pickle.dumps(result)).load()
+        self.assertEqual(bytes(buffer), data)
+        self.assertEqual(x, b'x')
+
+        data = bytearray(b'spam' * 1000)
+        value = [pickle.PickleBuffer(data), b'eggs' * 1000]
+        result = process._dump_shared_result(value, 1024)
+        self.assertIsInstance(result, process._SharedMemoryResult)
+        self.assertEqual(result.buffer_sizes, [4000])
+        buffer, eggs = result.load()
+        self.assertEqual(bytes(buffer), data)
+        self.assertEqual(eggs, b'eggs' * 1000)
+        # The block was unlinked
+        with self.assertRaises(FileNotFoundError):
+            _posixshmem.shm_open(result.name, os.O_RDWR)
+
+    def test_dump_with_python_pickler(self):
+        from concurrent.futures import process
+        # A ForkingPickler based on the pure Python pickler
+        with mock.patch('pickle.Pickler', pickle._Pickler):
+            reduction = import_helper.import_fresh_module(
+                'multiprocessing.reduction')
+        self.assertIs(reduction.ForkingPickler.__base__, pickle._Pickler)
+
+        data = bytearray(b'spam')
+        with mock.patch.object(process, 'ForkingPickler',
+                               reduction.ForkingPickler):
+            result = process._dump_shared_result(
+                [pickle.PickleBuffer(data), b'x'], 1024)
+        self.assertEqual(result.buffers, [b'spam'])
+        buffer, x = result.load()
+        self.assertEqual(bytes(buffer), data)
+        self.assertEqual(x, b'x')
+
 
 create_executor_tests(ProcessPoolExecutorTest,
                       executor_mixins=(ProcessPoolForkMixin,
@@ -1346,14 +1447,28 @@ def test_shutdown_deadlock_pickle(self):
                                        ProcessPoolSpawnMixin))
 
 
-class FutureTests(BaseTestCase):
+class FutureTests:
+    def setUp(self):
+        super().setUp()
+        self.pending_future = self.create_future(state=PENDING)
+        self.running_future = self.create_future(state=RUNNING)
+        self.cancelled_future = self.create_future(state=CANCELLED)
+        self.cancelled_and_notified_future = self.create_future(
+            state=CANCELLED_AND_NOTIFIED)
+        self.exception_future = self.create_future(state=FINISHED,
+                                                   exception=OSError())
+        self.successful_future = self.create_future(state=FINISHED, result=42)
+
+    def create_future(self, state=PENDING, exception=None, result=None):
+        return create_future(state, exception, result, cls=self.Future)
+
     def test_done_callback_with_result(self):
         callback_result = None
         def fn(callback_future):
             nonlocal callback_result
             callback_result = callback_future.result()
 
-        f = Future()
+        f = self.Future()
         f.add_done_callback(fn)
         f.set_result(5)
         self.assertEqual(5, callback_result)
@@ -1364,7 +1479,7 @@ def fn(callback_future):
             nonlocal callback_exception
             callback_exception = callback_future.exception()
 
-        f = Future()
+        f = self.Future()
         f.add_done_callback(fn)
         f.set_exception(Exception('test'))
         self.assertEqual(('test',), callback_exception.args)
@@ -1375,7 +1490,7 @@ def fn(callback_future):
             nonlocal was_cancelled
             was_cancelled = callback_future.cancelled()
 
-        f = Future()
+        f = self.Future()
         f.add_done_callback(fn)
         self.assertTrue(f.cancel())
         self.assertTrue(was_cancelled)
@@ -1394,7 +1509,7 @@ def fn(callback_future):
                 nonlocal fn_was_called
                 fn_was_called = True
 
-            f = Future()
+            f = self.Future()
             f.add_done_callback(raising_fn)
             f.add_done_callback(fn)
             f.set_result(5)
@@ -1408,7 +1523,7 @@ def fn(callback_future):
             nonlocal callback_result
             callback_result = callback_future.result()
 
-        f = Future()
+        f = self.Future()
         f.set_result(5)
         f.add_done_callback(fn)
         self.assertEqual(5, callback_result)
@@ -1419,7 +1534,7 @@ def fn(callback_future):
             nonlocal callback_exception
             callback_exception = callback_future.exception()
 
-        f = Future()
+        f = self.Future()
         f.set_exception(Exception('test'))
         f.add_done_callback(fn)
         self.assertEqual(('test',), callback_exception.args)
@@ -1430,7 +1545,7 @@ def fn(callback_future):
             nonlocal was_cancelled
             was_cancelled = callback_future.cancelled()
 
-        f = Future()
+        f = self.Future()
         self.assertTrue(f.cancel())
         f.add_done_callback(fn)
         self.assertTrue(was_cancelled)
@@ -1440,7 +1555,7 @@ def test_done_callback_raises_already_succeeded(self):
             def raising_fn(callback_future):
                 raise Exception('doh!')
 
-            f = Future()
+            f = self.Future()
 
             # Set the result first to simulate a future that runs instantly,
             # effectively allowing the callback to be run immediately.
@@ -1452,29 +1567,29 @@ def raising_fn(callback_future):
 
 
     def test_repr(self):
-        self.assertRegex(repr(PENDING_FUTURE),
+        self.assertRegex(repr(self.pending_future),
                          '<Future at 0x[0-9a-f]+ state=pending>')
-        self.assertRegex(repr(RUNNING_FUTURE),
+        self.assertRegex(repr(self.running_future),
                          '<Future at 0x[0-9a-f]+ state=running>')
-        self.assertRegex(repr(CANCELLED_FUTURE),
+        self.assertRegex(repr(self.cancelled_future),
                          '<Future at 0x[0-9a-f]+ state=cancelled>')
-        self.assertRegex(repr(CANCELLED_AND_NOTIFIED_FUTURE),
+        self.assertRegex(repr(self.cancelled_and_notified_future),
                          '<Future at 0x[0-9a-f]+ state=cancelled>')
         self.assertRegex(
-                repr(EXCEPTION_FUTURE),
+                repr(self.exception_future),
                 '<Future at 0x[0-9a-f]+ state=finished raised OSError>')
         self.assertRegex(
-                repr(SUCCESSFUL_FUTURE),
+                repr(self.successful_future),
                 '<Future at 0x[0-9a-f]+ state=finished returned int>')
 
 
     def test_cancel(self):
-        f1 = create_future(state=PENDING)
-        f2 = create_future(state=RUNNING)
-        f3 = create_future(state=CANCELLED)
-        f4 = create_future(state=CANCELLED_AND_NOTIFIED)
-        f5 = create_future(state=FINISHED, exception=OSError())
-        f6 = create_future(state=FINISHED, result=5)
+        f1 = self.create_future(state=PENDING)
+        f2 = self.create_future(state=RUNNING)
+        f3 = self.create_future(state=CANCELLED)
+        f4 = self.create_future(state=CANCELLED_AND_NOTIFIED)
+        f5 = self.create_future(state=FINISHED, exception=OSError())
+        f6 = self.create_future(state=FINISHED, result=5)
 
         self.assertTrue(f1.cancel())
         self.assertEqual(f1._state, CANCELLED)
@@ -1495,40 +1610,40 @@ def test_cancel(self):
         self.assertEqual(f6._state, FINISHED)
 
     def test_cancelled(self):
-        self.assertFalse(PENDING_FUTURE.cancelled())
-        self.assertFalse(RUNNING_FUTURE.cancelled())
-        self.assertTrue(CANCELLED_FUTURE.cancelled())
-        self.assertTrue(CANCELLED_AND_NOTIFIED_FUTURE.cancelled())
-        self.assertFalse(EXCEPTION_FUTURE.cancelled())
-        self.assertFalse(SUCCESSFUL_FUTURE.cancelled())
+        self.assertFalse(self.pending_future.cancelled())
+        self.assertFalse(self.running_future.cancelled())
+        self.assertTrue(self.cancelled_future.cancelled())
+        self.assertTrue(self.cancelled_and_notified_future.cancelled())
+        self.assertFalse(self.exception_future.cancelled())
+        self.assertFalse(self.successful_future.cancelled())
 
     def test_done(self):
-        self.assertFalse(PENDING_FUTURE.done())
-        self.assertFalse(RUNNING_FUTURE.done())
-        self.assertTrue(CANCELLED_FUTURE.done())
-        self.assertTrue(CANCELLED_AND_NOTIFIED_FUTURE.done())
-        self.assertTrue(EXCEPTION_FUTURE.done())
-        self.assertTrue(SUCCESSFUL_FUTURE.done())
+        self.assertFalse(self.pending_future.done())
+        self.assertFalse(self.running_future.done())
+        self.assertTrue(self.cancelled_future.done())
+        self.assertTrue(self.cancelled_and_notified_future.done())
+        self.assertTrue(self.exception_future.done())
+        self.assertTrue(self.successful_future.done())
 
     def test_running(self):
-        self.assertFalse(PENDING_FUTURE.running())
-        self.assertTrue(RUNNING_FUTURE.running())
-        self.assertFalse(CANCELLED_FUTURE.running())
-        self.assertFalse(CANCELLED_AND_NOTIFIED_FUTURE.running())
-        self.assertFalse(EXCEPTION_FUTURE.running())
-        self.assertFalse(SUCCESSFUL_FUTURE.running())
+        self.assertFalse(self.pending_future.running())
+        self.assertTrue(self.running_future.running())
+        self.assertFalse(self.cancelled_future.running())
+        self.assertFalse(self.cancelled_and_notified_future.running())
+        self.assertFalse(self.exception_future.running())
+        self.assertFalse(self.successful_future.running())
 
     def test_result_with_timeout(self):
         self.assertRaises(futures.TimeoutError,
-                          PENDING_FUTURE.result, timeout=0)
+                          self.pending_future.result, timeout=0)
         self.assertRaises(futures.TimeoutError,
-                          RUNNING_FUTURE.result, timeout=0)
+                          self.running_future.result, timeout=0)
         self.assertRaises(futures.CancelledError,
-                          CANCELLED_FUTURE.result, timeout=0)
+                          self.cancelled_future.result, timeout=0)
         self.assertRaises(futures.CancelledError,
-                          CANCELLED_AND_NOTIFIED_FUTURE.result, timeout=0)
-        self.assertRaises(OSError, EXCEPTION_FUTURE.result, timeout=0)
-        self.assertEqual(SUCCESSFUL_FUTURE.result(timeout=0), 42)
+                          self.cancelled_and_notified_future.result, timeout=0)
+        self.assertRaises(OSError, self.exception_future.result, timeout=0)
+        self.assertEqual(self.successful_future.result(timeout=0), 42)
 
     def test_result_with_success(self):
         # TODO(brian@sweetapp.com): This test is timing dependent.
@@ -1537,7 +1652,7 @@ def notification():
             time.sleep(1)
             f1.set_result(42)
 
-        f1 = create_future(state=PENDING)
+        f1 = self.create_future(state=PENDING)
         t = threading.Thread(target=notification)
         t.start()
 
@@ -1551,7 +1666,7 @@ def notification():
             time.sleep(1)
             f1.cancel()
 
-        f1 = create_future(state=PENDING)
+        f1 = self.create_future(state=PENDING)
         t = threading.Thread(target=notification)
         t.start()
 
@@ -1561,16 +1676,16 @@ def notification():
 
     def test_exception_with_timeout(self):
         self.assertRaises(futures.TimeoutError,
-                          PENDING_FUTURE.exception, timeout=0)
+                          self.pending_future.exception, timeout=0)
         self.assertRaises(futures.TimeoutError,
-                          RUNNING_FUTURE.exception, timeout=0)
+                          self.running_future.exception, timeout=0)
         self.assertRaises(futures.CancelledError,
-                          CANCELLED_FUTURE.exception, timeout=0)
+                          self.cancelled_future.exception, timeout=0)
         self.assertRaises(futures.CancelledError,
-                          CANCELLED_AND_NOTIFIED_FUTURE.exception, timeout=0)
-        self.assertTrue(isinstance(EXCEPTION_FUTURE.exception(timeout=0),
+                          self.cancelled_and_notified_future.exception, timeout=0)
+        self.assertTrue(isinstance(self.exception_future.exception(timeout=0),
                                    OSError))
-        self.assertEqual(SUCCESSFUL_FUTURE.exception(timeout=0), None)
+        self.assertEqual(self.successful_future.exception(timeout=0), None)
 
     def test_exception_with_success(self):
         def notification():
@@ -1581,7 +1696,7 @@ def notification():
                 f1._exception = OSError()
                 f1._condition.notify_all()
 
-        f1 = create_future(state=PENDING)
+        f1 = self.create_future(state=PENDING)
         t = threading.Thread(target=notification)
         t.start()
 
@@ -1589,7 +1704,7 @@ def notification():
         t.join()
 
     def test_multiple_set_result(self):
-        f = create_future(state=PENDING)
+        f = self.create_future(state=PENDING)
         f.set_result(1)
 
         with self.assertRaisesRegex(
@@ -1603,7 +1718,7 @@ def test_multiple_set_result(self):
         self.assertEqual(f.result(), 1)
 
     def test_multiple_set_exception(self):
-        f = create_future(state=PENDING)
+        f = self.create_future(state=PENDING)
         e = ValueError()
         f.set_exception(e)
 
@@ -1617,6 +1732,123 @@ def test_multiple_set_exception(self):
         self.assertEqual(f.exception(), e)
 
 
+class PyFutureTests(FutureTests, BaseTestCase):
+    Future = _base._PyFuture
+
+
+@unittest.skipUnless(hasattr(_base, '_CFuture'),
+                     'requires the C _concurrent_futures module')
+class CFutureTests(FutureTests, BaseTestCase):
+    Future = getattr(_base, '_CFuture', None)
+
+    def test_invalid_state(self):
+        f = self.Future()
+        with self.assertRaises(ValueError):
+            f._state = 'UNKNOWN'
+        self.assertEqual(f._state, PENDING)
+
+    def test_subclass(self):
+        class SubFuture(self.Future):
+            def __init__(self):
+                super().__init__()
+                self.attr = 42
+
+        f = SubFuture()
+        self.assertEqual(f.attr, 42)
+        self.assertEqual(vars(f), {'attr': 42})
+        f.set_result(5)
+        self.assertEqual(f.result(), 5)
+        self.assertRegex(repr(f),
+                         '<SubFuture at 0x[0-9a-f]+ state=finished '
+                         'returned int>')
+
+    def test_result_many_waiters(self):
+        f = self.Future()
+        results = []
+        def waiter():
+            results.append(f.result(timeout=support.SHORT_TIMEOUT))
+
+        threads = [threading.Thread(target=waiter) for _ in range(5)]
+        with threading_helper.start_threads(threads):
+            time.sleep(0.1)
+            f.set_result(42)
+        self.assertEqual(results, [42] * 5)
+
+    def test_waiter_error(self):
+        # A failing waiter doesn't keep the future from notifying its
+        # condition and invoking its callbacks; its error is raised after.
+        class BadWaiter:
+            def add_result(self, future):
+                raise ZeroDivisionError
+
+        f = self.Future()
+        called = []
+        f.add_done_callback(called.append)
+        f._waiters.append(BadWaiter())
+        with f._condition:
+            t = threading.Thread(target=f.set_result, args=(42,))
+            with threading_helper.catch_threading_exception() as cm:
+                t.start()
+                self.assertTrue(f._condition.wait(support.SHORT_TIMEOUT))
+                t.join()
+                self.assertIs(cm.exc_type, ZeroDivisionError)
+        self.assertEqual(called, [f])
+        self.assertEqual(f.result(timeout=0), 42)
+
+    def test_wait_with_condition(self):
+        # wait() and as_completed() lock the condition of the future
+        f = self.Future()
+        def notification():
+            time.sleep(0.1)
+            f.set_result(42)
+
+        t = threading.Thread(target=notification)
+        t.start()
+        done, not_done = futures.wait([f], timeout=support.SHORT_TIMEOUT)
+        t.join()
+        self.assertEqual(done, {f})
+        self.assertEqual(f.result(), 42)
+
+
+class WorkItemTests:
+    def test_run(self):
+        f = Future()
+        self.WorkItem(f, capture, (1, 2), {'a': 3}).run()
+        self.assertEqual(f.result(), ((1, 2), {'a': 3}))
+
+    def test_run_exception(self):
+        f = Future()
+        self.WorkItem(f, sleep_and_raise, (0,), {}).run()
+        self.assertIsInstance(f.exception(), Exception)
+
+    def test_run_cancelled(self):
+        called = False
+        def fn():
+            nonlocal called
+            called = True
+
+        f = Future()
+        f.cancel()
+        self.WorkItem(f, fn, (), {}).run()
+        self.assertFalse(called)
+        self.assertEqual(f._state, CANCELLED_AND_NOTIFIED)
+
+    def test_run_python_future(self):
+        f = _base._PyFuture()
+        self.WorkItem(f, mul, (6, 7), {}).run()
+        self.assertEqual(f.result(), 42)
+
+
+class PyWorkItemTests(WorkItemTests, BaseTestCase):
+    WorkItem = thread._PyWorkItem
+
+
+@unittest.skipIf(thread._WorkItem is thread._PyWorkItem,
+                 'requires the C _concurrent_futures module')
+class CWorkItemTests(WorkItemTests, BaseTestCase):
+    WorkItem = thread._WorkItem
+
+
 def setUpModule():
     unittest.addModuleCleanup(multiprocessing.util._cleanup_tests)
     thread_info = threading_helper.threading_setup()
@@ -138,6 +138,43 @@ def test_contains(self):
 
         self.assertRaises(TypeError, d.__contains__)
 
+    def test_equal_hash_numbers(self):
+        # 1, 1.0 and True are equal: the first key is kept, the last value
+        d = {1: 'a', 1.0: 'b', True: 'c'}
+        self.assertEqual(d, {1: 'c'})
+        self.assertIs(type(next(iter(d))), int)
+        d = {True: 'a', 1: 'b'}
+        self.assertIs(type(next(iter(d))), bool)
+        for x in 1, 1.0, True:
+            self.assertEqual(d[x], 'b')
+            self.assertIn(x, {1: None})
+            self.assertIn(x, {1.0: None})
+        self.assertIn(-0.0, {0: None})
+        # Equal ints which are distinct objects
+        big = 10**30
+        other = int('1' + '0' * 30)
+        self.assertIsNot(big, other)
+        self.assertEqual({big: 1}[other], 1)
+        self.assertEqual({big: 1, other: 2}, {big: 2})
+        # Unequal ints with equal hashes
+        m = sys.hash_info.modulus
+        keys = [0, m, -m, 2 * m, -1, -2]
+        d = dict.fromkeys(keys)
+        self.assertEqual(len(d), 6)
+        for x in keys + [0.0]:
+            self.assertIn(x, d)
+        self.assertNotIn(3 * m, d)
+        del d[-1]
+        self.assertIn(-2, d)
+        self.assertNotIn(-1, d)
+        # Exact ints only: the __eq__ of a subclass is still called
+        class I(int):
+            __hash__ = int.__hash__
+            def __eq__(self, other):
+                return False
+        self.assertNotIn(I(1), {1: None})
+        self.assertEqual(len({1: None, I(1): None}), 2)
+
     def test_len(self):
         d = {}
         self.assertEqual(len(d), 0)
@@ -856,6 +893,46 @@ def __eq__(self, other):
         resizing = True
         d[9] = 6
 
+    def test_large_generic_keys(self):
+        # Large tables of non-str keys filter probed slots with hash tags
+        # stored next to the entries; exercise all the ways they are built.
+        class Colliding:
+            def __init__(self, value):
+                self.value = value
+            def __hash__(self):
+                return self.value & 0xff
+            def __eq__(self, other):
+                return (isinstance(other, Colliding)
+                        and self.value == other.value)
+
+        n = 30000
+        d = {}
+        for i in range(n):
+            d[i] = i
+            d[(i, -i)] = i
+        for i in range(0, n, 1000):
+            d[Colliding(i)] = i
+        for i in range(n):
+            self.assertEqual(d[i], i)
+            self.assertEqual(d[(i, -i)], i)
+            self.assertNotIn(i + n, d)
+        for i in range(0, n, 1000):
+            self.assertEqual(d[Colliding(i)], i)
+            self.assertNotIn(Colliding(i + 1), d)
+
+        for i in range(0, n, 2):
+            del d[i]
+        self.assertEqual(d.setdefault(n + 1, 'x'), 'x')
+        self.assertEqual(d.popitem(), (n + 1, 'x'))
+        c = d.copy()
+        self.assertEqual(c, d)
+        for i in range(n):
+            self.assertIs(i in c, i % 2 == 1)
+            self.assertEqual(c[(i, -i)], i)
+        c.update((float(i), i) for i in range(n))
+        for i in range(n):
+            self.assertEqual(c[i], i)
+
     def test_empty_presized_dict_in_freelist(self):
         # Bug #3537: if an empty but presized dict with a size larger
         # than 7 was in the freelist, it triggered an assertion failure
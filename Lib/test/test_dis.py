@@ -167,20 +167,33 @@ def bug1333982(x=[]):
 %3d        RESUME                   0
 
 %3d        LOAD_ASSERTION_ERROR
-           LOAD_CONST               2 (<code object <listcomp> at 0x..., file "%s", line %d>)
-           MAKE_FUNCTION            0
            LOAD_FAST                0 (x)
            GET_ITER
-           CALL                     0
+           LOAD_FAST_AND_CLEAR      1 (s)
+           SWAP                     2
+           BUILD_LIST               0
+           SWAP                     2
+        >> FOR_ITER                 4 (to 28)
+           STORE_FAST               1 (s)
+           LOAD_FAST                1 (s)
+           LIST_APPEND              2
+           JUMP_BACKWARD            6 (to 16)
+        >> SWAP                     2
+           STORE_FAST               1 (s)
 
-%3d        LOAD_CONST               3 (1)
+%3d        LOAD_CONST               2 (1)
 
 %3d        BINARY_OP                0 (+)
            CALL                     0
            RAISE_VARARGS            1
+        >> SWAP                     2
+           POP_TOP
+           SWAP                     2
+           STORE_FAST               1 (s)
+           RERAISE                  0
+ExceptionTable:
+1 row
 """ % (bug1333982.__code__.co_firstlineno,
-       bug1333982.__code__.co_firstlineno + 1,
-       __file__,
        bug1333982.__code__.co_firstlineno + 1,
        bug1333982.__code__.co_firstlineno + 2,
        bug1333982.__code__.co_firstlineno + 1)
@@ -620,7 +633,7 @@ async def _co(x):
 def _h(y):
     def foo(x):
         '''funcdoc'''
-        return [x + z for z in y]
+        return list(x + z for z in y)
     return foo
 
 dis_nested_0 = """\
@@ -650,13 +663,15 @@ def foo(x):
 
 %3d        RESUME                   0
 
-%3d        LOAD_CLOSURE             0 (x)
+%3d        LOAD_GLOBAL              1 (NULL + list)
+           LOAD_CLOSURE             0 (x)
            BUILD_TUPLE              1
-           LOAD_CONST               1 (<code object <listcomp> at 0x..., file "%s", line %d>)
+           LOAD_CONST               1 (<code object <genexpr> at 0x..., file "%s", line %d>)
            MAKE_FUNCTION            8 (closure)
            LOAD_DEREF               1 (y)
            GET_ITER
            CALL                     0
+           CALL                     1
            RETURN_VALUE
 """ % (dis_nested_0,
        __file__,
@@ -668,20 +683,24 @@ def foo(x):
 )
 
 dis_nested_2 = """%s
-Disassembly of <code object <listcomp> at 0x..., file "%s", line %d>:
+Disassembly of <code object <genexpr> at 0x..., file "%s", line %d>:
            COPY_FREE_VARS           1
 
-%3d        RESUME                   0
-           BUILD_LIST               0
+%3d        RETURN_GENERATOR
+           POP_TOP
+           RESUME                   0
            LOAD_FAST                0 (.0)
-        >> FOR_ITER                 7 (to 26)
+        >> FOR_ITER                 9 (to 32)
            STORE_FAST               1 (z)
            LOAD_DEREF               2 (x)
            LOAD_FAST                1 (z)
            BINARY_OP                0 (+)
-           LIST_APPEND              2
-           JUMP_BACKWARD            9 (to 8)
-        >> RETURN_VALUE
+           YIELD_VALUE              2
+           RESUME                   1
+           POP_TOP
+           JUMP_BACKWARD           11 (to 10)
+        >> LOAD_CONST               0 (None)
+           RETURN_VALUE
 """ % (dis_nested_1,
        __file__,
        _h.__code__.co_firstlineno + 3,
@@ -746,7 +765,7 @@ def extended_arg_quick():
 %3d           2 LOAD_CONST               1 (Ellipsis)
               4 EXTENDED_ARG             1
               6 UNPACK_EX              256
-              8 STORE_FAST               0 (_)
+              8 POP_TOP
              10 STORE_FAST               0 (_)
              12 LOAD_CONST               0 (None)
              14 RETURN_VALUE
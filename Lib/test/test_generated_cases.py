@@ -0,0 +1,277 @@
+"""Tests for Tools/cases_generator, which generates the interpreter cases
+from Python/bytecodes.c."""
+
+import io
+import os
+import tempfile
+import unittest
+from test import test_tools
+
+test_tools.skip_if_missing('cases_generator')
+with test_tools.imports_under_tool('cases_generator'):
+    import generate_cases
+    import lexer
+    import parser
+
+
+OPCODE_PY = os.path.join(test_tools.basepath, 'Lib', 'opcode.py')
+
+PRELUDE = "// BEGIN BYTECODES //\n"
+MIDDLE = "// END BYTECODES //\n// BEGIN SUPERINSTRUCTIONS //\n"
+POSTLUDE = "// END SUPERINSTRUCTIONS //\n"
+
+
+def source(instrs, supers=""):
+    return PRELUDE + instrs + MIDDLE + supers + POSTLUDE
+
+
+class TestLexer(unittest.TestCase):
+
+    def test_tokens(self):
+        tokens = list(lexer.tokenize('inst(X, (a -- b)) { "}" /* } */ }'))
+        self.assertEqual(
+            [t.text for t in tokens],
+            ['inst', '(', 'X', ',', '(', 'a', '--', 'b', ')', ')',
+             '{', '"}"', '}'])
+        self.assertEqual(tokens[10].kind, 'OPERATOR')
+        self.assertEqual(tokens[11].kind, 'STRING')
+
+    def test_line_numbers(self):
+        tokens = list(lexer.tokenize("a\n// b\nc", line=10))
+        self.assertEqual([(t.text, t.line) for t in tokens],
+                         [('a', 10), ('c', 12)])
+
+
+class TestParser(unittest.TestCase):
+
+    def test_plain_instruction(self):
+        defs = parser.parse(source(
+            "        inst(NOP) {\n"
+            "            DISPATCH();\n"
+            "        }\n"))
+        inst = defs.instrs['NOP']
+        self.assertFalse(inst.has_stack_effect)
+        self.assertEqual(inst.block.text,
+                         "{\n            DISPATCH();\n        }")
+        self.assertEqual(inst.block.indent, "        ")
+
+    def test_stack_effect(self):
+        defs = parser.parse(source(
+            "        inst(OP, (left, unused[oparg-1], right -- res)) {\n"
+            "        }\n"))
+        inst = defs.instrs['OP']
+        self.assertEqual(inst.inputs, [
+            parser.StackItem('left'),
+            parser.StackItem('unused', 'oparg-1'),
+            parser.StackItem('right'),
+        ])
+        self.assertEqual(inst.outputs, [parser.StackItem('res')])
+
+    def test_superinstruction(self):
+        defs = parser.parse(source(
+            "", "super(A__B) = A + B;\n"))
+        sup = defs.supers['A__B']
+        self.assertEqual(sup.ops, ['A', 'B'])
+
+    def test_errors(self):
+        for text in [
+            "        inst(X) { }\n",
+            "        inst(X, (a, a -- b)) {\n        }\n",
+            "        inst(X, (a b)) {\n        }\n",
+            "        inst(X) {\n        }\n        inst(X) {\n        }\n",
+        ]:
+            with self.subTest(text=text):
+                with self.assertRaises(parser.ParseError):
+                    parser.parse(source(text))
+        with self.assertRaises(parser.ParseError):
+            parser.parse(source("", "super(A__B) = A + B + C;\n"))
+        with self.assertRaises(parser.ParseError):
+            parser.parse("inst(X) {\n}\n")
+
+
+class TestGenerator(unittest.TestCase):
+
+    def analyze(self, instrs, supers=""):
+        fd, filename = tempfile.mkstemp(suffix='.c')
+        self.addCleanup(os.remove, filename)
+        with os.fdopen(fd, 'w') as fp:
+            fp.write(source(instrs, supers))
+        return generate_cases.Analyzer(filename, OPCODE_PY)
+
+    def generate(self, instrs, supers=""):
+        analyzer = self.analyze(instrs, supers)
+        out = io.StringIO()
+        analyzer.write_cases(out)
+        header = generate_cases.HEADER
+        self.assertTrue(out.getvalue().startswith(header))
+        return out.getvalue()[len(header):]
+
+    def test_copied_verbatim(self):
+        text = ("        inst(NOP) {\n"
+                "            /* comment */\n"
+                "#ifdef X\n"
+                "            DISPATCH();\n"
+                "#endif\n"
+                "        }\n")
+        self.assertEqual(self.generate(text),
+                         "\n" + text.replace("inst(NOP)", "TARGET(NOP)"))
+
+    def test_stack_effect(self):
+        output = self.generate(
+            "        inst(BINARY_SUBSCR, (container, sub -- res)) {\n"
+            "            PREDICTED(BINARY_SUBSCR);\n"
+            "            res = PyObject_GetItem(container, sub);\n"
+            "            ERROR_IF(res == NULL, error);\n"
+            "        }\n")
+        self.assertEqual(output, """
+        TARGET(BINARY_SUBSCR) {
+            PREDICTED(BINARY_SUBSCR);
+            PyObject *sub = PEEK(1);
+            PyObject *container = PEEK(2);
+            PyObject *res;
+            res = PyObject_GetItem(container, sub);
+            if (res == NULL) goto pop_2_error;
+            STACK_SHRINK(1);
+            POKE(1, res);
+            DISPATCH();
+        }
+""")
+
+    def test_arrays(self):
+        output = self.generate(
+            "        inst(LIST_APPEND, "
+            "(list, unused[oparg-1], v -- list, unused[oparg-1])) {\n"
+            "            ERROR_IF(append(list, v) < 0, error);\n"
+            "            PREDICT(JUMP_BACKWARD_QUICK);\n"
+            "        }\n"
+            "        inst(BUILD_TUPLE, (values[oparg] -- tup)) {\n"
+            "            tup = build(values, oparg);\n"
+            "            ERROR_IF(tup == NULL, error);\n"
+            "        }\n")
+        self.assertEqual(output, """
+        TARGET(LIST_APPEND) {
+            PyObject *v = PEEK(1);
+            PyObject *list = PEEK(2 + (oparg-1));
+            if (append(list, v) < 0) goto pop_1_error;
+            STACK_SHRINK(1);
+            PREDICT(JUMP_BACKWARD_QUICK);
+            DISPATCH();
+        }
+
+        TARGET(BUILD_TUPLE) {
+            PyObject **values = &PEEK(oparg);
+            PyObject *tup;
+            tup = build(values, oparg);
+            if (tup == NULL) { STACK_SHRINK(oparg); goto error; }
+            STACK_SHRINK(oparg);
+            STACK_GROW(1);
+            POKE(1, tup);
+            DISPATCH();
+        }
+""")
+
+    def test_stack_macros_forbidden(self):
+        with self.assertRaises(generate_cases.GeneratorError):
+            self.analyze(
+                "        inst(POP_TOP, (value --)) {\n"
+                "            PUSH(value);\n"
+                "        }\n")
+
+    def test_superinstruction(self):
+        instrs = ("        inst(LOAD_CONST, (-- value)) {\n"
+                  "            PREDICTED(LOAD_CONST);\n"
+                  "            value = GETITEM(consts, oparg);\n"
+                  "        }\n"
+                  "        inst(LOAD_FAST, (-- value)) {\n"
+                  "            value = GETLOCAL(oparg);\n"
+                  "        }\n")
+        output = self.generate(
+            instrs, "super(LOAD_CONST__LOAD_FAST) = LOAD_CONST + LOAD_FAST;\n")
+        self.assertIn("""
+        TARGET(LOAD_CONST__LOAD_FAST) {
+            {
+                PyObject *value;
+                value = GETITEM(consts, oparg);
+                STACK_GROW(1);
+                POKE(1, value);
+            }
+            NEXTOPARG();
+            next_instr++;
+            {
+                PyObject *value;
+                value = GETLOCAL(oparg);
+                STACK_GROW(1);
+                POKE(1, value);
+            }
+            NOTRACE_DISPATCH();
+        }
+""", output)
+        analyzer = self.analyze(
+            instrs, "super(LOAD_CONST__LOAD_FAST) = LOAD_CONST + LOAD_FAST;\n")
+        out = io.StringIO()
+        analyzer.write_metadata(out)
+        self.assertIn("case LOAD_CONST:\n"
+                      "            switch (second) {\n"
+                      "                case LOAD_FAST:\n"
+                      "                    return LOAD_CONST__LOAD_FAST;\n",
+                      out.getvalue())
+
+    def test_superinstruction_problems(self):
+        analyzer = self.analyze(
+            "        inst(LOAD_FAST, (-- value)) {\n"
+            "            value = GETLOCAL(oparg);\n"
+            "        }\n"
+            "        inst(GET_ITER, (iterable -- iter)) {\n"
+            "            iter = PyObject_GetIter(iterable);\n"
+            "            ERROR_IF(iter == NULL, error);\n"
+            "        }\n"
+            "        inst(BINARY_SUBSCR, (container, sub -- res)) {\n"
+            "            res = PyObject_GetItem(container, sub);\n"
+            "        }\n"
+            "        inst(POP_TOP) {\n"
+            "            DISPATCH();\n"
+            "        }\n")
+        self.assertIsNone(analyzer.super_problem(['LOAD_FAST', 'LOAD_FAST']))
+        self.assertIsNone(analyzer.super_problem(['GET_ITER', 'LOAD_FAST']))
+        self.assertIn('can fail',
+                      analyzer.super_problem(['LOAD_FAST', 'GET_ITER']))
+        self.assertIn('cache',
+                      analyzer.super_problem(['LOAD_FAST', 'BINARY_SUBSCR']))
+        self.assertIn('stack effect',
+                      analyzer.super_problem(['LOAD_FAST', 'POP_TOP']))
+
+    def test_select_superinstructions(self):
+        analyzer = self.analyze(
+            "        inst(LOAD_FAST, (-- value)) {\n"
+            "            value = GETLOCAL(oparg);\n"
+            "        }\n"
+            "        inst(STORE_FAST, (value --)) {\n"
+            "            SETLOCAL(oparg, value);\n"
+            "        }\n"
+            "        inst(BINARY_SUBSCR, (container, sub -- res)) {\n"
+            "            res = PyObject_GetItem(container, sub);\n"
+            "        }\n",
+            "super(LOAD_FAST__LOAD_FAST) = LOAD_FAST + LOAD_FAST;\n")
+        fd, counts = tempfile.mkstemp()
+        self.addCleanup(os.remove, counts)
+        with os.fdopen(fd, 'w') as fp:
+            fp.write("# first second count\n"
+                     "LOAD_FAST BINARY_SUBSCR_LIST_INT 100\n"
+                     "LOAD_FAST__LOAD_FAST STORE_FAST 60\n"
+                     "STORE_FAST LOAD_FAST__LOAD_FAST 30\n"
+                     "LOAD_FAST LOAD_FAST 20\n")
+        pairs = analyzer.select_supers(counts, 2)
+        self.assertEqual(pairs, [('LOAD_FAST', 'STORE_FAST'),
+                                 ('STORE_FAST', 'LOAD_FAST')])
+        missing = analyzer.rewrite_supers(pairs)
+        self.assertEqual(missing, [('LOAD_FAST', 'LOAD_FAST__STORE_FAST')])
+        with open(analyzer.filename) as fp:
+            defs = parser.parse(fp.read())
+        self.assertEqual(list(defs.supers),
+                         ['LOAD_FAST__STORE_FAST', 'STORE_FAST__LOAD_FAST'])
+        self.assertEqual(list(defs.instrs),
+                         ['LOAD_FAST', 'STORE_FAST', 'BINARY_SUBSCR'])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1,4 +1,6 @@
 import doctest
+import sys
+import types
 import unittest
 
 
@@ -146,6 +148,92 @@
 """
 
 
+
+class ListComprehensionTest(unittest.TestCase):
+    # List comprehensions in functions are inlined: check that the names
+    # they bind are still isolated from the enclosing function.
+
+    def test_inlined(self):
+        def f(items):
+            return [x * 2 for x in items]
+        self.assertEqual(f([1, 2]), [2, 4])
+        self.assertFalse(any(isinstance(const, types.CodeType)
+                             for const in f.__code__.co_consts))
+
+    def test_iteration_var_restored(self):
+        def f(items):
+            x = 'outer'
+            y = [x for x in items]
+            return x, y
+        self.assertEqual(f([1, 2]), ('outer', [1, 2]))
+
+    def test_iteration_var_unbound_after(self):
+        def f(items):
+            x = 1
+            del x
+            [x for x in items]
+            return x
+        with self.assertRaises(UnboundLocalError):
+            f([1])
+
+    def test_iteration_var_restored_on_exception(self):
+        def f(items):
+            x = 'outer'
+            try:
+                [1 / x for x in items]
+            except ZeroDivisionError:
+                return x
+        self.assertEqual(f([1, 0]), 'outer')
+
+    def test_shadows_cell(self):
+        def f(items):
+            x = 'outer'
+            g = lambda: x
+            y = [x for x in items]
+            return x, g(), y
+        self.assertEqual(f([1, 2]), ('outer', 'outer', [1, 2]))
+
+    def test_shadows_global(self):
+        def f(items):
+            global x
+            return [x for x in items]
+        self.assertEqual(f([1, 2]), [1, 2])
+        self.assertNotIn('x', globals())
+
+    def test_shadows_free_var(self):
+        def outer():
+            x = 'outer'
+            def f(items):
+                y = [x for x in items]
+                return x, y
+            return f
+        self.assertEqual(outer()([1, 2]), ('outer', [1, 2]))
+
+    def test_walrus(self):
+        def f(items):
+            y = [z := x + 1 for x in items]
+            return y, z
+        self.assertEqual(f([1, 2]), ([2, 3], 3))
+
+    def test_nested(self):
+        def f(rows):
+            x = 'outer'
+            y = [[x * 10 + i for x in row] for i, row in enumerate(rows)]
+            return x, y
+        self.assertEqual(f([[1], [2, 3]]), ('outer', [[10], [21, 31]]))
+
+    def test_frame(self):
+        def f(items):
+            return [sys._getframe() for x in items]
+        self.assertEqual(f([1])[0].f_code, f.__code__)
+
+    def test_locals(self):
+        def f(items):
+            y = 1
+            return [sorted(locals()) for x in items][0]
+        self.assertEqual(f([1]), ['items', 'x', 'y'])
+
+
 __test__ = {'doctests' : doctests}
 
 def load_tests(loader, tests, pattern):
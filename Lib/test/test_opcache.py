@@ -1,3 +1,5 @@
+import dis
+import types
 import unittest
 
 
@@ -177,6 +179,112 @@ def f():
         for _ in range(1025):
             self.assertFalse(f())
 
+    def test_metaclass_attribute_added_after_optimization(self):
+        class Metaclass(type):
+            pass
+
+        class Class(metaclass=Metaclass):
+            attribute = True
+
+        def f():
+            return Class.attribute
+
+        for _ in range(1025):
+            self.assertTrue(f())
+
+        Metaclass.attribute = property(lambda self: False)
+
+        for _ in range(1025):
+            self.assertFalse(f())
+
+    def test_getattr_hook(self):
+        class Proxy:
+            def __init__(self):
+                self.calls = 0
+            def __getattr__(self, name):
+                self.calls += 1
+                return name
+
+        def f(o):
+            return o.attribute
+
+        o = Proxy()
+        for _ in range(1025):
+            self.assertEqual(f(o), "attribute")
+        self.assertEqual(o.calls, 1025)
+
+        o.attribute = "instance"
+        for _ in range(1025):
+            self.assertEqual(f(o), "instance")
+        self.assertEqual(o.calls, 1025)
+
+        del o.attribute
+        Proxy.__getattr__ = lambda self, name: name.upper()
+        for _ in range(1025):
+            self.assertEqual(f(o), "ATTRIBUTE")
+
+    def test_getattr_hook_raises(self):
+        class Proxy:
+            def __getattr__(self, name):
+                raise AttributeError(name)
+
+        def f(o):
+            try:
+                return o.attribute
+            except AttributeError:
+                return None
+
+        for _ in range(1025):
+            self.assertIsNone(f(Proxy()))
+
+    def test_getattribute(self):
+        class C:
+            x = 1
+            def __getattribute__(self, name):
+                return name * 2
+
+        def f(o):
+            return o.x
+
+        o = C()
+        for _ in range(1025):
+            self.assertEqual(f(o), "xx")
+
+        del C.__getattribute__
+        for _ in range(1025):
+            self.assertEqual(f(o), 1)
+
+    def test_python_descriptor(self):
+        class Descriptor:
+            def __get__(self, instance, owner):
+                return (self, instance, owner)
+
+        descriptor = Descriptor()
+
+        class C:
+            x = descriptor
+
+        def f(o):
+            return o.x
+
+        o = C()
+        for _ in range(1025):
+            self.assertEqual(f(o), (descriptor, o, C))
+
+        o.x = "instance"
+        for _ in range(1025):
+            self.assertEqual(f(o), "instance")
+
+        del o.x
+        Descriptor.__get__ = lambda self, instance, owner: "new"
+        for _ in range(1025):
+            self.assertEqual(f(o), "new")
+
+        Descriptor.__set__ = lambda self, instance, value: None
+        o.x = "ignored"
+        for _ in range(1025):
+            self.assertEqual(f(o), "new")
+
 
 class TestLoadMethodCache(unittest.TestCase):
     def test_descriptor_added_after_optimization(self):
@@ -362,6 +470,184 @@ def f():
             self.assertFalse(f())
 
 
+class TestLoadGlobalCache(unittest.TestCase):
+    def make_function(self, body):
+        namespace = {}
+        exec(f"def f():\n    {body}", namespace)
+        return namespace["f"], namespace
+
+    def opnames(self, f):
+        return [i.opname for i in dis.get_instructions(f, adaptive=True)]
+
+    def test_builtin_shadowed_after_optimization(self):
+        f, namespace = self.make_function("return len")
+        for _ in range(1025):
+            self.assertIs(f(), len)
+        namespace["len"] = "global"
+        for _ in range(1025):
+            self.assertEqual(f(), "global")
+        del namespace["len"]
+        for _ in range(1025):
+            self.assertIs(f(), len)
+
+    def test_global_deleted_and_added_again(self):
+        f, namespace = self.make_function("return x")
+        namespace["x"] = 1
+        for _ in range(1025):
+            self.assertEqual(f(), 1)
+        del namespace["x"]
+        with self.assertRaises(NameError):
+            f()
+        namespace["x"] = 2
+        for _ in range(1025):
+            self.assertEqual(f(), 2)
+
+    def test_unrelated_global_added_after_optimization(self):
+        f, namespace = self.make_function("return (x, len)")
+        namespace["x"] = 1
+        for _ in range(1025):
+            self.assertEqual(f(), (1, len))
+        opnames = self.opnames(f)
+        self.assertIn("LOAD_GLOBAL_MODULE", opnames)
+        self.assertIn("LOAD_GLOBAL_BUILTIN", opnames)
+        namespace["y"] = 2
+        self.assertEqual(f(), (1, len))
+        self.assertEqual(self.opnames(f), opnames)
+
+    def test_module_method_shadowed_after_optimization(self):
+        class Module(types.ModuleType):
+            def method(self):
+                return "method"
+
+        module = Module("module")
+        exec("def f(): return x", module.__dict__)
+        module.x = 1
+        for _ in range(1025):
+            self.assertEqual(module.f(), 1)
+
+        def g():
+            return module.method()
+
+        for _ in range(1025):
+            self.assertEqual(g(), "method")
+        module.method = lambda: "attribute"
+        for _ in range(1025):
+            self.assertEqual(g(), "attribute")
+
+
+class TestSubscrCache(unittest.TestCase):
+    def test_str_int(self):
+        def f(s, i):
+            return s[i]
+
+        for _ in range(1025):
+            self.assertIs(f("spam", 1), chr(0x70))
+            self.assertIs(f("\xe9t\xe9", 0), chr(0xe9))
+        self.assertEqual(f("\u20ac!", 0), "\u20ac")
+        self.assertEqual(f("spam", -1), "m")
+        with self.assertRaises(IndexError):
+            f("spam", 4)
+
+    def test_bytes_and_bytearray_int(self):
+        def f(b, i):
+            return b[i]
+
+        for _ in range(1025):
+            self.assertEqual(f(b"spam", 1), ord("p"))
+            self.assertEqual(f(bytearray(b"\xff"), 0), 255)
+        self.assertEqual(f(b"spam", -1), ord("m"))
+        self.assertEqual(f(bytearray(b"spam"), -1), ord("m"))
+        with self.assertRaises(IndexError):
+            f(bytearray(), 0)
+
+    def test_store_bytearray_int(self):
+        def f(b, i, v):
+            b[i] = v
+
+        b = bytearray(3)
+        for i in range(1025):
+            f(b, i % 3, i % 256)
+        self.assertEqual(b, bytearray([255, 0, 254]))
+        f(b, -1, 7)
+        self.assertEqual(b, bytearray([255, 0, 7]))
+        with self.assertRaises(ValueError):
+            f(b, 0, 256)
+        with self.assertRaises(IndexError):
+            f(b, 3, 0)
+        self.assertEqual(b, bytearray([255, 0, 7]))
+
+    def test_slice_int(self):
+        def f(seq, start, stop):
+            return seq[start:stop]
+
+        l = [1, 2, 3, 4]
+        b = b"spam"
+        for _ in range(1025):
+            self.assertEqual(f(l, 1, 3), [2, 3])
+            self.assertEqual(f(l, -3, None), [2, 3, 4])
+            self.assertEqual(f(b, 3, 1), b"")
+            self.assertEqual(f(b, None, 100), b"spam")
+        self.assertIs(f(b, None, None), b)
+        self.assertEqual(f(l, 2**100, None), [])
+        self.assertEqual(f(l, 0, -2**100), [])
+        self.assertEqual(f("spam", 1, 3), "pa")
+        with self.assertRaises(TypeError):
+            f(l, 1.0, None)
+
+
+class TestCallCache(unittest.TestCase):
+    def test_keywords(self):
+        def f(a, b=2, c=3, *, d=4, e=5):
+            return a, b, c, d, e
+
+        def g():
+            return f(1, c=30, e=50), f(a=1, d=40), f(1, e=5, d=4)
+
+        for _ in range(1025):
+            self.assertEqual(g(), ((1, 2, 30, 4, 50), (1, 2, 3, 40, 5),
+                                   (1, 2, 3, 4, 5)))
+
+        f.__defaults__ = (-2, -3)
+        self.assertEqual(g()[0], (1, -2, 30, 4, 50))
+        f.__kwdefaults__["d"] = -4
+        self.assertEqual(g()[0], (1, -2, 30, -4, 50))
+        del f.__kwdefaults__["d"]
+        with self.assertRaisesRegex(TypeError, "keyword-only argument: 'd'"):
+            g()
+
+    def test_method_keywords(self):
+        class C:
+            def m(self, x, /, y=0, *, z):
+                return x, y, z
+
+        def f(o):
+            return o.m(1, z=3)
+
+        o = C()
+        for _ in range(1025):
+            self.assertEqual(f(o), (1, 0, 3))
+        o.m = lambda x, z: (x, z)
+        self.assertEqual(f(o), (1, 3))
+
+    def test_call_function_ex(self):
+        def f(a, b=2, *args, c=3, **kwargs):
+            return a, b, args, c, kwargs
+
+        def g(args, kwargs):
+            return f(*args, **kwargs)
+
+        for _ in range(1025):
+            self.assertEqual(g((1,), {}), (1, 2, (), 3, {}))
+            self.assertEqual(g([1, 2, 3], {"c": 4, "d": 5}),
+                             (1, 2, (3,), 4, {"d": 5}))
+        with self.assertRaisesRegex(TypeError, "multiple values"):
+            g((1,), {"a": 1})
+        with self.assertRaisesRegex(TypeError, "keywords must be strings"):
+            g((1,), {1: 1})
+        with self.assertRaisesRegex(TypeError, "missing 1 required"):
+            g((), {})
+
+
 if __name__ == "__main__":
     import unittest
     unittest.main()
@@ -658,6 +658,49 @@ def test_static_swaps_match_sequence(self):
                     else:
                         self.assertNotInBytecode(code, "SWAP")
 
+    def test_static_swaps_store_to_same_local(self):
+        def f(a):
+            a, a = a, 1
+            return a
+        self.assertEqual(f(0), 1)
+
+        def g(x):
+            x = [x for x in x]
+            return x
+        self.assertEqual(g((1, 2)), [1, 2])
+
+    def test_dead_store_elimination(self):
+        def f(t):
+            _, _ = t
+            return _
+        self.assertEqual(count_instr_recursively(f, 'STORE_FAST'), 1)
+        self.assertInBytecode(f, 'POP_TOP')
+        self.assertEqual(f((1, 2)), 2)
+
+    def test_forward_constants_through_locals(self):
+        def f():
+            x = 1; return x
+        self.assertNotInBytecode(f, 'LOAD_FAST')
+        self.assertEqual(f(), 1)
+
+        def g():
+            x = None; x; return x + 1 if x else 2
+        self.assertNotInBytecode(g, 'LOAD_FAST')
+        self.assertNotInBytecode(g, 'POP_TOP')
+        self.assertNotInBytecode(g, 'POP_JUMP_IF_FALSE')
+        self.assertEqual(g(), 2)
+
+    def test_no_constant_forwarding_across_lines(self):
+        def f():
+            x = 1
+            return x
+        self.assertInBytecode(f, 'LOAD_FAST')
+
+        def g(y):
+            x = 1; del x; x = y; return x
+        self.assertInBytecode(g, 'LOAD_FAST')
+        self.assertEqual(g(2), 2)
+
 
 class TestBuglets(unittest.TestCase):
 
@@ -779,6 +822,45 @@ def f():
         self.assertInBytecode(f, 'LOAD_FAST_CHECK')
         self.assertNotInBytecode(f, 'LOAD_FAST')
 
+    def test_load_fast_known_after_comprehension(self):
+        def f(a):
+            x = 1
+            [x for x in a]
+            return x
+        self.assertInBytecode(f, 'LOAD_FAST')
+        self.assertNotInBytecode(f, 'LOAD_FAST_CHECK')
+        self.assertEqual(f([2]), 1)
+
+        def g(a, b):
+            x = 1
+            [[x for x in b] for x in a]
+            return x
+        self.assertNotInBytecode(g, 'LOAD_FAST_CHECK')
+        self.assertEqual(g([2], [3]), 1)
+
+    def test_load_fast_unknown_after_comprehension(self):
+        def f(a):
+            if not a:
+                x = 1
+            [x for x in a]
+            return x
+        self.assertInBytecode(f, 'LOAD_FAST_CHECK')
+        self.assertRaises(UnboundLocalError, f, [1])
+
+    def test_load_fast_many_locals(self):
+        names = [f"x{i}" for i in range(100)]
+        source = "def f():\n"
+        source += "".join(f"    {name} = 1\n" for name in names)
+        source += "    del x70\n"
+        source += f"    return {' + '.join(names)}\n"
+        namespace = {}
+        exec(source, namespace)
+        f = namespace["f"]
+        checks = [instr.argval for instr in dis.get_instructions(f)
+                  if instr.opname == 'LOAD_FAST_CHECK']
+        self.assertEqual(checks, ["x70"])
+        self.assertRaises(UnboundLocalError, f)
+
     def test_setting_lineno_adds_check(self):
         code = textwrap.dedent("""\
             def f():
@@ -2,10 +2,12 @@
 # to ensure the Queue locks remain stable.
 import itertools
 import random
+import signal
 import threading
 import time
 import unittest
 import weakref
+from test import support
 from test.support import gc_collect
 from test.support import import_helper
 from test.support import threading_helper
@@ -541,6 +543,66 @@ def test_negative_timeout_raises_exception(self):
         q.put(1)
         with self.assertRaises(ValueError):
             q.get(timeout=-1)
+        with self.assertRaises(ValueError):
+            q.get_many(timeout=-1)
+
+    def test_put_many_get_many(self):
+        q = self.q
+        q.put_many([1, 2, 3])
+        q.put_many(iter((4, 5)))
+        q.put_many([])
+        self.assertEqual(q.qsize(), 5)
+        self.assertEqual(q.get_many(2), [1, 2])
+        self.assertEqual(q.get(), 3)
+        self.assertEqual(q.get_many(max_items=10), [4, 5])
+        self.assertTrue(q.empty())
+
+        q.put(6)
+        q.put_many(range(7, 10))
+        self.assertEqual(q.get_many(), [6, 7, 8, 9])
+        self.assertEqual(q.qsize(), 0)
+
+        with self.assertRaises(self.queue.Empty):
+            q.get_many(block=False)
+        with self.assertRaises(self.queue.Empty):
+            q.get_many(timeout=1e-3)
+        with self.assertRaises(ValueError):
+            q.get_many(0)
+        with self.assertRaises(TypeError):
+            q.put_many(1)
+        self.assertTrue(q.empty())
+
+    def test_wraparound(self):
+        # Interleave puts and gets so that the items wrap around the
+        # internal buffer while it grows and shrinks.
+        q = self.q
+        expected = 0
+        n = 0
+        for size in (3, 10, 100, 1000, 10, 3, 0):
+            while q.qsize() < size:
+                q.put(n)
+                n += 1
+            for i in range(size * 2):
+                q.put(n)
+                n += 1
+                self.assertEqual(q.get(), expected)
+                expected += 1
+            while q.qsize() > size:
+                self.assertEqual(q.get(), expected)
+                expected += 1
+        self.assertEqual(expected, n)
+        self.assertTrue(q.empty())
+
+    def test_get_many_blocks(self):
+        q = self.q
+        results = []
+        def consume():
+            results.extend(q.get_many())
+        with threading_helper.start_threads([threading.Thread(target=consume)]):
+            time.sleep(0.01)
+            q.put_many([1, 2])
+        # put_many() adds all the items before waking up the consumer
+        self.assertEqual(results, [1, 2])
 
     def test_order(self):
         # Test a pair of concurrent put() and get()
@@ -582,6 +644,32 @@ def test_many_threads_timeout(self):
 
         self.assertEqual(sorted(results), inputs)
 
+    def feed_many(self, q, seq, rnd, sentinel):
+        while seq:
+            n = rnd.randint(1, 10)
+            batch = seq[-n:]
+            del seq[-n:]
+            batch.reverse()
+            q.put_many(batch)
+            if rnd.random() > 0.5:
+                time.sleep(rnd.random() * 1e-3)
+        q.put(sentinel)
+
+    def consume_many(self, q, results, sentinel):
+        while True:
+            for val in q.get_many(3):
+                if val == sentinel:
+                    return
+                results.append(val)
+
+    def test_order_batched(self):
+        # Test a pair of concurrent put_many() and get_many()
+        q = self.q
+        inputs = list(range(1000))
+        results = self.run_threads(1, q, inputs,
+                                   self.feed_many, self.consume_many)
+        self.assertEqual(results, inputs)
+
     def test_references(self):
         # The queue should lose references to each item as soon as
         # it leaves the queue.
@@ -619,6 +707,35 @@ def test_is_default(self):
         self.assertIs(self.type2test, self.queue.SimpleQueue)
         self.assertIs(self.type2test, self.queue.SimpleQueue)
 
+    @unittest.skipUnless(hasattr(signal, 'setitimer'), 'requires setitimer()')
+    def test_get_many_nomemory(self):
+        # get_many() wakes up, then fails to allocate room for the items:
+        # they stay in the queue, which remains usable.
+        _testcapi = import_helper.import_module('_testcapi')
+        q = self.q
+        def handler(signum, frame):
+            q.put(1)
+            # Fail the next allocation: the list get_many() returns
+            _testcapi.set_nomemory(0, 1)
+        old_handler = signal.signal(signal.SIGALRM, handler)
+        self.addCleanup(signal.signal, signal.SIGALRM, old_handler)
+        signal.setitimer(signal.ITIMER_REAL, 0.01)
+        try:
+            with self.assertRaises(MemoryError):
+                q.get_many(timeout=support.SHORT_TIMEOUT)
+        finally:
+            _testcapi.remove_mem_hooks()
+            signal.setitimer(signal.ITIMER_REAL, 0)
+        self.assertEqual(q.get_many(block=False), [1])
+
+        results = []
+        def consume():
+            results.extend(q.get_many())
+        with threading_helper.start_threads([threading.Thread(target=consume)]):
+            time.sleep(0.01)
+            q.put(2)
+        self.assertEqual(results, [2])
+
     def test_reentrancy(self):
         # bpo-14976: put() may be called reentrantly in an asynchronous
         # callback.
@@ -11,6 +11,7 @@
 import collections
 import collections.abc
 import itertools
+import sys
 
 class PassThru(Exception):
     pass
@@ -69,6 +70,40 @@ def test_contains(self):
         s = self.thetype([frozenset(self.letters)])
         self.assertIn(self.thetype(self.letters), s)
 
+    def test_equal_hash_numbers(self):
+        # 1, 1.0 and True are equal and the first one added is kept
+        s = self.thetype([1, 1.0, True])
+        self.assertEqual(len(s), 1)
+        self.assertIs(type(next(iter(s))), int)
+        s = self.thetype([True, 1, 1.0])
+        self.assertIs(type(next(iter(s))), bool)
+        for x in 1, 1.0, True:
+            self.assertIn(x, s)
+            self.assertIn(x, self.thetype([1]))
+            self.assertIn(x, self.thetype([1.0]))
+        self.assertIn(-0.0, self.thetype([0]))
+        self.assertIn(0, self.thetype([-0.0]))
+        # Equal ints which are distinct objects
+        big = 10**30
+        other = int('1' + '0' * 30)
+        self.assertIsNot(big, other)
+        self.assertIn(other, self.thetype([big]))
+        self.assertEqual(len(self.thetype([big, other])), 1)
+        # Unequal ints with equal hashes
+        m = sys.hash_info.modulus
+        s = self.thetype([0, m, -m, 2 * m, -1, -2])
+        self.assertEqual(len(s), 6)
+        for x in 0, m, -m, 2 * m, -1, -2, 0.0:
+            self.assertIn(x, s)
+        self.assertNotIn(3 * m, s)
+        # Exact ints only: the __eq__ of a subclass is still called
+        class I(int):
+            __hash__ = int.__hash__
+            def __eq__(self, other):
+                return False
+        self.assertNotIn(I(1), self.thetype([1]))
+        self.assertEqual(len(self.thetype([1, I(1)])), 2)
+
     def test_union(self):
         u = self.s.union(self.otherword)
         for c in self.letters:
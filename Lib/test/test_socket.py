@@ -2687,6 +2687,83 @@ def _testRecvFromNegative(self):
         self.cli.sendto(MSG, 0, (HOST, self.port))
 
 
+@requireAttrs(socket.socket, "sendmmsg", "recvmmsg_into")
+class BatchedUDPTest(SocketUDPTest):
+    # Tests for sendmmsg() and recvmmsg_into().  Datagrams sent over the
+    # loopback interface are queued by the time sendmmsg() returns.
+
+    def setUp(self):
+        super().setUp()
+        self.serv.settimeout(support.SHORT_TIMEOUT)
+        self.cli = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.addCleanup(self.cli.close)
+        self.cli.bind((HOST, 0))
+
+    def testSendmmsgAndRecvmmsgInto(self):
+        msgs = [MSG, b'x', bytearray(MSG[:5]), memoryview(MSG)[5:]]
+        self.assertEqual(
+            self.cli.sendmmsg(msgs, 0, (HOST, self.port)), len(msgs))
+        bufs = [bytearray(len(MSG)) for _ in range(len(msgs) + 1)]
+        result = self.serv.recvmmsg_into(bufs)
+        self.assertEqual(result, [(len(msg), self.cli.getsockname())
+                                  for msg in msgs])
+        for buf, msg in zip(bufs, msgs):
+            self.assertEqual(buf[:len(msg)], msg)
+
+    def testSendmmsgConnected(self):
+        self.cli.connect((HOST, self.port))
+        self.assertEqual(self.cli.sendmmsg([MSG, MSG]), 2)
+        buf = bytearray(len(MSG))
+        self.assertEqual(self.serv.recvmmsg_into([buf]),
+                         [(len(MSG), self.cli.getsockname())])
+        self.assertEqual(buf, MSG)
+        self.assertEqual(self.serv.recv(len(MSG)), MSG)
+
+    def testRecvmmsgIntoTruncated(self):
+        # The part of a datagram which doesn't fit is discarded.
+        self.cli.sendmmsg([MSG, MSG], 0, (HOST, self.port))
+        bufs = [bytearray(5), bytearray(len(MSG))]
+        self.assertEqual([n for n, addr in self.serv.recvmmsg_into(bufs)],
+                         [5, len(MSG)])
+        self.assertEqual(bufs, [MSG[:5], MSG])
+
+    def testRecvmmsgIntoTimeout(self):
+        self.serv.settimeout(0.0)
+        self.assertRaises(BlockingIOError,
+                          self.serv.recvmmsg_into, [bytearray(10)])
+        self.serv.settimeout(0.01)
+        self.assertRaises(TimeoutError,
+                          self.serv.recvmmsg_into, [bytearray(10)])
+
+    def testBadArguments(self):
+        self.assertRaises(TypeError, self.cli.sendmmsg)
+        self.assertRaises(TypeError, self.cli.sendmmsg, 1)
+        self.assertRaises(TypeError, self.cli.sendmmsg, [object()],
+                          0, (HOST, self.port))
+        self.assertRaises(TypeError, self.cli.sendmmsg, [MSG], 0, object())
+        self.assertRaises(TypeError, self.serv.recvmmsg_into)
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, 1)
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, [b'bytes'])
+
+    @unittest.skipUnless(hasattr(socket, 'UDP_SEGMENT'),
+                         'requires UDP_SEGMENT')
+    def testUDPSegment(self):
+        # The kernel splits a single large send into datagrams of the
+        # segment size.
+        try:
+            self.cli.setsockopt(socket.IPPROTO_UDP, socket.UDP_SEGMENT, 4)
+        except OSError as e:
+            self.skipTest(f'UDP_SEGMENT not supported: {e}')
+        self.cli.sendto(b'abcdefghij', (HOST, self.port))
+        bufs = [bytearray(10) for _ in range(3)]
+        received = []
+        while len(received) < 3:
+            received += self.serv.recvmmsg_into(bufs[len(received):])
+        self.assertEqual([n for n, addr in received], [4, 4, 2])
+        self.assertEqual([buf[:n] for buf, (n, addr) in zip(bufs, received)],
+                         [b'abcd', b'efgh', b'ij'])
+
+
 @unittest.skipUnless(HAVE_SOCKET_UDPLITE,
           'UDPLITE sockets required for this test.')
 class BasicUDPLITETest(ThreadedUDPLITESocketTest):
@@ -362,6 +362,37 @@ def test_unsafe_float_compare(self):
         check_against_PyObject_RichCompareBool(self, [float(x) for
                                                       x in range(100)])
 
+    def test_radix_sort(self):
+        # Large lists of small ints or floats are radix sorted.
+        n = 5000
+        random.seed(1)
+        lists = [
+            [random.randrange(-2**15, 2**15) for _ in range(n)],
+            [random.randrange(10) for _ in range(n)],
+            [random.uniform(-1e300, 1e300) for _ in range(n)],
+            [random.choice([0.0, -0.0, 1.5, -1.5, float('inf'),
+                            float('-inf'), 5e-324, -5e-324])
+             for _ in range(n)],
+            [float(x) for x in range(n)],
+        ]
+        for L in lists:
+            check_against_PyObject_RichCompareBool(self, L)
+            for reverse in False, True:
+                # Compare object identities, to check stability.
+                expected = [x for x, in sorted([(x,) for x in L],
+                                               reverse=reverse)]
+                for opt, ref in zip(sorted(L, reverse=reverse), expected):
+                    self.assertIs(opt, ref)
+                # Values sorted with a key function.
+                indices = sorted(range(n), key=L.__getitem__,
+                                 reverse=reverse)
+                for opt, ref in zip(indices, expected):
+                    self.assertIs(L[opt], ref)
+
+        # NaNs are not radix sorted.
+        L = [random.random() for _ in range(n)] + [float('nan')]
+        check_against_PyObject_RichCompareBool(self, L)
+
     def test_unsafe_tuple_compare(self):
         # This test was suggested by Tim Peters. It verifies that the tuple
         # comparison respects the current tuple compare semantics, which do not
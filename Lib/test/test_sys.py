@@ -269,6 +269,85 @@ def test_switchinterval(self):
         finally:
             sys.setswitchinterval(orig)
 
+    @threading_helper.requires_working_threading()
+    def test_gilpriority(self):
+        import threading
+        import time
+        self.assertRaises(TypeError, sys._setgilpriority)
+        orig = sys._getgilpriority()
+        self.assertIs(orig, False)
+        sys._setgilpriority(True)
+        self.addCleanup(sys._setgilpriority, orig)
+        self.assertIs(sys._getgilpriority(), True)
+
+        # A thread releasing the GIL around blocking calls competes with
+        # CPU-bound threads: everyone must keep making progress.
+        done = False
+        spins = [0, 0]
+        def spin(i):
+            while not done:
+                spins[i] += 1
+        def sleeper():
+            for _ in range(50):
+                time.sleep(0.0005)
+        with threading_helper.wait_threads_exit():
+            spinners = [threading.Thread(target=spin, args=(i,))
+                        for i in range(2)]
+            for t in spinners:
+                t.start()
+            t = threading.Thread(target=sleeper)
+            t.start()
+            t.join()
+            done = True
+            for t in spinners:
+                t.join()
+        self.assertGreater(spins[0], 0)
+        self.assertGreater(spins[1], 0)
+
+        sys._setgilpriority(False)
+        self.assertIs(sys._getgilpriority(), False)
+
+    @threading_helper.requires_working_threading()
+    def test_gilstats(self):
+        import threading
+        import time
+        self.assertRaises(TypeError, sys._setgilstats)
+        sys._setgilstats(True)
+        self.addCleanup(sys._setgilstats, False)
+        stats = sys._getgilstats()
+        self.assertIs(stats['enabled'], True)
+        self.assertEqual(stats['acquisitions'], 0)
+
+        def sleeper():
+            for _ in range(10):
+                time.sleep(0.0001)
+        t = threading.Thread(target=sleeper)
+        t.start()
+        t.join()
+        time.sleep(0.001)
+
+        stats = sys._getgilstats()
+        self.assertGreaterEqual(stats['acquisitions'], 10)
+        self.assertGreaterEqual(stats['drops']['release'], 10)
+        self.assertEqual(set(stats['drops']),
+                         {'release', 'interval', 'priority'})
+        self.assertLessEqual(stats['contended'], stats['acquisitions'])
+        self.assertEqual(sum(stats['wait_histogram']), stats['contended'])
+        self.assertEqual(len(stats['wait_histogram']),
+                         len(stats['hold_histogram']))
+        self.assertGreater(stats['hold_time'], 0.0)
+        self.assertGreaterEqual(stats['wait_time'], 0.0)
+        acquisitions, wait_time = stats['threads'][threading.get_ident()]
+        self.assertGreater(acquisitions, 0)
+        self.assertGreaterEqual(wait_time, 0.0)
+
+        sys._setgilstats(False)
+        before = sys._getgilstats()
+        time.sleep(0.001)
+        after = sys._getgilstats()
+        self.assertIs(after['enabled'], False)
+        self.assertEqual(after['acquisitions'], before['acquisitions'])
+
     def test_recursionlimit(self):
         self.assertRaises(TypeError, sys.getrecursionlimit, 42)
         oldlimit = sys.getrecursionlimit()
@@ -1507,7 +1586,7 @@ def delx(self): del self.__x
         check((1,2,3), vsize('') + 3*self.P)
         # type
         # static type: PyTypeObject
-        fmt = 'P2nPI13Pl4Pn9Pn12PIP'
+        fmt = 'P2nPI13Pl4Pn9Pn12PIPc'
         s = vsize('2P' + fmt)
         check(int, s)
         # class
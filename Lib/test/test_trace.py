@@ -187,8 +187,8 @@ def test_trace_list_comprehension(self):
         expected = {
             (self.my_py_filename, firstlineno_calling + 1): 1,
             # List comprehensions work differently in 3.x, so the count
-            # below changed compared to 2.x.
-            (self.my_py_filename, firstlineno_calling + 2): 12,
+            # below changed compared to 2.x.  They are inlined since 3.12.
+            (self.my_py_filename, firstlineno_calling + 2): 11,
             (self.my_py_filename, firstlineno_calling + 3): 1,
             (self.my_py_filename, firstlineno_called + 1): 10,
         }
@@ -1,4 +1,5 @@
 """ Tests for the internal type cache in CPython. """
+import sys
 import unittest
 from test import support
 from test.support import import_helper
@@ -10,6 +11,10 @@
 # Skip this test if the _testcapi module isn't available.
 type_get_version = import_helper.import_module('_testcapi').type_get_version
 
+# duplicating the C constants
+MCACHE_MAX_SIZE = 1 << 16
+MCACHE_ENTRIES_PER_TYPE = 1 << 3
+
 
 @support.cpython_only
 @unittest.skipIf(_clear_type_cache is None, "requires sys._clear_type_cache")
@@ -42,6 +47,53 @@ def test_tp_version_tag_unique(self):
         self.assertEqual(len(set(all_version_tags)), 30,
                          msg=f"{all_version_tags} contains non-unique versions")
 
+    @unittest.skipUnless(hasattr(sys, '_get_type_cache_stats'),
+                         "requires sys._get_type_cache_stats")
+    def test_cache_resized_with_versioned_types(self):
+        stats = sys._get_type_cache_stats()
+        self.assertEqual(set(stats), {'size', 'versioned_types', 'hits',
+                                      'misses', 'collisions', 'resizes'})
+        # Enough fresh types for the cache to grow from its current size,
+        # and to shrink back once they are gone despite the other types
+        # still alive.
+        n = max(stats['size'] // 4, 4 * stats['versioned_types']) + 1
+        classes = [type(f'C{i}', (), {'x': i}) for i in range(n)]
+        for cls in classes:
+            cls.x
+        after = sys._get_type_cache_stats()
+        self.assertGreaterEqual(after['versioned_types'],
+                                stats['versioned_types'] + n)
+        self.assertGreater(after['misses'], stats['misses'])
+        # Types left alive by other tests may have grown it to the maximum
+        if stats['size'] < MCACHE_MAX_SIZE:
+            self.assertGreater(after['size'], stats['size'])
+            self.assertGreater(after['resizes'], stats['resizes'])
+
+        hits = sys._get_type_cache_stats()['hits']
+        for cls in classes:
+            cls.x
+        self.assertGreaterEqual(sys._get_type_cache_stats()['hits'],
+                                hits + n)
+
+        # Modified types lose their version tag
+        for cls in classes[:n // 2]:
+            cls.y = 1
+        modified = sys._get_type_cache_stats()
+        self.assertLessEqual(modified['versioned_types'],
+                             after['versioned_types'] - n // 2)
+
+        # The cache shrinks when the types are gone, unless the types
+        # still alive keep it above a quarter full.
+        del cls, classes
+        support.gc_collect()
+        final = sys._get_type_cache_stats()
+        self.assertLessEqual(final['versioned_types'],
+                             after['versioned_types'] - n)
+        self.assertLessEqual(final['size'], after['size'])
+        if (4 * MCACHE_ENTRIES_PER_TYPE * final['versioned_types']
+                < after['size']):
+            self.assertLess(final['size'], after['size'])
+            self.assertGreater(final['resizes'], after['resizes'])
 
 if __name__ == "__main__":
     support.run_unittest(TypeCacheTests)
@@ -6,6 +6,7 @@
 #include "Python.h"
 #include "pycore_pyerrors.h"      // _PyErr_ClearExcState()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
+#include "structmember.h"         // PyMemberDef
 #include <stddef.h>               // offsetof()
 
 
@@ -34,6 +35,8 @@ static PyObject *asyncio_iscoroutine_func;
 static PyObject *asyncio_task_get_stack_func;
 static PyObject *asyncio_task_print_stack_func;
 static PyObject *asyncio_task_repr_func;
+static PyObject *asyncio_format_callback_source_func;
+static PyObject *asyncio_extract_stack_func;
 static PyObject *asyncio_InvalidStateError;
 static PyObject *asyncio_CancelledError;
 static PyObject *context_kwname;
@@ -45,9 +48,13 @@ static volatile uint64_t cached_running_holder_tsid;
 /* Counter for autogenerated Task names */
 static uint64_t task_name_counter = 0;
 
-/* WeakSet containing all alive tasks. */
+/* WeakSet containing all alive tasks that are not native tasks. */
 static PyObject *all_tasks;
 
+/* Set containing tasks that are being run eagerly and have not yet
+   suspended. */
+static PyObject *eager_tasks;
+
 /* Dictionary containing tasks that are currently active in
    all running event loops.  {EventLoop: Task} */
 static PyObject *current_tasks;
@@ -84,8 +91,15 @@ typedef struct {
     FutureObj_HEAD(fut)
 } FutureObj;
 
+/* Node of the intrusive list linking all alive native tasks. */
+struct task_node {
+    struct task_node *prev;
+    struct task_node *next;
+};
+
 typedef struct {
     FutureObj_HEAD(task)
+    struct task_node task_node;
     PyObject *task_fut_waiter;
     PyObject *task_coro;
     PyObject *task_name;
@@ -95,6 +109,12 @@ typedef struct {
     int task_num_cancels_requested;
 } TaskObj;
 
+/* Circular doubly linked list of all registered alive native tasks
+   (instances of Task and its subclasses).  The list holds borrowed
+   references: a task unlinks itself when it is deallocated, so unlike
+   a WeakSet this costs no allocation or method call per task. */
+static struct task_node native_tasks = {&native_tasks, &native_tasks};
+
 typedef struct {
     PyObject_HEAD
     TaskObj *sw_task;
@@ -109,10 +129,33 @@ typedef struct {
 #endif
 } PyRunningLoopHolder;
 
+#define HandleObj_HEAD(prefix)                                              \
+    PyObject_HEAD                                                           \
+    PyObject *prefix##_callback;                                            \
+    PyObject *prefix##_args;                                                \
+    PyObject *prefix##_loop;                                                \
+    PyObject *prefix##_context;                                             \
+    PyObject *prefix##_source_tb;                                           \
+    PyObject *prefix##_repr;                                                \
+    PyObject *prefix##_weakreflist;                                         \
+    char prefix##_cancelled;
+
+typedef struct {
+    HandleObj_HEAD(h)
+} HandleObj;
+
+typedef struct {
+    HandleObj_HEAD(th)
+    PyObject *th_when;
+    char th_scheduled;
+} TimerHandleObj;
+
 
 static PyTypeObject FutureType;
 static PyTypeObject TaskType;
 static PyTypeObject PyRunningLoopHolder_Type;
+static PyTypeObject HandleType;
+static PyTypeObject TimerHandleType;
 
 
 #define Future_CheckExact(obj) Py_IS_TYPE(obj, &FutureType)
@@ -121,6 +164,8 @@ static PyTypeObject PyRunningLoopHolder_Type;
 #define Future_Check(obj) PyObject_TypeCheck(obj, &FutureType)
 #define Task_Check(obj) PyObject_TypeCheck(obj, &TaskType)
 
+#define TimerHandle_Check(obj) PyObject_TypeCheck(obj, &TimerHandleType)
+
 #include "clinic/_asynciomodule.c.h"
 
 
@@ -1911,11 +1956,47 @@ static  PyMethodDef TaskWakeupDef = {
 
 /* ----- Task introspection helpers */
 
+#define TASK_FROM_NODE(node) \
+    ((TaskObj *)((char *)(node) - offsetof(TaskObj, task_node)))
+
+static void
+link_native_task(TaskObj *task)
+{
+    struct task_node *node = &task->task_node;
+    if (node->next != NULL) {
+        /* Already registered */
+        return;
+    }
+    node->prev = native_tasks.prev;
+    node->next = &native_tasks;
+    native_tasks.prev->next = node;
+    native_tasks.prev = node;
+}
+
+static void
+unlink_native_task(TaskObj *task)
+{
+    struct task_node *node = &task->task_node;
+    if (node->next == NULL) {
+        /* Not registered */
+        return;
+    }
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
+}
+
 static int
 register_task(PyObject *task)
 {
     _Py_IDENTIFIER(add);
 
+    if (Task_Check(task)) {
+        link_native_task((TaskObj *)task);
+        return 0;
+    }
+
     PyObject *res = _PyObject_CallMethodIdOneArg(all_tasks,
                                                  &PyId_add, task);
     if (res == NULL) {
@@ -1926,11 +2007,23 @@ register_task(PyObject *task)
 }
 
 
+static int
+register_eager_task(PyObject *task)
+{
+    return PySet_Add(eager_tasks, task);
+}
+
+
 static int
 unregister_task(PyObject *task)
 {
     _Py_IDENTIFIER(discard);
 
+    if (Task_Check(task)) {
+        unlink_native_task((TaskObj *)task);
+        return 0;
+    }
+
     PyObject *res = _PyObject_CallMethodIdOneArg(all_tasks,
                                                  &PyId_discard, task);
     if (res == NULL) {
@@ -1941,6 +2034,16 @@ unregister_task(PyObject *task)
 }
 
 
+static int
+unregister_eager_task(PyObject *task)
+{
+    if (PySet_Discard(eager_tasks, task) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+
 static int
 enter_task(PyObject *loop, PyObject *task)
 {
@@ -1993,8 +2096,50 @@ leave_task(PyObject *loop, PyObject *task)
     return _PyDict_DelItem_KnownHash(current_tasks, loop, hash);
 }
 
+
+/* Make 'task' the current task of 'loop' (or clear it if 'task' is
+   None) and return a new reference to the previous one, or None. */
+static PyObject *
+swap_current_task(PyObject *loop, PyObject *task)
+{
+    PyObject *prev_task;
+    Py_hash_t hash;
+    hash = PyObject_Hash(loop);
+    if (hash == -1) {
+        return NULL;
+    }
+
+    prev_task = _PyDict_GetItem_KnownHash(current_tasks, loop, hash);
+    if (prev_task == NULL) {
+        if (PyErr_Occurred()) {
+            return NULL;
+        }
+        prev_task = Py_None;
+    }
+    Py_INCREF(prev_task);
+
+    if (task == Py_None) {
+        if (_PyDict_DelItem_KnownHash(current_tasks, loop, hash) == -1) {
+            goto error;
+        }
+    }
+    else {
+        if (_PyDict_SetItem_KnownHash(current_tasks, loop, task, hash) == -1) {
+            goto error;
+        }
+    }
+
+    return prev_task;
+
+error:
+    Py_DECREF(prev_task);
+    return NULL;
+}
+
 /* ----- Task */
 
+static int task_eager_start(TaskObj *task);
+
 /*[clinic input]
 _asyncio.Task.__init__
 
@@ -2003,14 +2148,16 @@ _asyncio.Task.__init__
     loop: object = None
     name: object = None
     context: object = None
+    eager_start: bool = False
 
 A coroutine wrapped in a Future.
 [clinic start generated code]*/
 
 static int
 _asyncio_Task___init___impl(TaskObj *self, PyObject *coro, PyObject *loop,
-                            PyObject *name, PyObject *context)
-/*[clinic end generated code: output=49ac96fe33d0e5c7 input=924522490c8ce825]*/
+                            PyObject *name, PyObject *context,
+                            int eager_start)
+/*[clinic end generated code: output=7aced2d27836f1a1 input=18e3f113a51b829d]*/
 
 {
     if (future_init((FutureObj*)self, loop)) {
@@ -2057,6 +2204,23 @@ _asyncio_Task___init___impl(TaskObj *self, PyObject *coro, PyObject *loop,
         return -1;
     }
 
+    if (eager_start) {
+        _Py_IDENTIFIER(is_running);
+        PyObject *res = _PyObject_CallMethodIdNoArgs(self->task_loop,
+                                                     &PyId_is_running);
+        if (res == NULL) {
+            return -1;
+        }
+        int is_true = PyObject_IsTrue(res);
+        Py_DECREF(res);
+        if (is_true < 0) {
+            return -1;
+        }
+        if (is_true) {
+            return task_eager_start(self);
+        }
+    }
+
     if (task_call_step_soon(self, NULL)) {
         return -1;
     }
@@ -2391,8 +2555,11 @@ static PyObject *
 _asyncio_Task_get_coro_impl(TaskObj *self)
 /*[clinic end generated code: output=bcac27c8cc6c8073 input=d2e8606c42a7b403]*/
 {
-    Py_INCREF(self->task_coro);
-    return self->task_coro;
+    if (self->task_coro) {
+        return Py_NewRef(self->task_coro);
+    }
+
+    Py_RETURN_NONE;
 }
 
 /*[clinic input]
@@ -2575,6 +2742,8 @@ TaskObj_dealloc(PyObject *self)
 
     PyObject_GC_UnTrack(self);
 
+    unlink_native_task(task);
+
     if (task->task_weakreflist != NULL) {
         PyObject_ClearWeakRefs(self);
     }
@@ -3020,6 +3189,80 @@ task_step(TaskObj *task, PyObject *exc)
     }
 }
 
+static int
+task_eager_start(TaskObj *task)
+{
+    PyObject *prevtask = swap_current_task(task->task_loop, (PyObject *)task);
+    if (prevtask == NULL) {
+        return -1;
+    }
+
+    if (register_eager_task((PyObject *)task) == -1) {
+        Py_DECREF(prevtask);
+        return -1;
+    }
+
+    if (PyContext_Enter(task->task_context) == -1) {
+        Py_DECREF(prevtask);
+        return -1;
+    }
+
+    int retval = 0;
+
+    PyObject *stepres = task_step_impl(task, NULL);
+    if (stepres == NULL) {
+        retval = -1;
+    }
+    else {
+        Py_DECREF(stepres);
+    }
+
+    /* Keep the step's exception (if any) while restoring the previous
+       state, chaining any error raised by the cleanup onto it. */
+    PyObject *et, *ev, *tb;
+    PyErr_Fetch(&et, &ev, &tb);
+
+    PyObject *curtask = swap_current_task(task->task_loop, prevtask);
+    Py_DECREF(prevtask);
+    if (curtask == NULL) {
+        _PyErr_ChainExceptions(et, ev, tb);
+        PyErr_Fetch(&et, &ev, &tb);
+        retval = -1;
+    }
+    else {
+        assert(curtask == (PyObject *)task);
+        Py_DECREF(curtask);
+    }
+
+    if (unregister_eager_task((PyObject *)task) == -1) {
+        _PyErr_ChainExceptions(et, ev, tb);
+        PyErr_Fetch(&et, &ev, &tb);
+        retval = -1;
+    }
+
+    if (PyContext_Exit(task->task_context) == -1) {
+        _PyErr_ChainExceptions(et, ev, tb);
+        PyErr_Fetch(&et, &ev, &tb);
+        retval = -1;
+    }
+
+    if (task->task_state == STATE_PENDING) {
+        /* The coroutine blocked: it is now an ordinary scheduled task. */
+        if (register_task((PyObject *)task) == -1) {
+            _PyErr_ChainExceptions(et, ev, tb);
+            PyErr_Fetch(&et, &ev, &tb);
+            retval = -1;
+        }
+    }
+    else {
+        /* The coroutine finished synchronously; drop it right away. */
+        Py_CLEAR(task->task_coro);
+    }
+
+    PyErr_Restore(et, ev, tb);
+    return retval;
+}
+
 static PyObject *
 task_wakeup(TaskObj *task, PyObject *o)
 {
@@ -3218,6 +3461,48 @@ _asyncio__unregister_task_impl(PyObject *module, PyObject *task)
 }
 
 
+/*[clinic input]
+_asyncio._register_eager_task
+
+    task: object
+
+Register a new task that is being run eagerly.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__register_eager_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=dfe1d45367c73f1a input=786de155d79812cd]*/
+{
+    if (register_eager_task(task) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+
+/*[clinic input]
+_asyncio._unregister_eager_task
+
+    task: object
+
+Unregister a task that was being run eagerly.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__unregister_eager_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=a426922bd07f23d1 input=1c19b733d8e8bc2a]*/
+{
+    if (unregister_eager_task(task) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+
 /*[clinic input]
 _asyncio._enter_task
 
@@ -3266,88 +3551,958 @@ _asyncio__leave_task_impl(PyObject *module, PyObject *loop, PyObject *task)
 }
 
 
-/*********************** PyRunningLoopHolder ********************/
+/*[clinic input]
+_asyncio._swap_current_task
 
+    loop: object
+    task: object
 
-static PyRunningLoopHolder *
-new_running_loop_holder(PyObject *loop)
-{
-    PyRunningLoopHolder *rl = PyObject_New(
-        PyRunningLoopHolder, &PyRunningLoopHolder_Type);
-    if (rl == NULL) {
-        return NULL;
-    }
+Temporarily swap in the supplied task and return the original one (or None).
 
-#if defined(HAVE_GETPID) && !defined(MS_WINDOWS)
-    rl->rl_pid = getpid();
-#endif
+This is intended for use during eager coroutine execution.
 
-    Py_INCREF(loop);
-    rl->rl_loop = loop;
+[clinic start generated code]*/
 
-    return rl;
+static PyObject *
+_asyncio__swap_current_task_impl(PyObject *module, PyObject *loop,
+                                 PyObject *task)
+/*[clinic end generated code: output=9f88de958df74c7e input=c9c72208d3d38b6c]*/
+{
+    return swap_current_task(loop, task);
 }
 
 
-static void
-PyRunningLoopHolder_tp_dealloc(PyRunningLoopHolder *rl)
+/* Add the not yet finished tasks of 'loop' found in the 'tasks' list to
+   the 'result' set.  The list holds strong references, so calling into
+   Python code here is safe. */
+static int
+add_tasks_for_loop(PyObject *result, PyObject *tasks, PyObject *loop)
 {
-    if (cached_running_holder == (PyObject *)rl) {
-        cached_running_holder = NULL;
+    _Py_IDENTIFIER(done);
+
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(tasks); i++) {
+        PyObject *task = PyList_GET_ITEM(tasks, i);
+        int match;
+        if (Task_CheckExact(task)) {
+            TaskObj *t = (TaskObj *)task;
+            match = t->task_loop == loop && t->task_state == STATE_PENDING;
+        }
+        else {
+            PyObject *task_loop = get_future_loop(task);
+            if (task_loop == NULL) {
+                return -1;
+            }
+            Py_DECREF(task_loop);
+            if (task_loop != loop) {
+                continue;
+            }
+            PyObject *res = _PyObject_CallMethodIdNoArgs(task, &PyId_done);
+            if (res == NULL) {
+                return -1;
+            }
+            int is_done = PyObject_IsTrue(res);
+            Py_DECREF(res);
+            if (is_done < 0) {
+                return -1;
+            }
+            match = !is_done;
+        }
+        if (match && PySet_Add(result, task) < 0) {
+            return -1;
+        }
     }
-    Py_CLEAR(rl->rl_loop);
-    PyObject_Free(rl);
+    return 0;
 }
 
+/* Return a list of strong references to the registered native tasks. */
+static PyObject *
+native_tasks_list(void)
+{
+    /* Count first and fill the list without allocating in between: an
+       allocation may run the GC, which may deallocate (and so unlink)
+       tasks while the list is being walked. */
+    Py_ssize_t n = 0;
+    for (struct task_node *node = native_tasks.next;
+         node != &native_tasks; node = node->next) {
+        n++;
+    }
 
-static PyTypeObject PyRunningLoopHolder_Type = {
-    PyVarObject_HEAD_INIT(NULL, 0)
-    "_RunningLoopHolder",
-    sizeof(PyRunningLoopHolder),
-    .tp_getattro = PyObject_GenericGetAttr,
-    .tp_flags = Py_TPFLAGS_DEFAULT,
-    .tp_dealloc = (destructor)PyRunningLoopHolder_tp_dealloc,
-};
+    PyObject *tasks = PyList_New(n);
+    if (tasks == NULL) {
+        return NULL;
+    }
 
+    Py_ssize_t i = 0;
+    for (struct task_node *node = native_tasks.next;
+         node != &native_tasks && i < n; node = node->next) {
+        PyObject *task = (PyObject *)TASK_FROM_NODE(node);
+        /* Skip tasks that are being finalized by their deallocation or by
+           the GC: they must not be handed out anymore. */
+        if (PyObject_GC_IsFinalized(task)) {
+            continue;
+        }
+        PyList_SET_ITEM(tasks, i++, Py_NewRef(task));
+    }
+    /* Drop the unused trailing slots; they are still NULL. */
+    Py_SET_SIZE(tasks, i);
+    return tasks;
+}
 
-/*********************** Module **************************/
+/*[clinic input]
+_asyncio.all_tasks
 
+    loop: object = None
 
-static void
-module_free_freelists(void)
+Return a set of all tasks for the loop.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_all_tasks_impl(PyObject *module, PyObject *loop)
+/*[clinic end generated code: output=0e107cbb7f72aa7b input=0d707a88622509a6]*/
 {
-    PyObject *next;
-    PyObject *current;
+    PyObject *result = NULL;
+    PyObject *tasks = NULL;
 
-    next = (PyObject*) fi_freelist;
-    while (next != NULL) {
-        assert(fi_freelist_len > 0);
-        fi_freelist_len--;
+    if (loop == Py_None) {
+        if (get_running_loop(&loop)) {
+            return NULL;
+        }
+        if (loop == NULL) {
+            PyErr_SetString(PyExc_RuntimeError, "no running event loop");
+            return NULL;
+        }
+    }
+    else {
+        Py_INCREF(loop);
+    }
 
-        current = next;
-        next = (PyObject*) ((futureiterobject*) current)->future;
-        PyObject_GC_Del(current);
+    result = PySet_New(NULL);
+    if (result == NULL) {
+        goto error;
     }
-    assert(fi_freelist_len == 0);
-    fi_freelist = NULL;
-}
 
+    /* Capture the eager tasks first: an eager task that blocks is
+       registered as a regular task afterwards, so taking the snapshots
+       in this order can't miss it. */
+    tasks = PySequence_List(eager_tasks);
+    if (tasks == NULL || add_tasks_for_loop(result, tasks, loop) < 0) {
+        goto error;
+    }
+    Py_CLEAR(tasks);
 
-static void
-module_free(void *m)
-{
-    Py_CLEAR(asyncio_mod);
-    Py_CLEAR(traceback_extract_stack);
-    Py_CLEAR(asyncio_future_repr_func);
-    Py_CLEAR(asyncio_get_event_loop_policy);
-    Py_CLEAR(asyncio_iscoroutine_func);
-    Py_CLEAR(asyncio_task_get_stack_func);
-    Py_CLEAR(asyncio_task_print_stack_func);
-    Py_CLEAR(asyncio_task_repr_func);
-    Py_CLEAR(asyncio_InvalidStateError);
+    tasks = native_tasks_list();
+    if (tasks == NULL || add_tasks_for_loop(result, tasks, loop) < 0) {
+        goto error;
+    }
+    Py_CLEAR(tasks);
+
+    /* Looping over the WeakSet isn't safe as it can be updated from
+       another thread while we do so. Therefore we cast it to list prior
+       to filtering, retrying on RuntimeError like the Python version. */
+    for (int i = 0; ; i++) {
+        tasks = PySequence_List(all_tasks);
+        if (tasks != NULL) {
+            break;
+        }
+        if (i >= 1000 || !PyErr_ExceptionMatches(PyExc_RuntimeError)) {
+            goto error;
+        }
+        PyErr_Clear();
+    }
+    if (add_tasks_for_loop(result, tasks, loop) < 0) {
+        goto error;
+    }
+
+    Py_DECREF(tasks);
+    Py_DECREF(loop);
+    return result;
+
+error:
+    Py_XDECREF(tasks);
+    Py_XDECREF(result);
+    Py_DECREF(loop);
+    return NULL;
+}
+
+
+/*********************** Handle ********************/
+
+/*[clinic input]
+class _asyncio.Handle "HandleObj *" "&HandleType"
+class _asyncio.TimerHandle "TimerHandleObj *" "&TimerHandleType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=6d21dd13050cb891]*/
+
+
+static int
+handle_init(HandleObj *h, PyObject *callback, PyObject *args, PyObject *loop,
+            PyObject *context)
+{
+    _Py_IDENTIFIER(get_debug);
+
+    if (context == Py_None) {
+        context = PyContext_CopyCurrent();
+        if (context == NULL) {
+            return -1;
+        }
+    }
+    else {
+        Py_INCREF(context);
+    }
+    Py_XSETREF(h->h_context, context);
+    Py_INCREF(loop);
+    Py_XSETREF(h->h_loop, loop);
+    Py_INCREF(callback);
+    Py_XSETREF(h->h_callback, callback);
+    Py_INCREF(args);
+    Py_XSETREF(h->h_args, args);
+    h->h_cancelled = 0;
+    Py_CLEAR(h->h_repr);
+    Py_CLEAR(h->h_source_tb);
+
+    PyObject *res = _PyObject_CallMethodIdNoArgs(loop, &PyId_get_debug);
+    if (res == NULL) {
+        return -1;
+    }
+    int is_true = PyObject_IsTrue(res);
+    Py_DECREF(res);
+    if (is_true < 0) {
+        return -1;
+    }
+    if (is_true && !_Py_IsFinalizing()) {
+        /* There is no Python frame for __init__ here: the current frame
+           already is the one that created the handle. */
+        PyObject *frame = (PyObject *)PyEval_GetFrame();
+        if (frame == NULL) {
+            frame = Py_None;
+        }
+        h->h_source_tb = PyObject_CallOneArg(asyncio_extract_stack_func,
+                                             frame);
+        if (h->h_source_tb == NULL) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*[clinic input]
+_asyncio.Handle.__init__
+
+    callback: object
+    args: object
+    loop: object
+    context: object = None
+
+Object returned by callback registration methods.
+[clinic start generated code]*/
+
+static int
+_asyncio_Handle___init___impl(HandleObj *self, PyObject *callback,
+                              PyObject *args, PyObject *loop,
+                              PyObject *context)
+/*[clinic end generated code: output=40a28e55725495e2 input=c0d847a7bc9e878f]*/
+{
+    return handle_init(self, callback, args, loop, context);
+}
+
+static int
+HandleObj_clear(HandleObj *h)
+{
+    Py_CLEAR(h->h_callback);
+    Py_CLEAR(h->h_args);
+    Py_CLEAR(h->h_loop);
+    Py_CLEAR(h->h_context);
+    Py_CLEAR(h->h_source_tb);
+    Py_CLEAR(h->h_repr);
+    return 0;
+}
+
+static int
+HandleObj_traverse(HandleObj *h, visitproc visit, void *arg)
+{
+    Py_VISIT(h->h_callback);
+    Py_VISIT(h->h_args);
+    Py_VISIT(h->h_loop);
+    Py_VISIT(h->h_context);
+    Py_VISIT(h->h_source_tb);
+    Py_VISIT(h->h_repr);
+    return 0;
+}
+
+static void
+HandleObj_dealloc(HandleObj *h)
+{
+    PyObject_GC_UnTrack(h);
+    if (h->h_weakreflist != NULL) {
+        PyObject_ClearWeakRefs((PyObject *)h);
+    }
+    (void)HandleObj_clear(h);
+    if (TimerHandle_Check(h)) {
+        Py_CLEAR(((TimerHandleObj *)h)->th_when);
+    }
+    Py_TYPE(h)->tp_free(h);
+}
+
+static int
+handle_cancel(HandleObj *h)
+{
+    _Py_IDENTIFIER(get_debug);
+
+    if (h->h_cancelled) {
+        return 0;
+    }
+    h->h_cancelled = 1;
+
+    PyObject *res = _PyObject_CallMethodIdNoArgs(h->h_loop, &PyId_get_debug);
+    if (res == NULL) {
+        return -1;
+    }
+    int is_true = PyObject_IsTrue(res);
+    Py_DECREF(res);
+    if (is_true < 0) {
+        return -1;
+    }
+    if (is_true) {
+        /* Keep a representation in debug mode to keep callback and
+           parameters. For example, to log the warning
+           "Executing <Handle...> took 2.5 second" */
+        PyObject *repr = PyObject_Repr((PyObject *)h);
+        if (repr == NULL) {
+            return -1;
+        }
+        Py_XSETREF(h->h_repr, repr);
+    }
+    Py_CLEAR(h->h_callback);
+    Py_CLEAR(h->h_args);
+    return 0;
+}
+
+/*[clinic input]
+_asyncio.Handle.cancel
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_cancel_impl(HandleObj *self)
+/*[clinic end generated code: output=ddb39234782aab82 input=eaa3eb93236f622f]*/
+{
+    if (handle_cancel(self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.Handle.cancelled
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_cancelled_impl(HandleObj *self)
+/*[clinic end generated code: output=0f4ad57f569e9f24 input=14a55098bea1b40a]*/
+{
+    return PyBool_FromLong(self->h_cancelled);
+}
+
+static int
+handle_report_exception(HandleObj *h, PyObject *exc)
+{
+    _Py_IDENTIFIER(call_exception_handler);
+    _Py_IDENTIFIER(message);
+    _Py_IDENTIFIER(exception);
+    _Py_IDENTIFIER(handle);
+    _Py_IDENTIFIER(source_traceback);
+
+    PyObject *cb = NULL, *msg = NULL, *context = NULL, *res;
+    int ret = -1;
+
+    cb = PyObject_CallFunctionObjArgs(
+        asyncio_format_callback_source_func,
+        h->h_callback ? h->h_callback : Py_None,
+        h->h_args ? h->h_args : Py_None, NULL);
+    if (cb == NULL) {
+        goto finally;
+    }
+    msg = PyUnicode_FromFormat("Exception in callback %U", cb);
+    if (msg == NULL) {
+        goto finally;
+    }
+    context = PyDict_New();
+    if (context == NULL) {
+        goto finally;
+    }
+    if (_PyDict_SetItemId(context, &PyId_message, msg) < 0 ||
+        _PyDict_SetItemId(context, &PyId_exception, exc) < 0 ||
+        _PyDict_SetItemId(context, &PyId_handle, (PyObject *)h) < 0) {
+        goto finally;
+    }
+    if (h->h_source_tb != NULL) {
+        int is_true = PyObject_IsTrue(h->h_source_tb);
+        if (is_true < 0) {
+            goto finally;
+        }
+        if (is_true &&
+            _PyDict_SetItemId(context, &PyId_source_traceback,
+                              h->h_source_tb) < 0) {
+            goto finally;
+        }
+    }
+
+    res = _PyObject_CallMethodIdOneArg(h->h_loop, &PyId_call_exception_handler,
+                                       context);
+    if (res == NULL) {
+        goto finally;
+    }
+    Py_DECREF(res);
+    ret = 0;
+
+finally:
+    Py_XDECREF(cb);
+    Py_XDECREF(msg);
+    Py_XDECREF(context);
+    return ret;
+}
+
+static int
+handle_run(HandleObj *h)
+{
+    _Py_IDENTIFIER(run);
+
+    PyObject *res = NULL;
+    /* The callback may cancel the handle while it runs, which clears
+       the fields: hold our own references. */
+    PyObject *callback = h->h_callback ? h->h_callback : Py_None;
+    PyObject *context = h->h_context ? h->h_context : Py_None;
+    PyObject *args;
+    Py_INCREF(callback);
+    Py_INCREF(context);
+
+    if (h->h_args != NULL && PyTuple_CheckExact(h->h_args)) {
+        args = Py_NewRef(h->h_args);
+    }
+    else {
+        args = PySequence_Tuple(h->h_args ? h->h_args : Py_None);
+    }
+
+    if (args == NULL) {
+        /* Reported like an exception raised by the callback. */
+    }
+    else if (PyContext_CheckExact(context)) {
+        if (PyContext_Enter(context) == 0) {
+            res = PyObject_Call(callback, args, NULL);
+            if (PyContext_Exit(context) < 0) {
+                Py_CLEAR(res);
+            }
+        }
+    }
+    else {
+        PyObject *run = _PyObject_GetAttrId(context, &PyId_run);
+        if (run != NULL) {
+            PyObject *run_args = PyTuple_New(PyTuple_GET_SIZE(args) + 1);
+            if (run_args != NULL) {
+                PyTuple_SET_ITEM(run_args, 0, Py_NewRef(callback));
+                for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(args); i++) {
+                    PyTuple_SET_ITEM(run_args, i + 1,
+                                     Py_NewRef(PyTuple_GET_ITEM(args, i)));
+                }
+                res = PyObject_Call(run, run_args, NULL);
+                Py_DECREF(run_args);
+            }
+            Py_DECREF(run);
+        }
+    }
+
+    Py_DECREF(callback);
+    Py_DECREF(context);
+    Py_XDECREF(args);
+
+    if (res != NULL) {
+        Py_DECREF(res);
+        return 0;
+    }
+
+    if (PyErr_ExceptionMatches(PyExc_SystemExit) ||
+        PyErr_ExceptionMatches(PyExc_KeyboardInterrupt)) {
+        return -1;
+    }
+
+    PyObject *et, *ev, *tb;
+    PyErr_Fetch(&et, &ev, &tb);
+    PyErr_NormalizeException(&et, &ev, &tb);
+    if (tb != NULL) {
+        PyException_SetTraceback(ev, tb);
+    }
+    int ret = handle_report_exception(h, ev);
+    Py_XDECREF(et);
+    Py_XDECREF(ev);
+    Py_XDECREF(tb);
+    return ret;
+}
+
+/*[clinic input]
+_asyncio.Handle._run
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle__run_impl(HandleObj *self)
+/*[clinic end generated code: output=1b186b710881500a input=94fc71ae0ddc7106]*/
+{
+    if (handle_run(self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+handle_repr_info(HandleObj *h, PyObject *when)
+{
+    PyObject *info = PyList_New(0);
+    if (info == NULL) {
+        return NULL;
+    }
+
+    PyObject *item = PyUnicode_FromString(_PyType_Name(Py_TYPE(h)));
+    if (item == NULL || PyList_Append(info, item) < 0) {
+        goto error;
+    }
+    Py_DECREF(item);
+
+    if (h->h_cancelled) {
+        item = PyUnicode_FromString("cancelled");
+        if (item == NULL || PyList_Append(info, item) < 0) {
+            goto error;
+        }
+        Py_DECREF(item);
+    }
+    if (when != NULL) {
+        item = PyUnicode_FromFormat("when=%S", when);
+        if (item == NULL || PyList_Append(info, item) < 0) {
+            goto error;
+        }
+        Py_DECREF(item);
+    }
+    if (h->h_callback != NULL && h->h_callback != Py_None) {
+        item = PyObject_CallFunctionObjArgs(
+            asyncio_format_callback_source_func,
+            h->h_callback, h->h_args ? h->h_args : Py_None, NULL);
+        if (item == NULL || PyList_Append(info, item) < 0) {
+            goto error;
+        }
+        Py_DECREF(item);
+    }
+    if (h->h_source_tb != NULL) {
+        int is_true = PyObject_IsTrue(h->h_source_tb);
+        if (is_true < 0) {
+            goto fail;
+        }
+        if (is_true) {
+            PyObject *frame = PySequence_GetItem(h->h_source_tb, -1);
+            if (frame == NULL) {
+                goto fail;
+            }
+            PyObject *filename = PySequence_GetItem(frame, 0);
+            PyObject *lineno = filename ? PySequence_GetItem(frame, 1) : NULL;
+            Py_DECREF(frame);
+            if (lineno == NULL) {
+                Py_XDECREF(filename);
+                goto fail;
+            }
+            item = PyUnicode_FromFormat("created at %S:%S", filename, lineno);
+            Py_DECREF(filename);
+            Py_DECREF(lineno);
+            if (item == NULL || PyList_Append(info, item) < 0) {
+                goto error;
+            }
+            Py_DECREF(item);
+        }
+    }
+    return info;
+
+error:
+    Py_XDECREF(item);
+fail:
+    Py_DECREF(info);
+    return NULL;
+}
+
+/*[clinic input]
+_asyncio.Handle._repr_info
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle__repr_info_impl(HandleObj *self)
+/*[clinic end generated code: output=7838b12075048d03 input=dba1c0a083077d57]*/
+{
+    return handle_repr_info(self, NULL);
+}
+
+static PyObject *
+HandleObj_repr(HandleObj *h)
+{
+    _Py_IDENTIFIER(_repr_info);
+
+    if (h->h_repr != NULL && h->h_repr != Py_None) {
+        return Py_NewRef(h->h_repr);
+    }
+
+    PyObject *info = _PyObject_CallMethodIdNoArgs((PyObject *)h,
+                                                  &PyId__repr_info);
+    if (info == NULL) {
+        return NULL;
+    }
+    PyObject *sep = PyUnicode_FromString(" ");
+    if (sep == NULL) {
+        Py_DECREF(info);
+        return NULL;
+    }
+    PyObject *joined = PyUnicode_Join(sep, info);
+    Py_DECREF(sep);
+    Py_DECREF(info);
+    if (joined == NULL) {
+        return NULL;
+    }
+    PyObject *repr = PyUnicode_FromFormat("<%U>", joined);
+    Py_DECREF(joined);
+    return repr;
+}
+
+#define HANDLE_COMMON_MEMBERS(prefix, type)                                   \
+    {"_callback", T_OBJECT, offsetof(type, prefix##_callback), 0},            \
+    {"_args", T_OBJECT, offsetof(type, prefix##_args), 0},                    \
+    {"_loop", T_OBJECT, offsetof(type, prefix##_loop), 0},                    \
+    {"_context", T_OBJECT, offsetof(type, prefix##_context), 0},              \
+    {"_source_traceback", T_OBJECT, offsetof(type, prefix##_source_tb), 0},   \
+    {"_repr", T_OBJECT, offsetof(type, prefix##_repr), 0},                    \
+    {"_cancelled", T_BOOL, offsetof(type, prefix##_cancelled), 0},
+
+static PyMemberDef HandleType_members[] = {
+    HANDLE_COMMON_MEMBERS(h, HandleObj)
+    {NULL} /* Sentinel */
+};
+
+static PyMethodDef HandleType_methods[] = {
+    _ASYNCIO_HANDLE_CANCEL_METHODDEF
+    _ASYNCIO_HANDLE_CANCELLED_METHODDEF
+    _ASYNCIO_HANDLE__RUN_METHODDEF
+    _ASYNCIO_HANDLE__REPR_INFO_METHODDEF
+    {NULL, NULL}        /* Sentinel */
+};
+
+static PyTypeObject HandleType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_asyncio.Handle",
+    sizeof(HandleObj),                       /* tp_basicsize */
+    .tp_dealloc = (destructor)HandleObj_dealloc,
+    .tp_repr = (reprfunc)HandleObj_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_BASETYPE,
+    .tp_doc = _asyncio_Handle___init____doc__,
+    .tp_traverse = (traverseproc)HandleObj_traverse,
+    .tp_clear = (inquiry)HandleObj_clear,
+    .tp_weaklistoffset = offsetof(HandleObj, h_weakreflist),
+    .tp_methods = HandleType_methods,
+    .tp_members = HandleType_members,
+    .tp_init = (initproc)_asyncio_Handle___init__,
+    .tp_new = PyType_GenericNew,
+};
+
+
+/*[clinic input]
+_asyncio.TimerHandle.__init__
+
+    when: object
+    callback: object
+    args: object
+    loop: object
+    context: object = None
+
+Object returned by timed callback registration methods.
+[clinic start generated code]*/
+
+static int
+_asyncio_TimerHandle___init___impl(TimerHandleObj *self, PyObject *when,
+                                   PyObject *callback, PyObject *args,
+                                   PyObject *loop, PyObject *context)
+/*[clinic end generated code: output=0d98475472bfab93 input=ec6d223ba9888cec]*/
+{
+    if (handle_init((HandleObj *)self, callback, args, loop, context) < 0) {
+        return -1;
+    }
+    Py_INCREF(when);
+    Py_XSETREF(self->th_when, when);
+    self->th_scheduled = 0;
+    return 0;
+}
+
+static int
+TimerHandleObj_traverse(TimerHandleObj *th, visitproc visit, void *arg)
+{
+    Py_VISIT(th->th_when);
+    return HandleObj_traverse((HandleObj *)th, visit, arg);
+}
+
+static int
+TimerHandleObj_clear(TimerHandleObj *th)
+{
+    Py_CLEAR(th->th_when);
+    return HandleObj_clear((HandleObj *)th);
+}
+
+static Py_hash_t
+TimerHandleObj_hash(TimerHandleObj *th)
+{
+    return PyObject_Hash(th->th_when ? th->th_when : Py_None);
+}
+
+/* Compare the deadlines of two timer handles; floats (the usual case,
+   as returned by loop.time()) are compared without a rich comparison. */
+static int
+timer_handle_when_cmp(TimerHandleObj *a, TimerHandleObj *b, int op)
+{
+    PyObject *wa = a->th_when ? a->th_when : Py_None;
+    PyObject *wb = b->th_when ? b->th_when : Py_None;
+    if (PyFloat_CheckExact(wa) && PyFloat_CheckExact(wb)) {
+        double x = PyFloat_AS_DOUBLE(wa);
+        double y = PyFloat_AS_DOUBLE(wb);
+        switch (op) {
+        case Py_LT: return x < y;
+        case Py_GT: return x > y;
+        case Py_EQ: return x == y;
+        default: Py_UNREACHABLE();
+        }
+    }
+    return PyObject_RichCompareBool(wa, wb, op);
+}
+
+static int
+timer_handle_eq(TimerHandleObj *a, TimerHandleObj *b)
+{
+    int r = timer_handle_when_cmp(a, b, Py_EQ);
+    if (r != 1) {
+        return r;
+    }
+    r = PyObject_RichCompareBool(a->th_callback ? a->th_callback : Py_None,
+                                 b->th_callback ? b->th_callback : Py_None,
+                                 Py_EQ);
+    if (r != 1) {
+        return r;
+    }
+    r = PyObject_RichCompareBool(a->th_args ? a->th_args : Py_None,
+                                 b->th_args ? b->th_args : Py_None,
+                                 Py_EQ);
+    if (r != 1) {
+        return r;
+    }
+    return a->th_cancelled == b->th_cancelled;
+}
+
+static PyObject *
+TimerHandleObj_richcompare(TimerHandleObj *self, PyObject *other, int op)
+{
+    if (!TimerHandle_Check(other)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    TimerHandleObj *o = (TimerHandleObj *)other;
+    int r;
+    switch (op) {
+    case Py_LT:
+    case Py_GT:
+        r = timer_handle_when_cmp(self, o, op);
+        break;
+    case Py_LE:
+    case Py_GE:
+        r = timer_handle_when_cmp(self, o, op == Py_LE ? Py_LT : Py_GT);
+        if (r == 0) {
+            r = timer_handle_eq(self, o);
+        }
+        break;
+    case Py_EQ:
+        r = timer_handle_eq(self, o);
+        break;
+    case Py_NE:
+        r = timer_handle_eq(self, o);
+        if (r >= 0) {
+            r = !r;
+        }
+        break;
+    default:
+        Py_UNREACHABLE();
+    }
+    if (r < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(r);
+}
+
+/*[clinic input]
+_asyncio.TimerHandle.cancel
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle_cancel_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=315df6426e6662ff input=529996fd507bb125]*/
+{
+    _Py_IDENTIFIER(_timer_handle_cancelled);
+
+    if (!self->th_cancelled) {
+        PyObject *res = _PyObject_CallMethodIdOneArg(
+            self->th_loop, &PyId__timer_handle_cancelled, (PyObject *)self);
+        if (res == NULL) {
+            return NULL;
+        }
+        Py_DECREF(res);
+    }
+    if (handle_cancel((HandleObj *)self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.TimerHandle.when
+
+Return a scheduled callback time.
+
+The time is an absolute timestamp, using the same time
+reference as loop.time().
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle_when_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=cab0e5577e51b3af input=de801fd191075931]*/
+{
+    return Py_NewRef(self->th_when ? self->th_when : Py_None);
+}
+
+/*[clinic input]
+_asyncio.TimerHandle._repr_info
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle__repr_info_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=40e332eea82788b7 input=0ea1c37005c8bd50]*/
+{
+    return handle_repr_info((HandleObj *)self,
+                            self->th_when ? self->th_when : Py_None);
+}
+
+static PyMemberDef TimerHandleType_members[] = {
+    HANDLE_COMMON_MEMBERS(th, TimerHandleObj)
+    {"_when", T_OBJECT, offsetof(TimerHandleObj, th_when), 0},
+    {"_scheduled", T_BOOL, offsetof(TimerHandleObj, th_scheduled), 0},
+    {NULL} /* Sentinel */
+};
+
+static PyMethodDef TimerHandleType_methods[] = {
+    _ASYNCIO_TIMERHANDLE_CANCEL_METHODDEF
+    _ASYNCIO_TIMERHANDLE_WHEN_METHODDEF
+    _ASYNCIO_TIMERHANDLE__REPR_INFO_METHODDEF
+    {NULL, NULL}        /* Sentinel */
+};
+
+static PyTypeObject TimerHandleType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_asyncio.TimerHandle",
+    sizeof(TimerHandleObj),                  /* tp_basicsize */
+    .tp_base = &HandleType,
+    .tp_dealloc = (destructor)HandleObj_dealloc,
+    .tp_repr = (reprfunc)HandleObj_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_BASETYPE,
+    .tp_doc = _asyncio_TimerHandle___init____doc__,
+    .tp_traverse = (traverseproc)TimerHandleObj_traverse,
+    .tp_clear = (inquiry)TimerHandleObj_clear,
+    .tp_hash = (hashfunc)TimerHandleObj_hash,
+    .tp_richcompare = (richcmpfunc)TimerHandleObj_richcompare,
+    .tp_weaklistoffset = offsetof(TimerHandleObj, th_weakreflist),
+    .tp_methods = TimerHandleType_methods,
+    .tp_members = TimerHandleType_members,
+    .tp_init = (initproc)_asyncio_TimerHandle___init__,
+    .tp_new = PyType_GenericNew,
+};
+
+
+/*********************** PyRunningLoopHolder ********************/
+
+
+static PyRunningLoopHolder *
+new_running_loop_holder(PyObject *loop)
+{
+    PyRunningLoopHolder *rl = PyObject_New(
+        PyRunningLoopHolder, &PyRunningLoopHolder_Type);
+    if (rl == NULL) {
+        return NULL;
+    }
+
+#if defined(HAVE_GETPID) && !defined(MS_WINDOWS)
+    rl->rl_pid = getpid();
+#endif
+
+    Py_INCREF(loop);
+    rl->rl_loop = loop;
+
+    return rl;
+}
+
+
+static void
+PyRunningLoopHolder_tp_dealloc(PyRunningLoopHolder *rl)
+{
+    if (cached_running_holder == (PyObject *)rl) {
+        cached_running_holder = NULL;
+    }
+    Py_CLEAR(rl->rl_loop);
+    PyObject_Free(rl);
+}
+
+
+static PyTypeObject PyRunningLoopHolder_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "_RunningLoopHolder",
+    sizeof(PyRunningLoopHolder),
+    .tp_getattro = PyObject_GenericGetAttr,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = (destructor)PyRunningLoopHolder_tp_dealloc,
+};
+
+
+/*********************** Module **************************/
+
+
+static void
+module_free_freelists(void)
+{
+    PyObject *next;
+    PyObject *current;
+
+    next = (PyObject*) fi_freelist;
+    while (next != NULL) {
+        assert(fi_freelist_len > 0);
+        fi_freelist_len--;
+
+        current = next;
+        next = (PyObject*) ((futureiterobject*) current)->future;
+        PyObject_GC_Del(current);
+    }
+    assert(fi_freelist_len == 0);
+    fi_freelist = NULL;
+}
+
+
+static void
+module_free(void *m)
+{
+    Py_CLEAR(asyncio_mod);
+    Py_CLEAR(traceback_extract_stack);
+    Py_CLEAR(asyncio_future_repr_func);
+    Py_CLEAR(asyncio_get_event_loop_policy);
+    Py_CLEAR(asyncio_iscoroutine_func);
+    Py_CLEAR(asyncio_task_get_stack_func);
+    Py_CLEAR(asyncio_task_print_stack_func);
+    Py_CLEAR(asyncio_task_repr_func);
+    Py_CLEAR(asyncio_format_callback_source_func);
+    Py_CLEAR(asyncio_extract_stack_func);
+    Py_CLEAR(asyncio_InvalidStateError);
     Py_CLEAR(asyncio_CancelledError);
 
     Py_CLEAR(all_tasks);
+    Py_CLEAR(eager_tasks);
     Py_CLEAR(current_tasks);
     Py_CLEAR(iscoroutine_typecache);
 
@@ -3376,6 +4531,11 @@ module_init(void)
         goto fail;
     }
 
+    eager_tasks = PySet_New(NULL);
+    if (eager_tasks == NULL) {
+        goto fail;
+    }
+
     iscoroutine_typecache = PySet_New(NULL);
     if (iscoroutine_typecache == NULL) {
         goto fail;
@@ -3418,6 +4578,10 @@ module_init(void)
     WITH_MOD("asyncio.coroutines")
     GET_MOD_ATTR(asyncio_iscoroutine_func, "iscoroutine")
 
+    WITH_MOD("asyncio.format_helpers")
+    GET_MOD_ATTR(asyncio_format_callback_source_func, "_format_callback_source")
+    GET_MOD_ATTR(asyncio_extract_stack_func, "extract_stack")
+
     WITH_MOD("traceback")
     GET_MOD_ATTR(traceback_extract_stack, "extract_stack")
 
@@ -3452,9 +4616,13 @@ static PyMethodDef asyncio_methods[] = {
     _ASYNCIO__GET_RUNNING_LOOP_METHODDEF
     _ASYNCIO__SET_RUNNING_LOOP_METHODDEF
     _ASYNCIO__REGISTER_TASK_METHODDEF
+    _ASYNCIO__REGISTER_EAGER_TASK_METHODDEF
     _ASYNCIO__UNREGISTER_TASK_METHODDEF
+    _ASYNCIO__UNREGISTER_EAGER_TASK_METHODDEF
     _ASYNCIO__ENTER_TASK_METHODDEF
     _ASYNCIO__LEAVE_TASK_METHODDEF
+    _ASYNCIO__SWAP_CURRENT_TASK_METHODDEF
+    _ASYNCIO_ALL_TASKS_METHODDEF
     {NULL, NULL}
 };
 
@@ -3503,6 +4671,17 @@ PyInit__asyncio(void)
         return NULL;
     }
 
+    /* HandleType and TimerHandleType are made ready by the calls below. */
+    if (PyModule_AddType(m, &HandleType) < 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+
+    if (PyModule_AddType(m, &TimerHandleType) < 0) {
+        Py_DECREF(m);
+        return NULL;
+    }
+
     Py_INCREF(all_tasks);
     if (PyModule_AddObject(m, "_all_tasks", all_tasks) < 0) {
         Py_DECREF(all_tasks);
@@ -3510,6 +4689,13 @@ PyInit__asyncio(void)
         return NULL;
     }
 
+    Py_INCREF(eager_tasks);
+    if (PyModule_AddObject(m, "_eager_tasks", eager_tasks) < 0) {
+        Py_DECREF(eager_tasks);
+        Py_DECREF(m);
+        return NULL;
+    }
+
     Py_INCREF(current_tasks);
     if (PyModule_AddObject(m, "_current_tasks", current_tasks) < 0) {
         Py_DECREF(current_tasks);
@@ -0,0 +1,1313 @@
+/* C accelerator for concurrent.futures: Future and the ThreadPoolExecutor
+   work item. */
+
+#ifndef Py_BUILD_CORE_BUILTIN
+#  define Py_BUILD_CORE_MODULE 1
+#endif
+
+#include "Python.h"
+#include "pycore_moduleobject.h"  // _PyModule_GetState()
+#include "structmember.h"         // PyMemberDef
+#include <stddef.h>               // offsetof()
+
+/* The states of a future, in the order of concurrent.futures._base */
+typedef enum {
+    FUT_PENDING,
+    FUT_RUNNING,
+    FUT_CANCELLED,
+    FUT_CANCELLED_AND_NOTIFIED,
+    FUT_FINISHED,
+    FUT_NSTATES
+} fut_state;
+
+static const char * const fut_state_names[FUT_NSTATES] = {
+    "PENDING",
+    "RUNNING",
+    "CANCELLED",
+    "CANCELLED_AND_NOTIFIED",
+    "FINISHED",
+};
+
+/* As _STATE_TO_DESCRIPTION_MAP, for repr() */
+static const char * const fut_state_descriptions[FUT_NSTATES] = {
+    "pending",
+    "running",
+    "cancelled",
+    "cancelled",
+    "finished",
+};
+
+#define FUT_IS_CANCELLED(state) \
+    ((state) == FUT_CANCELLED || (state) == FUT_CANCELLED_AND_NOTIFIED)
+#define FUT_IS_DONE(state) \
+    (FUT_IS_CANCELLED(state) || (state) == FUT_FINISHED)
+
+typedef struct {
+    PyTypeObject *FutureType;
+    PyTypeObject *WorkItemType;
+    PyObject *state_names[FUT_NSTATES];
+    /* Looked up on first use: concurrent.futures._base imports this
+       module, so it can't be imported when this module is executed. */
+    PyObject *CancelledError;
+    PyObject *InvalidStateError;
+    PyObject *logger;
+    PyObject *Condition;
+} futures_state;
+
+static futures_state *
+futures_get_state(PyObject *module)
+{
+    futures_state *state = _PyModule_GetState(module);
+    assert(state);
+    return state;
+}
+static struct PyModuleDef futuresmodule;
+#define futures_get_state_by_type(type) \
+    (futures_get_state(PyType_GetModuleByDef(type, &futuresmodule)))
+
+/* A future relies on the GIL to change its state atomically, as long as
+   nobody accessed its `_condition`: wait() and as_completed() lock it
+   while they inspect the state of the futures and install waiters, and
+   state changes then lock it as well.
+
+   Threads waiting in result() or exception() block on done_lock, which
+   is allocated and acquired by the first of them, and released once the
+   future is done.  A thread getting the lock releases it right away so
+   that the other waiting threads see it released too. */
+typedef struct {
+    PyObject_HEAD
+    fut_state state;
+    int done_signalled;
+    PyObject *result;
+    PyObject *exception;
+    PyObject *waiters;          /* list of _base._Waiter, created on demand */
+    PyObject *done_callbacks;   /* list, created on demand */
+    PyObject *condition;        /* threading.Condition, created on demand */
+    PyThread_type_lock done_lock;
+    PyObject *dict;
+    PyObject *weakreflist;
+} futureobject;
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *future;
+    PyObject *fn;
+    PyObject *args;
+    PyObject *kwargs;
+} workitemobject;
+
+/*[clinic input]
+module _concurrent_futures
+class _concurrent_futures.Future "futureobject *" "futures_get_state_by_type(Py_TYPE(self))->FutureType"
+class _concurrent_futures._WorkItem "workitemobject *" "futures_get_state_by_type(type)->WorkItemType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=83a0eae5ffdd8058]*/
+
+#include "clinic/_concurrent_futuresmodule.c.h"
+
+
+static PyObject *
+futures_base_attr(PyObject **cache, const char *name)
+{
+    if (*cache == NULL) {
+        *cache = _PyImport_GetModuleAttrString("concurrent.futures._base",
+                                               name);
+    }
+    return *cache;
+}
+
+static PyObject *
+futures_condition_type(futures_state *state)
+{
+    if (state->Condition == NULL) {
+        state->Condition = _PyImport_GetModuleAttrString("threading",
+                                                         "Condition");
+    }
+    return state->Condition;
+}
+
+
+/* Future helpers */
+
+/* Lock the condition of the future, if it was ever created.  Set *locked
+   to 1 if the caller must call future_unlock(). */
+static int
+future_lock(futureobject *fut, int *locked)
+{
+    *locked = 0;
+    if (fut->condition == NULL) {
+        return 0;
+    }
+    PyObject *cond = Py_NewRef(fut->condition);
+    PyObject *res = PyObject_CallMethod(cond, "acquire", NULL);
+    Py_DECREF(cond);
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    *locked = 1;
+    return 0;
+}
+
+/* Unlock the condition locked by future_lock(), preserving the current
+   exception if any. */
+static int
+future_unlock(futureobject *fut, int locked)
+{
+    if (!locked) {
+        return 0;
+    }
+    PyObject *exc_type, *exc_value, *exc_tb;
+    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+    PyObject *res = PyObject_CallMethod(fut->condition, "release", NULL);
+    if (exc_type != NULL) {
+        if (res == NULL) {
+            PyErr_WriteUnraisable(fut->condition);
+        }
+        PyErr_Restore(exc_type, exc_value, exc_tb);
+    }
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    return exc_type == NULL ? 0 : -1;
+}
+
+/* Wake up the threads blocked in future_wait(). */
+static void
+future_signal_done(futureobject *fut)
+{
+    if (fut->done_lock != NULL && !fut->done_signalled) {
+        PyThread_release_lock(fut->done_lock);
+    }
+    fut->done_signalled = 1;
+}
+
+/* Mark the future done, and wake up its waiters.  The condition, if any,
+   must have been locked by future_lock(). */
+static int
+future_set_done(futureobject *fut, fut_state state, int locked)
+{
+    fut->state = state;
+    future_signal_done(fut);
+    if (locked) {
+        PyObject *res = PyObject_CallMethod(fut->condition, "notify_all",
+                                            NULL);
+        if (res == NULL) {
+            return -1;
+        }
+        Py_DECREF(res);
+    }
+    return 0;
+}
+
+/* Call method(fut) on every _base._Waiter of the future. */
+static int
+future_call_waiters(futureobject *fut, const char *method)
+{
+    if (fut->waiters == NULL || PyList_GET_SIZE(fut->waiters) == 0) {
+        return 0;
+    }
+    /* wait() removes its waiter once done, maybe while we are calling
+       the others. */
+    PyObject *waiters = PyList_GetSlice(fut->waiters, 0, PY_SSIZE_T_MAX);
+    if (waiters == NULL) {
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(waiters); i++) {
+        PyObject *res = PyObject_CallMethod(PyList_GET_ITEM(waiters, i),
+                                            method, "O", (PyObject *)fut);
+        if (res == NULL) {
+            Py_DECREF(waiters);
+            return -1;
+        }
+        Py_DECREF(res);
+    }
+    Py_DECREF(waiters);
+    return 0;
+}
+
+/* Log the current exception with LOGGER.exception(). */
+static int
+future_log_exception(futureobject *fut, const char *msg)
+{
+    futures_state *state = futures_get_state_by_type(Py_TYPE(fut));
+    PyObject *exc_type, *exc_value, *exc_tb;
+    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+    PyErr_NormalizeException(&exc_type, &exc_value, &exc_tb);
+    if (exc_tb != NULL) {
+        PyException_SetTraceback(exc_value, exc_tb);
+    }
+    PyObject *logger = futures_base_attr(&state->logger, "LOGGER");
+    if (logger == NULL) {
+        Py_XDECREF(exc_type);
+        Py_XDECREF(exc_value);
+        Py_XDECREF(exc_tb);
+        return -1;
+    }
+
+    /* LOGGER.exception() logs the exception being handled */
+    PyObject *handled = PyErr_GetHandledException();
+    PyErr_SetHandledException(exc_value);
+    PyObject *res = PyObject_CallMethod(logger, "exception", "sO",
+                                        msg, (PyObject *)fut);
+    PyErr_SetHandledException(handled);
+    Py_XDECREF(handled);
+    Py_XDECREF(exc_type);
+    Py_XDECREF(exc_value);
+    Py_XDECREF(exc_tb);
+    if (res == NULL) {
+        return -1;
+    }
+    Py_DECREF(res);
+    return 0;
+}
+
+static int
+future_call_callback(futureobject *fut, PyObject *callback)
+{
+    PyObject *res = PyObject_CallOneArg(callback, (PyObject *)fut);
+    if (res == NULL) {
+        if (!PyErr_ExceptionMatches(PyExc_Exception)) {
+            return -1;
+        }
+        return future_log_exception(fut,
+                                    "exception calling callback for %r");
+    }
+    Py_DECREF(res);
+    return 0;
+}
+
+static int
+future_invoke_callbacks(futureobject *fut)
+{
+    if (fut->done_callbacks == NULL) {
+        return 0;
+    }
+    PyObject *callbacks = Py_NewRef(fut->done_callbacks);
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(callbacks); i++) {
+        PyObject *callback = Py_NewRef(PyList_GET_ITEM(callbacks, i));
+        int res = future_call_callback(fut, callback);
+        Py_DECREF(callback);
+        if (res < 0) {
+            Py_DECREF(callbacks);
+            return -1;
+        }
+    }
+    Py_DECREF(callbacks);
+    return 0;
+}
+
+/* Wait until the future is done, or for timeout_obj seconds if it is not
+   None.  Return 0 if the future is done, 1 on timeout, -1 on error. */
+static int
+future_wait(futureobject *fut, PyObject *timeout_obj)
+{
+    if (FUT_IS_DONE(fut->state)) {
+        return 0;
+    }
+
+    _PyTime_t timeout = -1, endtime = 0;
+    if (timeout_obj != Py_None) {
+        if (_PyTime_FromSecondsObject(&timeout, timeout_obj,
+                                      _PyTime_ROUND_TIMEOUT) < 0) {
+            return -1;
+        }
+        /* Like Condition.wait(), a negative timeout doesn't block */
+        if (timeout < 0) {
+            timeout = 0;
+        }
+        endtime = _PyDeadline_Init(timeout);
+    }
+
+    if (fut->done_lock == NULL) {
+        fut->done_lock = PyThread_allocate_lock();
+        if (fut->done_lock == NULL) {
+            PyErr_SetString(PyExc_MemoryError, "can't allocate lock");
+            return -1;
+        }
+        PyThread_acquire_lock(fut->done_lock, WAIT_LOCK);
+        fut->done_signalled = 0;
+    }
+
+    while (!FUT_IS_DONE(fut->state)) {
+        PY_TIMEOUT_T microseconds = -1;
+        if (timeout >= 0) {
+            microseconds = _PyTime_AsMicroseconds(timeout,
+                                                  _PyTime_ROUND_TIMEOUT);
+            if (microseconds > PY_TIMEOUT_MAX) {
+                PyErr_SetString(PyExc_OverflowError,
+                                "timeout value is too large");
+                return -1;
+            }
+        }
+
+        PyThread_type_lock lock = fut->done_lock;
+        PyLockStatus r = PyThread_acquire_lock_timed(lock, 0, 0);
+        if (r == PY_LOCK_FAILURE && microseconds != 0) {
+            Py_BEGIN_ALLOW_THREADS
+            r = PyThread_acquire_lock_timed(lock, microseconds, 1);
+            Py_END_ALLOW_THREADS
+        }
+        if (r == PY_LOCK_ACQUIRED) {
+            /* Let the other waiting threads through */
+            PyThread_release_lock(lock);
+            continue;
+        }
+        if (r == PY_LOCK_INTR && Py_MakePendingCalls() < 0) {
+            return -1;
+        }
+        if (timeout >= 0) {
+            timeout = _PyDeadline_Get(endtime);
+            if (r == PY_LOCK_FAILURE || timeout < 0) {
+                return FUT_IS_DONE(fut->state) ? 0 : 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Return a new reference to the result of a finished future, or raise
+   its exception. */
+static PyObject *
+future_get_result(futureobject *fut)
+{
+    PyObject *exc = fut->exception;
+    if (exc != NULL && exc != Py_None) {
+        if (PyExceptionInstance_Check(exc)) {
+            PyErr_SetObject((PyObject *)Py_TYPE(exc), exc);
+        }
+        else if (PyExceptionClass_Check(exc)) {
+            PyErr_SetNone(exc);
+        }
+        else {
+            PyErr_SetString(PyExc_TypeError,
+                            "exceptions must derive from BaseException");
+        }
+        return NULL;
+    }
+    return Py_NewRef(fut->result != NULL ? fut->result : Py_None);
+}
+
+static PyObject *
+future_set_cancelled_error(futureobject *fut)
+{
+    futures_state *state = futures_get_state_by_type(Py_TYPE(fut));
+    PyObject *exc = futures_base_attr(&state->CancelledError,
+                                      "CancelledError");
+    if (exc != NULL) {
+        PyErr_SetNone(exc);
+    }
+    return NULL;
+}
+
+static int
+future_check_not_done(futureobject *fut)
+{
+    if (!FUT_IS_DONE(fut->state)) {
+        return 0;
+    }
+    futures_state *state = futures_get_state_by_type(Py_TYPE(fut));
+    PyObject *exc = futures_base_attr(&state->InvalidStateError,
+                                      "InvalidStateError");
+    if (exc != NULL) {
+        PyErr_Format(exc, "%s: %R", fut_state_names[fut->state], fut);
+    }
+    return -1;
+}
+
+/* Common implementation of set_result() and set_exception(): exception
+   is non-zero if value is an exception. */
+static PyObject *
+future_finish(futureobject *fut, PyObject *value, int exception)
+{
+    int locked;
+    if (future_lock(fut, &locked) < 0) {
+        return NULL;
+    }
+    if (future_check_not_done(fut) < 0) {
+        goto error;
+    }
+    if (exception) {
+        Py_XSETREF(fut->exception, Py_NewRef(value));
+    }
+    else {
+        Py_XSETREF(fut->result, Py_NewRef(value));
+    }
+    /* If a waiter fails, finish the future anyway: its error is raised
+       once the condition is notified and the callbacks are invoked. */
+    PyObject *exc_type = NULL, *exc_value = NULL, *exc_tb = NULL;
+    if (future_call_waiters(fut, exception ? "add_exception"
+                                           : "add_result") < 0) {
+        PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+    }
+    if (future_set_done(fut, FUT_FINISHED, locked) < 0) {
+        _PyErr_ChainExceptions(exc_type, exc_value, exc_tb);
+        goto error;
+    }
+    if (future_unlock(fut, locked) < 0) {
+        _PyErr_ChainExceptions(exc_type, exc_value, exc_tb);
+        return NULL;
+    }
+    if (future_invoke_callbacks(fut) < 0) {
+        _PyErr_ChainExceptions(exc_type, exc_value, exc_tb);
+        return NULL;
+    }
+    if (exc_type != NULL) {
+        PyErr_Restore(exc_type, exc_value, exc_tb);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+
+error:
+    future_unlock(fut, locked);
+    return NULL;
+}
+
+static int
+future_set_running_or_notify_cancel(futureobject *fut)
+{
+    int locked;
+    if (future_lock(fut, &locked) < 0) {
+        return -1;
+    }
+    if (fut->state == FUT_CANCELLED) {
+        fut->state = FUT_CANCELLED_AND_NOTIFIED;
+        /* Notifying the condition is not necessary: cancel() did it */
+        if (future_call_waiters(fut, "add_cancelled") < 0) {
+            future_unlock(fut, locked);
+            return -1;
+        }
+        return future_unlock(fut, locked) < 0 ? -1 : 0;
+    }
+    if (fut->state == FUT_PENDING) {
+        fut->state = FUT_RUNNING;
+        return future_unlock(fut, locked) < 0 ? -1 : 1;
+    }
+
+    futures_state *state = futures_get_state_by_type(Py_TYPE(fut));
+    PyObject *logger = futures_base_attr(&state->logger, "LOGGER");
+    if (logger != NULL) {
+        PyObject *res = PyObject_CallMethod(
+            logger, "critical", "sNs",
+            "Future %s in unexpected state: %s",
+            PyLong_FromVoidPtr(fut), fut_state_names[fut->state]);
+        if (res != NULL) {
+            Py_DECREF(res);
+            PyErr_SetString(PyExc_RuntimeError, "Future in unexpected state");
+        }
+    }
+    future_unlock(fut, locked);
+    return -1;
+}
+
+
+/* Future methods */
+
+/*[clinic input]
+_concurrent_futures.Future.__init__
+
+Initializes the future. Should not be called by clients.
+[clinic start generated code]*/
+
+static int
+_concurrent_futures_Future___init___impl(futureobject *self)
+/*[clinic end generated code: output=33790f1d1bb14136 input=ff88ef8e1b8b19cd]*/
+{
+    self->state = FUT_PENDING;
+    self->done_signalled = 0;
+    Py_CLEAR(self->result);
+    Py_CLEAR(self->exception);
+    Py_CLEAR(self->waiters);
+    Py_CLEAR(self->done_callbacks);
+    Py_CLEAR(self->condition);
+    return 0;
+}
+
+/*[clinic input]
+_concurrent_futures.Future.cancel
+
+Cancel the future if possible.
+
+Returns True if the future was cancelled, False otherwise. A future
+cannot be cancelled if it is running or has already completed.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_cancel_impl(futureobject *self)
+/*[clinic end generated code: output=a1b88a8665520ec7 input=795053f858b10fcb]*/
+{
+    int locked;
+    if (future_lock(self, &locked) < 0) {
+        return NULL;
+    }
+    if (self->state == FUT_RUNNING || self->state == FUT_FINISHED) {
+        if (future_unlock(self, locked) < 0) {
+            return NULL;
+        }
+        Py_RETURN_FALSE;
+    }
+    if (FUT_IS_CANCELLED(self->state)) {
+        if (future_unlock(self, locked) < 0) {
+            return NULL;
+        }
+        Py_RETURN_TRUE;
+    }
+    if (future_set_done(self, FUT_CANCELLED, locked) < 0) {
+        future_unlock(self, locked);
+        return NULL;
+    }
+    if (future_unlock(self, locked) < 0) {
+        return NULL;
+    }
+    if (future_invoke_callbacks(self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_TRUE;
+}
+
+/*[clinic input]
+_concurrent_futures.Future.cancelled
+
+Return True if the future was cancelled.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_cancelled_impl(futureobject *self)
+/*[clinic end generated code: output=8b3aaa9c01dc2e1c input=2181dfd1d84a8ae3]*/
+{
+    return PyBool_FromLong(FUT_IS_CANCELLED(self->state));
+}
+
+/*[clinic input]
+_concurrent_futures.Future.running
+
+Return True if the future is currently executing.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_running_impl(futureobject *self)
+/*[clinic end generated code: output=7610bd1d76481c76 input=e3e423c4b1b10b3a]*/
+{
+    return PyBool_FromLong(self->state == FUT_RUNNING);
+}
+
+/*[clinic input]
+_concurrent_futures.Future.done
+
+Return True if the future was cancelled or finished executing.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_done_impl(futureobject *self)
+/*[clinic end generated code: output=f0c055bde9745c0e input=8cddd7bceef5e768]*/
+{
+    return PyBool_FromLong(FUT_IS_DONE(self->state));
+}
+
+/*[clinic input]
+_concurrent_futures.Future.add_done_callback
+
+    fn: object
+    /
+
+Attaches a callable that will be called when the future finishes.
+
+fn will be called with this future as its only argument when the future
+completes or is cancelled. The callable will always be called by a
+thread in the same process in which it was added. If the future has
+already completed or been cancelled then the callable will be called
+immediately. These callables are called in the order that they were
+added.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_add_done_callback(futureobject *self,
+                                             PyObject *fn)
+/*[clinic end generated code: output=e63f450101af0a6c input=442caa908a641edc]*/
+{
+    if (!FUT_IS_DONE(self->state)) {
+        if (self->done_callbacks == NULL) {
+            self->done_callbacks = PyList_New(0);
+            if (self->done_callbacks == NULL) {
+                return NULL;
+            }
+        }
+        if (PyList_Append(self->done_callbacks, fn) < 0) {
+            return NULL;
+        }
+        Py_RETURN_NONE;
+    }
+    if (future_call_callback(self, fn) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_concurrent_futures.Future.result
+
+    timeout: object = None
+
+Return the result of the call that the future represents.
+
+timeout is the number of seconds to wait for the result if the future
+isn't done. If None, then there is no limit on the wait time.
+
+Raises CancelledError if the future was cancelled, TimeoutError if the
+future didn't finish executing before the given timeout, and the
+exception raised by the call if any.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_result_impl(futureobject *self, PyObject *timeout)
+/*[clinic end generated code: output=3e1b122048b6932a input=b517da8156244aa6]*/
+{
+    if (future_wait(self, timeout) < 0) {
+        return NULL;
+    }
+    int locked;
+    if (future_lock(self, &locked) < 0) {
+        return NULL;
+    }
+    PyObject *result;
+    if (FUT_IS_CANCELLED(self->state)) {
+        result = future_set_cancelled_error(self);
+    }
+    else if (self->state == FUT_FINISHED) {
+        result = future_get_result(self);
+    }
+    else {
+        PyErr_SetNone(PyExc_TimeoutError);
+        result = NULL;
+    }
+    if (future_unlock(self, locked) < 0) {
+        Py_XDECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+/*[clinic input]
+_concurrent_futures.Future.exception
+
+    timeout: object = None
+
+Return the exception raised by the call that the future represents.
+
+timeout is the number of seconds to wait for the exception if the future
+isn't done. If None, then there is no limit on the wait time.
+
+Return None if the call completed without raising.  Raises
+CancelledError if the future was cancelled, and TimeoutError if the
+future didn't finish executing before the given timeout.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_exception_impl(futureobject *self,
+                                          PyObject *timeout)
+/*[clinic end generated code: output=4e0ec7cc3a73a336 input=97b381bd63c9a31f]*/
+{
+    if (future_wait(self, timeout) < 0) {
+        return NULL;
+    }
+    int locked;
+    if (future_lock(self, &locked) < 0) {
+        return NULL;
+    }
+    PyObject *result;
+    if (FUT_IS_CANCELLED(self->state)) {
+        result = future_set_cancelled_error(self);
+    }
+    else if (self->state == FUT_FINISHED) {
+        result = Py_NewRef(self->exception != NULL ? self->exception
+                                                   : Py_None);
+    }
+    else {
+        PyErr_SetNone(PyExc_TimeoutError);
+        result = NULL;
+    }
+    if (future_unlock(self, locked) < 0) {
+        Py_XDECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+/*[clinic input]
+_concurrent_futures.Future.set_running_or_notify_cancel
+
+Mark the future as running or process any cancel notifications.
+
+Should only be used by Executor implementations and unit tests.
+
+If the future has been cancelled (cancel() was called and returned
+True) then any threads waiting on the future completing (though calls
+to as_completed() or wait()) are notified and False is returned.
+
+If the future was not cancelled then it is put in the running state
+(future calls to running() will return True) and True is returned.
+
+This method should be called by Executor implementations before
+executing the work associated with this future. If this method returns
+False then the work should not be executed.
+
+Raises RuntimeError if this method was already called or if set_result()
+or set_exception() was called.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_set_running_or_notify_cancel_impl(futureobject *self)
+/*[clinic end generated code: output=46c64184e9f06471 input=92606f8c3168f0e5]*/
+{
+    int res = future_set_running_or_notify_cancel(self);
+    if (res < 0) {
+        return NULL;
+    }
+    return PyBool_FromLong(res);
+}
+
+/*[clinic input]
+_concurrent_futures.Future.set_result
+
+    result: object
+    /
+
+Sets the return value of work associated with the future.
+
+Should only be used by Executor implementations and unit tests.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_set_result(futureobject *self, PyObject *result)
+/*[clinic end generated code: output=a4b2de67a0a23590 input=13b450b54a506746]*/
+{
+    return future_finish(self, result, 0);
+}
+
+/*[clinic input]
+_concurrent_futures.Future.set_exception
+
+    exception: object
+    /
+
+Sets the result of the future as being the given exception.
+
+Should only be used by Executor implementations and unit tests.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future_set_exception(futureobject *self,
+                                         PyObject *exception)
+/*[clinic end generated code: output=d8cecfcc08549ba1 input=5bf21a0783d627f5]*/
+{
+    return future_finish(self, exception, 1);
+}
+
+/*[clinic input]
+_concurrent_futures.Future._invoke_callbacks
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures_Future__invoke_callbacks_impl(futureobject *self)
+/*[clinic end generated code: output=046677ab76ac42fa input=40c7045c2d65429a]*/
+{
+    if (future_invoke_callbacks(self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+future_repr(futureobject *self)
+{
+    PyObject *name = PyType_GetName(Py_TYPE(self));
+    if (name == NULL) {
+        return NULL;
+    }
+    PyObject *repr;
+    const char *description = fut_state_descriptions[self->state];
+    if (self->state == FUT_FINISHED) {
+        PyObject *exc = self->exception;
+        int raised = exc != NULL && exc != Py_None;
+        PyObject *value = raised ? exc : self->result;
+        PyObject *value_name = PyType_GetName(
+            Py_TYPE(value != NULL ? value : Py_None));
+        if (value_name == NULL) {
+            Py_DECREF(name);
+            return NULL;
+        }
+        repr = PyUnicode_FromFormat("<%U at %p state=%s %s %U>",
+                                    name, self, description,
+                                    raised ? "raised" : "returned",
+                                    value_name);
+        Py_DECREF(value_name);
+    }
+    else {
+        repr = PyUnicode_FromFormat("<%U at %p state=%s>",
+                                    name, self, description);
+    }
+    Py_DECREF(name);
+    return repr;
+}
+
+static PyObject *
+future_get_state(futureobject *self, void *Py_UNUSED(ignored))
+{
+    futures_state *state = futures_get_state_by_type(Py_TYPE(self));
+    return Py_NewRef(state->state_names[self->state]);
+}
+
+static int
+future_set_state(futureobject *self, PyObject *value,
+                 void *Py_UNUSED(ignored))
+{
+    if (value == NULL) {
+        PyErr_SetString(PyExc_AttributeError, "cannot delete _state");
+        return -1;
+    }
+    futures_state *state = futures_get_state_by_type(Py_TYPE(self));
+    for (int i = 0; i < FUT_NSTATES; i++) {
+        int eq = PyObject_RichCompareBool(value, state->state_names[i],
+                                          Py_EQ);
+        if (eq < 0) {
+            return -1;
+        }
+        if (eq) {
+            self->state = (fut_state)i;
+            if (FUT_IS_DONE(self->state)) {
+                future_signal_done(self);
+            }
+            else if (self->done_signalled && self->done_lock != NULL) {
+                /* Back to a pending state (only done by tests) */
+                if (PyThread_acquire_lock(self->done_lock, NOWAIT_LOCK)) {
+                    self->done_signalled = 0;
+                }
+            }
+            else {
+                self->done_signalled = 0;
+            }
+            return 0;
+        }
+    }
+    PyErr_Format(PyExc_ValueError, "invalid future state: %R", value);
+    return -1;
+}
+
+static PyObject *
+future_get_condition(futureobject *self, void *Py_UNUSED(ignored))
+{
+    if (self->condition == NULL) {
+        futures_state *state = futures_get_state_by_type(Py_TYPE(self));
+        PyObject *type = futures_condition_type(state);
+        if (type == NULL) {
+            return NULL;
+        }
+        PyObject *condition = PyObject_CallNoArgs(type);
+        if (condition == NULL) {
+            return NULL;
+        }
+        /* Another thread may have won the race while the condition was
+           being created. */
+        if (self->condition == NULL) {
+            self->condition = condition;
+        }
+        else {
+            Py_DECREF(condition);
+        }
+    }
+    return Py_NewRef(self->condition);
+}
+
+static PyObject *
+future_get_list(PyObject **list)
+{
+    if (*list == NULL) {
+        *list = PyList_New(0);
+        if (*list == NULL) {
+            return NULL;
+        }
+    }
+    return Py_NewRef(*list);
+}
+
+static PyObject *
+future_get_waiters(futureobject *self, void *Py_UNUSED(ignored))
+{
+    return future_get_list(&self->waiters);
+}
+
+static PyObject *
+future_get_done_callbacks(futureobject *self, void *Py_UNUSED(ignored))
+{
+    return future_get_list(&self->done_callbacks);
+}
+
+static int
+future_traverse(futureobject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(self->result);
+    Py_VISIT(self->exception);
+    Py_VISIT(self->waiters);
+    Py_VISIT(self->done_callbacks);
+    Py_VISIT(self->condition);
+    Py_VISIT(self->dict);
+    return 0;
+}
+
+static int
+future_clear(futureobject *self)
+{
+    Py_CLEAR(self->result);
+    Py_CLEAR(self->exception);
+    Py_CLEAR(self->waiters);
+    Py_CLEAR(self->done_callbacks);
+    Py_CLEAR(self->condition);
+    Py_CLEAR(self->dict);
+    return 0;
+}
+
+static void
+future_dealloc(futureobject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    if (self->weakreflist != NULL) {
+        PyObject_ClearWeakRefs((PyObject *)self);
+    }
+    (void)future_clear(self);
+    if (self->done_lock != NULL) {
+        if (!self->done_signalled) {
+            PyThread_release_lock(self->done_lock);
+        }
+        PyThread_free_lock(self->done_lock);
+    }
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef future_methods[] = {
+    _CONCURRENT_FUTURES_FUTURE_CANCEL_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_CANCELLED_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_RUNNING_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_DONE_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_ADD_DONE_CALLBACK_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_RESULT_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_EXCEPTION_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_SET_RUNNING_OR_NOTIFY_CANCEL_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_SET_RESULT_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE_SET_EXCEPTION_METHODDEF
+    _CONCURRENT_FUTURES_FUTURE__INVOKE_CALLBACKS_METHODDEF
+    {"__class_getitem__",    Py_GenericAlias,
+    METH_O|METH_CLASS,       PyDoc_STR("See PEP 585")},
+    {NULL,           NULL}              /* sentinel */
+};
+
+static PyGetSetDef future_getsets[] = {
+    {"_state", (getter)future_get_state, (setter)future_set_state, NULL},
+    {"_condition", (getter)future_get_condition, NULL, NULL},
+    {"_waiters", (getter)future_get_waiters, NULL, NULL},
+    {"_done_callbacks", (getter)future_get_done_callbacks, NULL, NULL},
+    {"__dict__", PyObject_GenericGetDict, PyObject_GenericSetDict},
+    {NULL}
+};
+
+static struct PyMemberDef future_members[] = {
+    {"_result", T_OBJECT, offsetof(futureobject, result), 0},
+    {"_exception", T_OBJECT, offsetof(futureobject, exception), 0},
+    {"__dictoffset__", T_PYSSIZET, offsetof(futureobject, dict), READONLY},
+    {"__weaklistoffset__", T_PYSSIZET, offsetof(futureobject, weakreflist), READONLY},
+    {NULL},
+};
+
+PyDoc_STRVAR(future_doc,
+"Future()\n\
+--\n\
+\n\
+Represents the result of an asynchronous computation.");
+
+static PyType_Slot future_slots[] = {
+    {Py_tp_dealloc, future_dealloc},
+    {Py_tp_repr, future_repr},
+    {Py_tp_doc, (void *)future_doc},
+    {Py_tp_traverse, future_traverse},
+    {Py_tp_clear, future_clear},
+    {Py_tp_members, future_members},
+    {Py_tp_methods, future_methods},
+    {Py_tp_getset, future_getsets},
+    {Py_tp_init, _concurrent_futures_Future___init__},
+    {Py_tp_new, PyType_GenericNew},
+    {0, NULL},
+};
+
+static PyType_Spec future_spec = {
+    .name = "_concurrent_futures.Future",
+    .basicsize = sizeof(futureobject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = future_slots,
+};
+
+
+/* _WorkItem */
+
+/*[clinic input]
+@classmethod
+_concurrent_futures._WorkItem.__new__ as workitem_new
+
+    future: object
+    fn: object
+    args as call_args: object(subclass_of='&PyTuple_Type')
+    kwargs as call_kwargs: object(subclass_of='&PyDict_Type')
+    /
+
+A call to run in a ThreadPoolExecutor worker thread.
+[clinic start generated code]*/
+
+static PyObject *
+workitem_new_impl(PyTypeObject *type, PyObject *future, PyObject *fn,
+                  PyObject *call_args, PyObject *call_kwargs)
+/*[clinic end generated code: output=66937ed3c236de9c input=b832f9855dda9dfc]*/
+{
+    workitemobject *self = (workitemobject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->future = Py_NewRef(future);
+    self->fn = Py_NewRef(fn);
+    self->args = Py_NewRef(call_args);
+    self->kwargs = Py_NewRef(call_kwargs);
+    return (PyObject *)self;
+}
+
+/*[clinic input]
+_concurrent_futures._WorkItem.run
+
+    cls: defining_class
+    /
+
+Run the call and set the result or exception of the future.
+[clinic start generated code]*/
+
+static PyObject *
+_concurrent_futures__WorkItem_run_impl(workitemobject *self,
+                                       PyTypeObject *cls)
+/*[clinic end generated code: output=d741d16864f341aa input=6ce7fe233ead5782]*/
+{
+    futures_state *state = PyType_GetModuleState(cls);
+    PyObject *future = self->future;
+    int exact = Py_IS_TYPE(future, state->FutureType);
+    int running;
+    if (exact) {
+        running = future_set_running_or_notify_cancel((futureobject *)future);
+    }
+    else {
+        PyObject *res = PyObject_CallMethod(future,
+                                            "set_running_or_notify_cancel",
+                                            NULL);
+        if (res == NULL) {
+            return NULL;
+        }
+        running = PyObject_IsTrue(res);
+        Py_DECREF(res);
+    }
+    if (running <= 0) {
+        return running < 0 ? NULL : Py_NewRef(Py_None);
+    }
+
+    PyObject *kwargs = PyDict_GET_SIZE(self->kwargs) ? self->kwargs : NULL;
+    PyObject *result = PyObject_Call(self->fn, self->args, kwargs);
+    int exception = 0;
+    if (result == NULL) {
+        PyObject *exc_type, *exc_tb;
+        PyErr_Fetch(&exc_type, &result, &exc_tb);
+        PyErr_NormalizeException(&exc_type, &result, &exc_tb);
+        if (exc_tb != NULL) {
+            PyException_SetTraceback(result, exc_tb);
+        }
+        Py_XDECREF(exc_type);
+        Py_XDECREF(exc_tb);
+        exception = 1;
+    }
+
+    PyObject *res;
+    if (exact) {
+        res = future_finish((futureobject *)future, result, exception);
+    }
+    else {
+        res = PyObject_CallMethod(future,
+                                  exception ? "set_exception" : "set_result",
+                                  "O", result);
+    }
+    Py_DECREF(result);
+    return res;
+}
+
+static int
+workitem_traverse(workitemobject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(self->future);
+    Py_VISIT(self->fn);
+    Py_VISIT(self->args);
+    Py_VISIT(self->kwargs);
+    return 0;
+}
+
+static int
+workitem_clear(workitemobject *self)
+{
+    Py_CLEAR(self->future);
+    Py_CLEAR(self->fn);
+    Py_CLEAR(self->args);
+    Py_CLEAR(self->kwargs);
+    return 0;
+}
+
+static void
+workitem_dealloc(workitemobject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    (void)workitem_clear(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef workitem_methods[] = {
+    _CONCURRENT_FUTURES__WORKITEM_RUN_METHODDEF
+    {"__class_getitem__",    Py_GenericAlias,
+    METH_O|METH_CLASS,       PyDoc_STR("See PEP 585")},
+    {NULL,           NULL}              /* sentinel */
+};
+
+static struct PyMemberDef workitem_members[] = {
+    {"future", T_OBJECT, offsetof(workitemobject, future), READONLY},
+    {"fn", T_OBJECT, offsetof(workitemobject, fn), READONLY},
+    {"args", T_OBJECT, offsetof(workitemobject, args), READONLY},
+    {"kwargs", T_OBJECT, offsetof(workitemobject, kwargs), READONLY},
+    {NULL},
+};
+
+static PyType_Slot workitem_slots[] = {
+    {Py_tp_dealloc, workitem_dealloc},
+    {Py_tp_doc, (void *)workitem_new__doc__},
+    {Py_tp_traverse, workitem_traverse},
+    {Py_tp_clear, workitem_clear},
+    {Py_tp_members, workitem_members},
+    {Py_tp_methods, workitem_methods},
+    {Py_tp_new, workitem_new},
+    {0, NULL},
+};
+
+static PyType_Spec workitem_spec = {
+    .name = "_concurrent_futures._WorkItem",
+    .basicsize = sizeof(workitemobject),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = workitem_slots,
+};
+
+
+/* Module */
+
+static int
+futures_traverse(PyObject *module, visitproc visit, void *arg)
+{
+    futures_state *state = futures_get_state(module);
+    Py_VISIT(state->FutureType);
+    Py_VISIT(state->WorkItemType);
+    for (int i = 0; i < FUT_NSTATES; i++) {
+        Py_VISIT(state->state_names[i]);
+    }
+    Py_VISIT(state->CancelledError);
+    Py_VISIT(state->InvalidStateError);
+    Py_VISIT(state->logger);
+    Py_VISIT(state->Condition);
+    return 0;
+}
+
+static int
+futures_clear(PyObject *module)
+{
+    futures_state *state = futures_get_state(module);
+    Py_CLEAR(state->FutureType);
+    Py_CLEAR(state->WorkItemType);
+    for (int i = 0; i < FUT_NSTATES; i++) {
+        Py_CLEAR(state->state_names[i]);
+    }
+    Py_CLEAR(state->CancelledError);
+    Py_CLEAR(state->InvalidStateError);
+    Py_CLEAR(state->logger);
+    Py_CLEAR(state->Condition);
+    return 0;
+}
+
+static void
+futures_free(void *module)
+{
+    futures_clear((PyObject *)module);
+}
+
+PyDoc_STRVAR(futures_module_doc,
+"C implementation of the concurrent.futures module.\n\
+This module is an implementation detail, please do not use it directly.");
+
+static int
+futuresmodule_exec(PyObject *module)
+{
+    futures_state *state = futures_get_state(module);
+
+    for (int i = 0; i < FUT_NSTATES; i++) {
+        state->state_names[i] = PyUnicode_InternFromString(
+            fut_state_names[i]);
+        if (state->state_names[i] == NULL) {
+            return -1;
+        }
+    }
+
+    state->FutureType = (PyTypeObject *)PyType_FromModuleAndSpec(
+        module, &future_spec, NULL);
+    if (state->FutureType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->FutureType) < 0) {
+        return -1;
+    }
+
+    state->WorkItemType = (PyTypeObject *)PyType_FromModuleAndSpec(
+        module, &workitem_spec, NULL);
+    if (state->WorkItemType == NULL) {
+        return -1;
+    }
+    if (PyModule_AddType(module, state->WorkItemType) < 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static PyModuleDef_Slot futuresmodule_slots[] = {
+    {Py_mod_exec, futuresmodule_exec},
+    {0, NULL}
+};
+
+
+static struct PyModuleDef futuresmodule = {
+    .m_base = PyModuleDef_HEAD_INIT,
+    .m_name = "_concurrent_futures",
+    .m_doc = futures_module_doc,
+    .m_size = sizeof(futures_state),
+    .m_slots = futuresmodule_slots,
+    .m_traverse = futures_traverse,
+    .m_clear = futures_clear,
+    .m_free = futures_free,
+};
+
+
+PyMODINIT_FUNC
+PyInit__concurrent_futures(void)
+{
+   return PyModuleDef_Init(&futuresmodule);
+}
@@ -120,6 +120,7 @@ typedef struct {
     DialectObj *dialect;    /* parsing dialect */
 
     PyObject *fields;           /* field list for current record */
+    Py_ssize_t fields_hint;     /* number of fields of the last record */
     ParserState state;          /* current CSV parse state */
     Py_UCS4 *field;             /* temporary buffer */
     Py_ssize_t field_size;      /* size of allocated buffer */
@@ -856,6 +857,9 @@ parse_reset(ReaderObj *self)
     Py_XSETREF(self->fields, PyList_New(0));
     if (self->fields == NULL)
         return -1;
+    /* Records usually have the same number of fields: presize the list. */
+    if (_PyList_Reserve(self->fields, self->fields_hint) < 0)
+        return -1;
     self->field_len = 0;
     self->state = START_RECORD;
     self->numeric_field = 0;
@@ -928,6 +932,7 @@ Reader_iternext(ReaderObj *self)
 
     fields = self->fields;
     self->fields = NULL;
+    self->fields_hint = PyList_GET_SIZE(fields);
 err:
     return fields;
 }
@@ -1023,6 +1028,7 @@ csv_reader(PyObject *module, PyObject *args, PyObject *keyword_args)
     self->field = NULL;
     self->field_size = 0;
     self->line_num = 0;
+    self->fields_hint = 0;
 
     if (parse_reset(self) < 0) {
         Py_DECREF(self);
@@ -10,6 +10,7 @@
 
 #include "Python.h"
 #include "pycore_ceval.h"         // _Py_EnterRecursiveCall()
+#include "pycore_list.h"          // _PyList_AppendArrayTakeRefs()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
 #include "pycore_runtime.h"       // _Py_ID()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
@@ -6444,16 +6445,13 @@ do_append(UnpicklerObject *self, Py_ssize_t x)
     list = self->stack->data[x - 1];
 
     if (PyList_CheckExact(list)) {
-        Py_ssize_t list_len;
-        int ret;
-
-        slice = Pdata_poplist(self->stack, x);
-        if (!slice)
+        /* Move the items from the stack to the end of the list. */
+        if (_PyList_AppendArrayTakeRefs(list, &self->stack->data[x],
+                                        len - x) < 0) {
             return -1;
-        list_len = PyList_GET_SIZE(list);
-        ret = PyList_SetSlice(list, list_len, list_len, slice);
-        Py_DECREF(slice);
-        return ret;
+        }
+        Py_SET_SIZE(self->stack, x);
+        return 0;
     }
     else {
         PyObject *extend_func;
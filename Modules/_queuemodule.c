@@ -3,6 +3,7 @@
 #endif
 
 #include "Python.h"
+#include "pycore_list.h"          // _PyList_AppendArrayTakeRefs()
 #include "pycore_moduleobject.h"  // _PyModule_GetState()
 #include "structmember.h"         // PyMemberDef
 #include <stddef.h>               // offsetof()
@@ -23,12 +24,19 @@ static struct PyModuleDef queuemodule;
 #define simplequeue_get_state_by_type(type) \
     (simplequeue_get_state(PyType_GetModuleByDef(type, &queuemodule)))
 
+/* The items are stored in a circular buffer whose capacity is a power of
+   two, so that indices can be wrapped with a mask.  The buffer doubles when
+   full and halves when less than a quarter full. */
+#define SIMPLEQUEUE_MINSIZE 8
+
 typedef struct {
     PyObject_HEAD
     PyThread_type_lock lock;
     int locked;
-    PyObject *lst;
-    Py_ssize_t lst_pos;
+    PyObject **items;
+    Py_ssize_t items_cap;
+    Py_ssize_t items_head;   /* index of the oldest item */
+    Py_ssize_t num_items;
     PyObject *weakreflist;
 } simplequeueobject;
 
@@ -41,7 +49,20 @@ class _queue.SimpleQueue "simplequeueobject *" "simplequeue_get_state_by_type(ty
 static int
 simplequeue_clear(simplequeueobject *self)
 {
-    Py_CLEAR(self->lst);
+    PyObject **items = self->items;
+    Py_ssize_t mask = self->items_cap - 1;
+    Py_ssize_t head = self->items_head;
+    Py_ssize_t n = self->num_items;
+
+    /* Detach the buffer first: a destructor may put() new items. */
+    self->items = NULL;
+    self->items_cap = 0;
+    self->items_head = 0;
+    self->num_items = 0;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        Py_DECREF(items[(head + i) & mask]);
+    }
+    PyMem_Free(items);
     return 0;
 }
 
@@ -67,11 +88,115 @@ simplequeue_dealloc(simplequeueobject *self)
 static int
 simplequeue_traverse(simplequeueobject *self, visitproc visit, void *arg)
 {
-    Py_VISIT(self->lst);
+    Py_ssize_t mask = self->items_cap - 1;
+    for (Py_ssize_t i = 0; i < self->num_items; i++) {
+        Py_VISIT(self->items[(self->items_head + i) & mask]);
+    }
     Py_VISIT(Py_TYPE(self));
     return 0;
 }
 
+/* Move the items to a new buffer of new_cap slots (a power of two, at least
+   num_items), oldest item first.  Return -1 without setting an exception
+   if the memory cannot be allocated. */
+static int
+simplequeue_resize(simplequeueobject *self, Py_ssize_t new_cap)
+{
+    PyObject **items;
+    Py_ssize_t head = self->items_head;
+    Py_ssize_t n = self->num_items;
+
+    assert(new_cap >= n && (new_cap & (new_cap - 1)) == 0);
+    items = PyMem_New(PyObject *, new_cap);
+    if (items == NULL) {
+        return -1;
+    }
+    if (n > 0) {
+        /* The items may wrap around the end of the old buffer. */
+        Py_ssize_t first = Py_MIN(n, self->items_cap - head);
+        memcpy(items, self->items + head, first * sizeof(PyObject *));
+        memcpy(items + first, self->items, (n - first) * sizeof(PyObject *));
+    }
+    PyMem_Free(self->items);
+    self->items = items;
+    self->items_cap = new_cap;
+    self->items_head = 0;
+    return 0;
+}
+
+/* Make room for n more items. */
+static int
+simplequeue_reserve(simplequeueobject *self, Py_ssize_t n)
+{
+    Py_ssize_t new_cap;
+
+    if (self->items_cap - self->num_items >= n) {
+        return 0;
+    }
+    if (n > PY_SSIZE_T_MAX / 2 - self->num_items) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    new_cap = Py_MAX(self->items_cap, SIMPLEQUEUE_MINSIZE);
+    while (new_cap < self->num_items + n) {
+        new_cap *= 2;
+    }
+    if (simplequeue_resize(self, new_cap) < 0) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+/* Append an item; the queue must have room for it. */
+static inline void
+simplequeue_push_item(simplequeueobject *self, PyObject *item)
+{
+    Py_ssize_t i = (self->items_head + self->num_items) & (self->items_cap - 1);
+
+    assert(self->num_items < self->items_cap);
+    self->items[i] = Py_NewRef(item);
+    self->num_items++;
+}
+
+/* Remove and return the oldest item; the queue must not be empty.
+   Call simplequeue_shrink() once done removing items. */
+static inline PyObject *
+simplequeue_pop_item(simplequeueobject *self)
+{
+    PyObject *item = self->items[self->items_head];
+
+    assert(self->num_items > 0);
+    self->items[self->items_head] = NULL;
+    self->items_head = (self->items_head + 1) & (self->items_cap - 1);
+    self->num_items--;
+    return item;
+}
+
+static void
+simplequeue_shrink(simplequeueobject *self)
+{
+    Py_ssize_t new_cap = self->items_cap;
+
+    while (new_cap > SIMPLEQUEUE_MINSIZE && self->num_items < new_cap / 4) {
+        new_cap /= 2;
+    }
+    if (new_cap < self->items_cap) {
+        /* Keep the larger buffer if the smaller one cannot be allocated */
+        (void)simplequeue_resize(self, new_cap);
+    }
+}
+
+/* Wake up a get() waiting for the queue to be non-empty. */
+static inline void
+simplequeue_wakeup(simplequeueobject *self)
+{
+    if (self->locked) {
+        self->locked = 0;
+        PyThread_release_lock(self->lock);
+    }
+}
+
 /*[clinic input]
 @classmethod
 _queue.SimpleQueue.__new__ as simplequeue_new
@@ -88,15 +213,17 @@ simplequeue_new_impl(PyTypeObject *type)
     self = (simplequeueobject *) type->tp_alloc(type, 0);
     if (self != NULL) {
         self->weakreflist = NULL;
-        self->lst = PyList_New(0);
+        self->items = NULL;
+        self->items_cap = 0;
+        self->items_head = 0;
+        self->num_items = 0;
         self->lock = PyThread_allocate_lock();
-        self->lst_pos = 0;
         if (self->lock == NULL) {
             Py_DECREF(self);
             PyErr_SetString(PyExc_MemoryError, "can't allocate lock");
             return NULL;
         }
-        if (self->lst == NULL) {
+        if (simplequeue_reserve(self, SIMPLEQUEUE_MINSIZE) < 0) {
             Py_DECREF(self);
             return NULL;
         }
@@ -124,13 +251,11 @@ _queue_SimpleQueue_put_impl(simplequeueobject *self, PyObject *item,
 /*[clinic end generated code: output=4333136e88f90d8b input=6e601fa707a782d5]*/
 {
     /* BEGIN GIL-protected critical section */
-    if (PyList_Append(self->lst, item) < 0)
+    if (simplequeue_reserve(self, 1) < 0)
         return NULL;
-    if (self->locked) {
-        /* A get() may be waiting, wake it up */
-        self->locked = 0;
-        PyThread_release_lock(self->lock);
-    }
+    simplequeue_push_item(self, item);
+    /* A get() may be waiting, wake it up */
+    simplequeue_wakeup(self);
     /* END GIL-protected critical section */
     Py_RETURN_NONE;
 }
@@ -153,61 +278,55 @@ _queue_SimpleQueue_put_nowait_impl(simplequeueobject *self, PyObject *item)
     return _queue_SimpleQueue_put_impl(self, item, 0, Py_None);
 }
 
-static PyObject *
-simplequeue_pop_item(simplequeueobject *self)
-{
-    Py_ssize_t count, n;
-    PyObject *item;
+/*[clinic input]
+_queue.SimpleQueue.put_many
+    items: object
 
-    n = PyList_GET_SIZE(self->lst);
-    assert(self->lst_pos < n);
-
-    item = PyList_GET_ITEM(self->lst, self->lst_pos);
-    Py_INCREF(Py_None);
-    PyList_SET_ITEM(self->lst, self->lst_pos, Py_None);
-    self->lst_pos += 1;
-    count = n - self->lst_pos;
-    if (self->lst_pos > count) {
-        /* The list is more than 50% empty, reclaim space at the beginning */
-        if (PyList_SetSlice(self->lst, 0, self->lst_pos, NULL)) {
-            /* Undo pop */
-            self->lst_pos -= 1;
-            PyList_SET_ITEM(self->lst, self->lst_pos, item);
-            return NULL;
-        }
-        self->lst_pos = 0;
-    }
-    return item;
-}
+Put all the items from an iterable on the queue.
 
-/*[clinic input]
-_queue.SimpleQueue.get
+This method never blocks.
+[clinic start generated code]*/
 
-    cls: defining_class
-    /
-    block: bool = True
-    timeout as timeout_obj: object = None
+static PyObject *
+_queue_SimpleQueue_put_many_impl(simplequeueobject *self, PyObject *items)
+/*[clinic end generated code: output=e2605bbfae9480ca input=0f8a945c19d6d677]*/
+{
+    PyObject *seq, **src;
+    Py_ssize_t n;
 
-Remove and return an item from the queue.
+    seq = PySequence_Fast(items, "put_many() argument must be an iterable");
+    if (seq == NULL) {
+        return NULL;
+    }
+    n = PySequence_Fast_GET_SIZE(seq);
+    src = PySequence_Fast_ITEMS(seq);
 
-If optional args 'block' is true and 'timeout' is None (the default),
-block if necessary until an item is available. If 'timeout' is
-a non-negative number, it blocks at most 'timeout' seconds and raises
-the Empty exception if no item was available within that time.
-Otherwise ('block' is false), return an item if one is immediately
-available, else raise the Empty exception ('timeout' is ignored
-in that case).
+    /* BEGIN GIL-protected critical section */
+    if (simplequeue_reserve(self, n) < 0) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        simplequeue_push_item(self, src[i]);
+    }
+    if (n > 0) {
+        /* A get() may be waiting, wake it up */
+        simplequeue_wakeup(self);
+    }
+    /* END GIL-protected critical section */
 
-[clinic start generated code]*/
+    Py_DECREF(seq);
+    Py_RETURN_NONE;
+}
 
-static PyObject *
-_queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
-                            int block, PyObject *timeout_obj)
-/*[clinic end generated code: output=5c2cca914cd1e55b input=5b4047bfbc645ec1]*/
+/* Wait until the queue is non-empty, following the 'block' and 'timeout'
+   arguments of get().  Raise Empty on timeout. */
+static int
+simplequeue_wait(simplequeueobject *self, PyTypeObject *cls,
+                 int block, PyObject *timeout_obj)
 {
     _PyTime_t endtime = 0;
     _PyTime_t timeout;
-    PyObject *item;
     PyLockStatus r;
     PY_TIMEOUT_T microseconds;
 
@@ -219,19 +338,19 @@ _queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
         /* With timeout */
         if (_PyTime_FromSecondsObject(&timeout,
                                       timeout_obj, _PyTime_ROUND_CEILING) < 0) {
-            return NULL;
+            return -1;
         }
         if (timeout < 0) {
             PyErr_SetString(PyExc_ValueError,
                             "'timeout' must be a non-negative number");
-            return NULL;
+            return -1;
         }
         microseconds = _PyTime_AsMicroseconds(timeout,
                                               _PyTime_ROUND_CEILING);
         if (microseconds > PY_TIMEOUT_MAX) {
             PyErr_SetString(PyExc_OverflowError,
                             "timeout value is too large");
-            return NULL;
+            return -1;
         }
         endtime = _PyDeadline_Init(timeout);
     }
@@ -244,7 +363,7 @@ _queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
      * So we simply try to acquire the lock in a loop, until the condition
      * (queue non-empty) becomes true.
      */
-    while (self->lst_pos == PyList_GET_SIZE(self->lst)) {
+    while (self->num_items == 0) {
         /* First a simple non-blocking try without releasing the GIL */
         r = PyThread_acquire_lock_timed(self->lock, 0, 0);
         if (r == PY_LOCK_FAILURE && microseconds != 0) {
@@ -254,14 +373,14 @@ _queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
         }
 
         if (r == PY_LOCK_INTR && Py_MakePendingCalls() < 0) {
-            return NULL;
+            return -1;
         }
         if (r == PY_LOCK_FAILURE) {
             PyObject *module = PyType_GetModule(cls);
             simplequeue_state *state = simplequeue_get_state(module);
             /* Timed out */
             PyErr_SetNone(state->EmptyError);
-            return NULL;
+            return -1;
         }
         self->locked = 1;
 
@@ -272,10 +391,43 @@ _queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
                                                   _PyTime_ROUND_CEILING);
         }
     }
+    return 0;
+}
+
+/*[clinic input]
+_queue.SimpleQueue.get
+
+    cls: defining_class
+    /
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Remove and return an item from the queue.
+
+If optional args 'block' is true and 'timeout' is None (the default),
+block if necessary until an item is available. If 'timeout' is
+a non-negative number, it blocks at most 'timeout' seconds and raises
+the Empty exception if no item was available within that time.
+Otherwise ('block' is false), return an item if one is immediately
+available, else raise the Empty exception ('timeout' is ignored
+in that case).
+
+[clinic start generated code]*/
+
+static PyObject *
+_queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
+                            int block, PyObject *timeout_obj)
+/*[clinic end generated code: output=5c2cca914cd1e55b input=5b4047bfbc645ec1]*/
+{
+    PyObject *item;
+
+    if (simplequeue_wait(self, cls, block, timeout_obj) < 0) {
+        return NULL;
+    }
 
     /* BEGIN GIL-protected critical section */
-    assert(self->lst_pos < PyList_GET_SIZE(self->lst));
     item = simplequeue_pop_item(self);
+    simplequeue_shrink(self);
     if (self->locked) {
         PyThread_release_lock(self->lock);
         self->locked = 0;
@@ -285,6 +437,76 @@ _queue_SimpleQueue_get_impl(simplequeueobject *self, PyTypeObject *cls,
     return item;
 }
 
+/*[clinic input]
+_queue.SimpleQueue.get_many
+
+    cls: defining_class
+    /
+    max_items: Py_ssize_t(accept={int, NoneType}, c_default="PY_SSIZE_T_MAX") = None
+    block: bool = True
+    timeout as timeout_obj: object = None
+
+Remove and return a list of items from the queue.
+
+Wait for an item to be available as get() does, then return the
+available items, at most 'max_items' of them if it is not None.
+[clinic start generated code]*/
+
+static PyObject *
+_queue_SimpleQueue_get_many_impl(simplequeueobject *self, PyTypeObject *cls,
+                                 Py_ssize_t max_items, int block,
+                                 PyObject *timeout_obj)
+/*[clinic end generated code: output=5db4d0fe54081e21 input=472bdaaa1d6f4734]*/
+{
+    PyObject *result;
+    Py_ssize_t n, mask;
+
+    if (max_items <= 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "'max_items' must be a positive integer or None");
+        return NULL;
+    }
+    /* Allocate the list before waiting: once the queue is non-empty, the
+       items must be moved to it without running any Python code (such as
+       a garbage collection), which could get() them first. */
+    result = PyList_New(0);
+    if (result == NULL) {
+        return NULL;
+    }
+    if (simplequeue_wait(self, cls, block, timeout_obj) < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    /* BEGIN GIL-protected critical section */
+    n = Py_MIN(max_items, self->num_items);
+    if (_PyList_Reserve(result, n) < 0) {
+        /* Leave the items in the queue */
+        Py_CLEAR(result);
+        goto done;
+    }
+    mask = self->items_cap - 1;
+    while (n > 0) {
+        /* Move the items up to the end of the buffer, then wrap around */
+        Py_ssize_t chunk = Py_MIN(n, self->items_cap - self->items_head);
+        (void)_PyList_AppendArrayTakeRefs(result,
+                                          self->items + self->items_head,
+                                          chunk);
+        self->items_head = (self->items_head + chunk) & mask;
+        self->num_items -= chunk;
+        n -= chunk;
+    }
+    simplequeue_shrink(self);
+done:
+    if (self->locked) {
+        PyThread_release_lock(self->lock);
+        self->locked = 0;
+    }
+    /* END GIL-protected critical section */
+
+    return result;
+}
+
 /*[clinic input]
 _queue.SimpleQueue.get_nowait
 
@@ -315,7 +537,7 @@ static int
 _queue_SimpleQueue_empty_impl(simplequeueobject *self)
 /*[clinic end generated code: output=1a02a1b87c0ef838 input=1a98431c45fd66f9]*/
 {
-    return self->lst_pos == PyList_GET_SIZE(self->lst);
+    return self->num_items == 0;
 }
 
 /*[clinic input]
@@ -328,7 +550,7 @@ static Py_ssize_t
 _queue_SimpleQueue_qsize_impl(simplequeueobject *self)
 /*[clinic end generated code: output=f9dcd9d0a90e121e input=7a74852b407868a1]*/
 {
-    return PyList_GET_SIZE(self->lst) - self->lst_pos;
+    return self->num_items;
 }
 
 static int
@@ -361,8 +583,10 @@ queue_free(void *m)
 static PyMethodDef simplequeue_methods[] = {
     _QUEUE_SIMPLEQUEUE_EMPTY_METHODDEF
     _QUEUE_SIMPLEQUEUE_GET_METHODDEF
+    _QUEUE_SIMPLEQUEUE_GET_MANY_METHODDEF
     _QUEUE_SIMPLEQUEUE_GET_NOWAIT_METHODDEF
     _QUEUE_SIMPLEQUEUE_PUT_METHODDEF
+    _QUEUE_SIMPLEQUEUE_PUT_MANY_METHODDEF
     _QUEUE_SIMPLEQUEUE_PUT_NOWAIT_METHODDEF
     _QUEUE_SIMPLEQUEUE_QSIZE_METHODDEF
     {"__class_getitem__",    Py_GenericAlias,
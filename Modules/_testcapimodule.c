@@ -260,6 +260,71 @@ test_list_api(PyObject *self, PyObject *Py_UNUSED(ignored))
     Py_RETURN_NONE;
 }
 
+static PyObject*
+test_list_bulk_api(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+#define NITEMS 10
+    PyObject *items[NITEMS];
+    PyObject *list = NULL;
+    Py_ssize_t i, ncreated;
+
+    for (ncreated = 0; ncreated < NITEMS; ncreated++) {
+        items[ncreated] = PyLong_FromSsize_t(ncreated);
+        if (items[ncreated] == NULL) {
+            goto error;
+        }
+    }
+    list = PyList_New(0);
+    if (list == NULL) {
+        goto error;
+    }
+    if (_PyList_Reserve(list, NITEMS) < 0) {
+        goto error;
+    }
+    if (PyList_GET_SIZE(list) != 0
+        || ((PyListObject *)list)->allocated < NITEMS)
+    {
+        PyErr_SetString(TestError, "_PyList_Reserve: wrong size");
+        goto error;
+    }
+    for (i = 0; i < 3; i++) {
+        if (_PyList_AppendArray(list, items, NITEMS) < 0) {
+            goto error;
+        }
+    }
+    if (PyList_GET_SIZE(list) != 3 * NITEMS) {
+        PyErr_SetString(TestError, "_PyList_AppendArray: wrong size");
+        goto error;
+    }
+    for (i = 0; i < 3 * NITEMS; i++) {
+        if (PyList_GET_ITEM(list, i) != items[i % NITEMS]) {
+            PyErr_SetString(TestError, "_PyList_AppendArray: wrong item");
+            goto error;
+        }
+    }
+    if (_PyList_Reserve(list, -1) == 0
+        || !PyErr_ExceptionMatches(PyExc_ValueError))
+    {
+        PyErr_SetString(TestError, "_PyList_Reserve: accepted -1");
+        goto error;
+    }
+    PyErr_Clear();
+
+    Py_DECREF(list);
+    for (i = 0; i < NITEMS; i++) {
+        Py_DECREF(items[i]);
+    }
+    Py_RETURN_NONE;
+
+error:
+    Py_XDECREF(list);
+    for (i = 0; i < ncreated; i++) {
+        Py_DECREF(items[i]);
+    }
+    return NULL;
+#undef NITEMS
+}
+
 static int
 test_dict_inner(int count)
 {
@@ -5798,6 +5863,7 @@ static PyMethodDef TestMethods[] = {
     {"PyDateTime_DELTA_GET",       test_PyDateTime_DELTA_GET,     METH_O},
     {"test_gc_control",         test_gc_control,                 METH_NOARGS},
     {"test_list_api",           test_list_api,                   METH_NOARGS},
+    {"test_list_bulk_api",      test_list_bulk_api,              METH_NOARGS},
     {"test_dict_iteration",     test_dict_iteration,             METH_NOARGS},
     {"dict_getitem_knownhash",  dict_getitem_knownhash,          METH_VARARGS},
     {"test_lazy_hash_inheritance",      test_lazy_hash_inheritance,METH_NOARGS},
@@ -6871,6 +6937,9 @@ PyInit__testcapi(void)
     if (_PyTestCapi_Init_Heaptype(m) < 0) {
         return NULL;
     }
+    if (_PyTestCapi_Init_Watchers(m) < 0) {
+        return NULL;
+    }
 
     PyState_AddModule(m, &_testcapimodule);
     return m;
@@ -293,22 +293,23 @@ _asyncio_Future__make_cancelled_error(FutureObj *self, PyObject *Py_UNUSED(ignor
 }
 
 PyDoc_STRVAR(_asyncio_Task___init____doc__,
-"Task(coro, *, loop=None, name=None, context=None)\n"
+"Task(coro, *, loop=None, name=None, context=None, eager_start=False)\n"
 "--\n"
 "\n"
 "A coroutine wrapped in a Future.");
 
 static int
 _asyncio_Task___init___impl(TaskObj *self, PyObject *coro, PyObject *loop,
-                            PyObject *name, PyObject *context);
+                            PyObject *name, PyObject *context,
+                            int eager_start);
 
 static int
 _asyncio_Task___init__(PyObject *self, PyObject *args, PyObject *kwargs)
 {
     int return_value = -1;
-    static const char * const _keywords[] = {"coro", "loop", "name", "context", NULL};
+    static const char * const _keywords[] = {"coro", "loop", "name", "context", "eager_start", NULL};
     static _PyArg_Parser _parser = {NULL, _keywords, "Task", 0};
-    PyObject *argsbuf[4];
+    PyObject *argsbuf[5];
     PyObject * const *fastargs;
     Py_ssize_t nargs = PyTuple_GET_SIZE(args);
     Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 1;
@@ -316,6 +317,7 @@ _asyncio_Task___init__(PyObject *self, PyObject *args, PyObject *kwargs)
     PyObject *loop = Py_None;
     PyObject *name = Py_None;
     PyObject *context = Py_None;
+    int eager_start = 0;
 
     fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser, 1, 1, 0, argsbuf);
     if (!fastargs) {
@@ -337,9 +339,18 @@ _asyncio_Task___init__(PyObject *self, PyObject *args, PyObject *kwargs)
             goto skip_optional_kwonly;
         }
     }
-    context = fastargs[3];
+    if (fastargs[3]) {
+        context = fastargs[3];
+        if (!--noptargs) {
+            goto skip_optional_kwonly;
+        }
+    }
+    eager_start = PyObject_IsTrue(fastargs[4]);
+    if (eager_start < 0) {
+        goto exit;
+    }
 skip_optional_kwonly:
-    return_value = _asyncio_Task___init___impl((TaskObj *)self, coro, loop, name, context);
+    return_value = _asyncio_Task___init___impl((TaskObj *)self, coro, loop, name, context, eager_start);
 
 exit:
     return return_value;
@@ -815,6 +826,74 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_asyncio__register_eager_task__doc__,
+"_register_eager_task($module, /, task)\n"
+"--\n"
+"\n"
+"Register a new task that is being run eagerly.\n"
+"\n"
+"Returns None.");
+
+#define _ASYNCIO__REGISTER_EAGER_TASK_METHODDEF    \
+    {"_register_eager_task", _PyCFunction_CAST(_asyncio__register_eager_task), METH_FASTCALL|METH_KEYWORDS, _asyncio__register_eager_task__doc__},
+
+static PyObject *
+_asyncio__register_eager_task_impl(PyObject *module, PyObject *task);
+
+static PyObject *
+_asyncio__register_eager_task(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"task", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "_register_eager_task", 0};
+    PyObject *argsbuf[1];
+    PyObject *task;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    task = args[0];
+    return_value = _asyncio__register_eager_task_impl(module, task);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio__unregister_eager_task__doc__,
+"_unregister_eager_task($module, /, task)\n"
+"--\n"
+"\n"
+"Unregister a task that was being run eagerly.\n"
+"\n"
+"Returns None.");
+
+#define _ASYNCIO__UNREGISTER_EAGER_TASK_METHODDEF    \
+    {"_unregister_eager_task", _PyCFunction_CAST(_asyncio__unregister_eager_task), METH_FASTCALL|METH_KEYWORDS, _asyncio__unregister_eager_task__doc__},
+
+static PyObject *
+_asyncio__unregister_eager_task_impl(PyObject *module, PyObject *task);
+
+static PyObject *
+_asyncio__unregister_eager_task(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"task", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "_unregister_eager_task", 0};
+    PyObject *argsbuf[1];
+    PyObject *task;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    task = args[0];
+    return_value = _asyncio__unregister_eager_task_impl(module, task);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(_asyncio__enter_task__doc__,
 "_enter_task($module, /, loop, task)\n"
 "--\n"
@@ -890,4 +969,291 @@ _asyncio__leave_task(PyObject *module, PyObject *const *args, Py_ssize_t nargs,
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=b4e678c915567934 input=a9049054013a1b77]*/
+
+PyDoc_STRVAR(_asyncio__swap_current_task__doc__,
+"_swap_current_task($module, /, loop, task)\n"
+"--\n"
+"\n"
+"Temporarily swap in the supplied task and return the original one (or None).\n"
+"\n"
+"This is intended for use during eager coroutine execution.");
+
+#define _ASYNCIO__SWAP_CURRENT_TASK_METHODDEF    \
+    {"_swap_current_task", _PyCFunction_CAST(_asyncio__swap_current_task), METH_FASTCALL|METH_KEYWORDS, _asyncio__swap_current_task__doc__},
+
+static PyObject *
+_asyncio__swap_current_task_impl(PyObject *module, PyObject *loop,
+                                 PyObject *task);
+
+static PyObject *
+_asyncio__swap_current_task(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"loop", "task", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "_swap_current_task", 0};
+    PyObject *argsbuf[2];
+    PyObject *loop;
+    PyObject *task;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 2, 2, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    loop = args[0];
+    task = args[1];
+    return_value = _asyncio__swap_current_task_impl(module, loop, task);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_all_tasks__doc__,
+"all_tasks($module, /, loop=None)\n"
+"--\n"
+"\n"
+"Return a set of all tasks for the loop.");
+
+#define _ASYNCIO_ALL_TASKS_METHODDEF    \
+    {"all_tasks", _PyCFunction_CAST(_asyncio_all_tasks), METH_FASTCALL|METH_KEYWORDS, _asyncio_all_tasks__doc__},
+
+static PyObject *
+_asyncio_all_tasks_impl(PyObject *module, PyObject *loop);
+
+static PyObject *
+_asyncio_all_tasks(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"loop", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "all_tasks", 0};
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    PyObject *loop = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    loop = args[0];
+skip_optional_pos:
+    return_value = _asyncio_all_tasks_impl(module, loop);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_Handle___init____doc__,
+"Handle(callback, args, loop, context=None)\n"
+"--\n"
+"\n"
+"Object returned by callback registration methods.");
+
+static int
+_asyncio_Handle___init___impl(HandleObj *self, PyObject *callback,
+                              PyObject *args, PyObject *loop,
+                              PyObject *context);
+
+static int
+_asyncio_Handle___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+    static const char * const _keywords[] = {"callback", "args", "loop", "context", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "Handle", 0};
+    PyObject *argsbuf[4];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 3;
+    PyObject *callback;
+    PyObject *__clinic_args;
+    PyObject *loop;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser, 3, 4, 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    callback = fastargs[0];
+    __clinic_args = fastargs[1];
+    loop = fastargs[2];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    context = fastargs[3];
+skip_optional_pos:
+    return_value = _asyncio_Handle___init___impl((HandleObj *)self, callback, __clinic_args, loop, context);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_Handle_cancel__doc__,
+"cancel($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_asyncio_Handle_cancel, METH_NOARGS, _asyncio_Handle_cancel__doc__},
+
+static PyObject *
+_asyncio_Handle_cancel_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_cancel(HandleObj *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle_cancel_impl(self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle_cancelled__doc__,
+"cancelled($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_CANCELLED_METHODDEF    \
+    {"cancelled", (PyCFunction)_asyncio_Handle_cancelled, METH_NOARGS, _asyncio_Handle_cancelled__doc__},
+
+static PyObject *
+_asyncio_Handle_cancelled_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_cancelled(HandleObj *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle_cancelled_impl(self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle__run__doc__,
+"_run($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE__RUN_METHODDEF    \
+    {"_run", (PyCFunction)_asyncio_Handle__run, METH_NOARGS, _asyncio_Handle__run__doc__},
+
+static PyObject *
+_asyncio_Handle__run_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle__run(HandleObj *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle__run_impl(self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle__repr_info__doc__,
+"_repr_info($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE__REPR_INFO_METHODDEF    \
+    {"_repr_info", (PyCFunction)_asyncio_Handle__repr_info, METH_NOARGS, _asyncio_Handle__repr_info__doc__},
+
+static PyObject *
+_asyncio_Handle__repr_info_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle__repr_info(HandleObj *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle__repr_info_impl(self);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle___init____doc__,
+"TimerHandle(when, callback, args, loop, context=None)\n"
+"--\n"
+"\n"
+"Object returned by timed callback registration methods.");
+
+static int
+_asyncio_TimerHandle___init___impl(TimerHandleObj *self, PyObject *when,
+                                   PyObject *callback, PyObject *args,
+                                   PyObject *loop, PyObject *context);
+
+static int
+_asyncio_TimerHandle___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+    static const char * const _keywords[] = {"when", "callback", "args", "loop", "context", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "TimerHandle", 0};
+    PyObject *argsbuf[5];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 4;
+    PyObject *when;
+    PyObject *callback;
+    PyObject *__clinic_args;
+    PyObject *loop;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser, 4, 5, 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    when = fastargs[0];
+    callback = fastargs[1];
+    __clinic_args = fastargs[2];
+    loop = fastargs[3];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    context = fastargs[4];
+skip_optional_pos:
+    return_value = _asyncio_TimerHandle___init___impl((TimerHandleObj *)self, when, callback, __clinic_args, loop, context);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle_cancel__doc__,
+"cancel($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_TIMERHANDLE_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_asyncio_TimerHandle_cancel, METH_NOARGS, _asyncio_TimerHandle_cancel__doc__},
+
+static PyObject *
+_asyncio_TimerHandle_cancel_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle_cancel(TimerHandleObj *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_TimerHandle_cancel_impl(self);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle_when__doc__,
+"when($self, /)\n"
+"--\n"
+"\n"
+"Return a scheduled callback time.\n"
+"\n"
+"The time is an absolute timestamp, using the same time\n"
+"reference as loop.time().");
+
+#define _ASYNCIO_TIMERHANDLE_WHEN_METHODDEF    \
+    {"when", (PyCFunction)_asyncio_TimerHandle_when, METH_NOARGS, _asyncio_TimerHandle_when__doc__},
+
+static PyObject *
+_asyncio_TimerHandle_when_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle_when(TimerHandleObj *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_TimerHandle_when_impl(self);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle__repr_info__doc__,
+"_repr_info($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_TIMERHANDLE__REPR_INFO_METHODDEF    \
+    {"_repr_info", (PyCFunction)_asyncio_TimerHandle__repr_info, METH_NOARGS, _asyncio_TimerHandle__repr_info__doc__},
+
+static PyObject *
+_asyncio_TimerHandle__repr_info_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle__repr_info(TimerHandleObj *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_TimerHandle__repr_info_impl(self);
+}
+/*[clinic end generated code: output=0d30706d01b06f44 input=a9049054013a1b77]*/
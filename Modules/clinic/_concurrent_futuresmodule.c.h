@@ -0,0 +1,355 @@
+/*[clinic input]
+preserve
+[clinic start generated code]*/
+
+PyDoc_STRVAR(_concurrent_futures_Future___init____doc__,
+"Future()\n"
+"--\n"
+"\n"
+"Initializes the future. Should not be called by clients.");
+
+static int
+_concurrent_futures_Future___init___impl(futureobject *self);
+
+static int
+_concurrent_futures_Future___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+
+    if ((Py_IS_TYPE(self, futures_get_state_by_type(Py_TYPE(self))->FutureType) ||
+         Py_TYPE(self)->tp_new == futures_get_state_by_type(Py_TYPE(self))->FutureType->tp_new) &&
+        !_PyArg_NoPositional("Future", args)) {
+        goto exit;
+    }
+    if ((Py_IS_TYPE(self, futures_get_state_by_type(Py_TYPE(self))->FutureType) ||
+         Py_TYPE(self)->tp_new == futures_get_state_by_type(Py_TYPE(self))->FutureType->tp_new) &&
+        !_PyArg_NoKeywords("Future", kwargs)) {
+        goto exit;
+    }
+    return_value = _concurrent_futures_Future___init___impl((futureobject *)self);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_cancel__doc__,
+"cancel($self, /)\n"
+"--\n"
+"\n"
+"Cancel the future if possible.\n"
+"\n"
+"Returns True if the future was cancelled, False otherwise. A future\n"
+"cannot be cancelled if it is running or has already completed.");
+
+#define _CONCURRENT_FUTURES_FUTURE_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_concurrent_futures_Future_cancel, METH_NOARGS, _concurrent_futures_Future_cancel__doc__},
+
+static PyObject *
+_concurrent_futures_Future_cancel_impl(futureobject *self);
+
+static PyObject *
+_concurrent_futures_Future_cancel(futureobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _concurrent_futures_Future_cancel_impl(self);
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_cancelled__doc__,
+"cancelled($self, /)\n"
+"--\n"
+"\n"
+"Return True if the future was cancelled.");
+
+#define _CONCURRENT_FUTURES_FUTURE_CANCELLED_METHODDEF    \
+    {"cancelled", (PyCFunction)_concurrent_futures_Future_cancelled, METH_NOARGS, _concurrent_futures_Future_cancelled__doc__},
+
+static PyObject *
+_concurrent_futures_Future_cancelled_impl(futureobject *self);
+
+static PyObject *
+_concurrent_futures_Future_cancelled(futureobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _concurrent_futures_Future_cancelled_impl(self);
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_running__doc__,
+"running($self, /)\n"
+"--\n"
+"\n"
+"Return True if the future is currently executing.");
+
+#define _CONCURRENT_FUTURES_FUTURE_RUNNING_METHODDEF    \
+    {"running", (PyCFunction)_concurrent_futures_Future_running, METH_NOARGS, _concurrent_futures_Future_running__doc__},
+
+static PyObject *
+_concurrent_futures_Future_running_impl(futureobject *self);
+
+static PyObject *
+_concurrent_futures_Future_running(futureobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _concurrent_futures_Future_running_impl(self);
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_done__doc__,
+"done($self, /)\n"
+"--\n"
+"\n"
+"Return True if the future was cancelled or finished executing.");
+
+#define _CONCURRENT_FUTURES_FUTURE_DONE_METHODDEF    \
+    {"done", (PyCFunction)_concurrent_futures_Future_done, METH_NOARGS, _concurrent_futures_Future_done__doc__},
+
+static PyObject *
+_concurrent_futures_Future_done_impl(futureobject *self);
+
+static PyObject *
+_concurrent_futures_Future_done(futureobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _concurrent_futures_Future_done_impl(self);
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_add_done_callback__doc__,
+"add_done_callback($self, fn, /)\n"
+"--\n"
+"\n"
+"Attaches a callable that will be called when the future finishes.\n"
+"\n"
+"fn will be called with this future as its only argument when the future\n"
+"completes or is cancelled. The callable will always be called by a\n"
+"thread in the same process in which it was added. If the future has\n"
+"already completed or been cancelled then the callable will be called\n"
+"immediately. These callables are called in the order that they were\n"
+"added.");
+
+#define _CONCURRENT_FUTURES_FUTURE_ADD_DONE_CALLBACK_METHODDEF    \
+    {"add_done_callback", (PyCFunction)_concurrent_futures_Future_add_done_callback, METH_O, _concurrent_futures_Future_add_done_callback__doc__},
+
+PyDoc_STRVAR(_concurrent_futures_Future_result__doc__,
+"result($self, /, timeout=None)\n"
+"--\n"
+"\n"
+"Return the result of the call that the future represents.\n"
+"\n"
+"timeout is the number of seconds to wait for the result if the future\n"
+"isn\'t done. If None, then there is no limit on the wait time.\n"
+"\n"
+"Raises CancelledError if the future was cancelled, TimeoutError if the\n"
+"future didn\'t finish executing before the given timeout, and the\n"
+"exception raised by the call if any.");
+
+#define _CONCURRENT_FUTURES_FUTURE_RESULT_METHODDEF    \
+    {"result", _PyCFunction_CAST(_concurrent_futures_Future_result), METH_FASTCALL|METH_KEYWORDS, _concurrent_futures_Future_result__doc__},
+
+static PyObject *
+_concurrent_futures_Future_result_impl(futureobject *self, PyObject *timeout);
+
+static PyObject *
+_concurrent_futures_Future_result(futureobject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"timeout", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "result", 0};
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    PyObject *timeout = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    timeout = args[0];
+skip_optional_pos:
+    return_value = _concurrent_futures_Future_result_impl(self, timeout);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_exception__doc__,
+"exception($self, /, timeout=None)\n"
+"--\n"
+"\n"
+"Return the exception raised by the call that the future represents.\n"
+"\n"
+"timeout is the number of seconds to wait for the exception if the future\n"
+"isn\'t done. If None, then there is no limit on the wait time.\n"
+"\n"
+"Return None if the call completed without raising.  Raises\n"
+"CancelledError if the future was cancelled, and TimeoutError if the\n"
+"future didn\'t finish executing before the given timeout.");
+
+#define _CONCURRENT_FUTURES_FUTURE_EXCEPTION_METHODDEF    \
+    {"exception", _PyCFunction_CAST(_concurrent_futures_Future_exception), METH_FASTCALL|METH_KEYWORDS, _concurrent_futures_Future_exception__doc__},
+
+static PyObject *
+_concurrent_futures_Future_exception_impl(futureobject *self,
+                                          PyObject *timeout);
+
+static PyObject *
+_concurrent_futures_Future_exception(futureobject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"timeout", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "exception", 0};
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    PyObject *timeout = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    timeout = args[0];
+skip_optional_pos:
+    return_value = _concurrent_futures_Future_exception_impl(self, timeout);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_set_running_or_notify_cancel__doc__,
+"set_running_or_notify_cancel($self, /)\n"
+"--\n"
+"\n"
+"Mark the future as running or process any cancel notifications.\n"
+"\n"
+"Should only be used by Executor implementations and unit tests.\n"
+"\n"
+"If the future has been cancelled (cancel() was called and returned\n"
+"True) then any threads waiting on the future completing (though calls\n"
+"to as_completed() or wait()) are notified and False is returned.\n"
+"\n"
+"If the future was not cancelled then it is put in the running state\n"
+"(future calls to running() will return True) and True is returned.\n"
+"\n"
+"This method should be called by Executor implementations before\n"
+"executing the work associated with this future. If this method returns\n"
+"False then the work should not be executed.\n"
+"\n"
+"Raises RuntimeError if this method was already called or if set_result()\n"
+"or set_exception() was called.");
+
+#define _CONCURRENT_FUTURES_FUTURE_SET_RUNNING_OR_NOTIFY_CANCEL_METHODDEF    \
+    {"set_running_or_notify_cancel", (PyCFunction)_concurrent_futures_Future_set_running_or_notify_cancel, METH_NOARGS, _concurrent_futures_Future_set_running_or_notify_cancel__doc__},
+
+static PyObject *
+_concurrent_futures_Future_set_running_or_notify_cancel_impl(futureobject *self);
+
+static PyObject *
+_concurrent_futures_Future_set_running_or_notify_cancel(futureobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _concurrent_futures_Future_set_running_or_notify_cancel_impl(self);
+}
+
+PyDoc_STRVAR(_concurrent_futures_Future_set_result__doc__,
+"set_result($self, result, /)\n"
+"--\n"
+"\n"
+"Sets the return value of work associated with the future.\n"
+"\n"
+"Should only be used by Executor implementations and unit tests.");
+
+#define _CONCURRENT_FUTURES_FUTURE_SET_RESULT_METHODDEF    \
+    {"set_result", (PyCFunction)_concurrent_futures_Future_set_result, METH_O, _concurrent_futures_Future_set_result__doc__},
+
+PyDoc_STRVAR(_concurrent_futures_Future_set_exception__doc__,
+"set_exception($self, exception, /)\n"
+"--\n"
+"\n"
+"Sets the result of the future as being the given exception.\n"
+"\n"
+"Should only be used by Executor implementations and unit tests.");
+
+#define _CONCURRENT_FUTURES_FUTURE_SET_EXCEPTION_METHODDEF    \
+    {"set_exception", (PyCFunction)_concurrent_futures_Future_set_exception, METH_O, _concurrent_futures_Future_set_exception__doc__},
+
+PyDoc_STRVAR(_concurrent_futures_Future__invoke_callbacks__doc__,
+"_invoke_callbacks($self, /)\n"
+"--\n"
+"\n");
+
+#define _CONCURRENT_FUTURES_FUTURE__INVOKE_CALLBACKS_METHODDEF    \
+    {"_invoke_callbacks", (PyCFunction)_concurrent_futures_Future__invoke_callbacks, METH_NOARGS, _concurrent_futures_Future__invoke_callbacks__doc__},
+
+static PyObject *
+_concurrent_futures_Future__invoke_callbacks_impl(futureobject *self);
+
+static PyObject *
+_concurrent_futures_Future__invoke_callbacks(futureobject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _concurrent_futures_Future__invoke_callbacks_impl(self);
+}
+
+PyDoc_STRVAR(workitem_new__doc__,
+"_WorkItem(future, fn, args, kwargs, /)\n"
+"--\n"
+"\n"
+"A call to run in a ThreadPoolExecutor worker thread.");
+
+static PyObject *
+workitem_new_impl(PyTypeObject *type, PyObject *future, PyObject *fn,
+                  PyObject *call_args, PyObject *call_kwargs);
+
+static PyObject *
+workitem_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *future;
+    PyObject *fn;
+    PyObject *call_args;
+    PyObject *call_kwargs;
+
+    if ((type == futures_get_state_by_type(type)->WorkItemType ||
+         type->tp_init == futures_get_state_by_type(type)->WorkItemType->tp_init) &&
+        !_PyArg_NoKeywords("_WorkItem", kwargs)) {
+        goto exit;
+    }
+    if (!_PyArg_CheckPositional("_WorkItem", PyTuple_GET_SIZE(args), 4, 4)) {
+        goto exit;
+    }
+    future = PyTuple_GET_ITEM(args, 0);
+    fn = PyTuple_GET_ITEM(args, 1);
+    if (!PyTuple_Check(PyTuple_GET_ITEM(args, 2))) {
+        _PyArg_BadArgument("_WorkItem", "argument 3", "tuple", PyTuple_GET_ITEM(args, 2));
+        goto exit;
+    }
+    call_args = PyTuple_GET_ITEM(args, 2);
+    if (!PyDict_Check(PyTuple_GET_ITEM(args, 3))) {
+        _PyArg_BadArgument("_WorkItem", "argument 4", "dict", PyTuple_GET_ITEM(args, 3));
+        goto exit;
+    }
+    call_kwargs = PyTuple_GET_ITEM(args, 3);
+    return_value = workitem_new_impl(type, future, fn, call_args, call_kwargs);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_concurrent_futures__WorkItem_run__doc__,
+"run($self, /)\n"
+"--\n"
+"\n"
+"Run the call and set the result or exception of the future.");
+
+#define _CONCURRENT_FUTURES__WORKITEM_RUN_METHODDEF    \
+    {"run", _PyCFunction_CAST(_concurrent_futures__WorkItem_run), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _concurrent_futures__WorkItem_run__doc__},
+
+static PyObject *
+_concurrent_futures__WorkItem_run_impl(workitemobject *self,
+                                       PyTypeObject *cls);
+
+static PyObject *
+_concurrent_futures__WorkItem_run(workitemobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    if (nargs) {
+        PyErr_SetString(PyExc_TypeError, "run() takes no arguments");
+        return NULL;
+    }
+    return _concurrent_futures__WorkItem_run_impl(self, cls);
+}
+/*[clinic end generated code: output=bc46156c47949176 input=a9049054013a1b77]*/
@@ -120,6 +120,40 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_queue_SimpleQueue_put_many__doc__,
+"put_many($self, /, items)\n"
+"--\n"
+"\n"
+"Put all the items from an iterable on the queue.\n"
+"\n"
+"This method never blocks.");
+
+#define _QUEUE_SIMPLEQUEUE_PUT_MANY_METHODDEF    \
+    {"put_many", _PyCFunction_CAST(_queue_SimpleQueue_put_many), METH_FASTCALL|METH_KEYWORDS, _queue_SimpleQueue_put_many__doc__},
+
+static PyObject *
+_queue_SimpleQueue_put_many_impl(simplequeueobject *self, PyObject *items);
+
+static PyObject *
+_queue_SimpleQueue_put_many(simplequeueobject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"items", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "put_many", 0};
+    PyObject *argsbuf[1];
+    PyObject *items;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 1, 1, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    items = args[0];
+    return_value = _queue_SimpleQueue_put_many_impl(self, items);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(_queue_SimpleQueue_get__doc__,
 "get($self, /, block=True, timeout=None)\n"
 "--\n"
@@ -176,6 +210,67 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_queue_SimpleQueue_get_many__doc__,
+"get_many($self, /, max_items=None, block=True, timeout=None)\n"
+"--\n"
+"\n"
+"Remove and return a list of items from the queue.\n"
+"\n"
+"Wait for an item to be available as get() does, then return the\n"
+"available items, at most \'max_items\' of them if it is not None.");
+
+#define _QUEUE_SIMPLEQUEUE_GET_MANY_METHODDEF    \
+    {"get_many", _PyCFunction_CAST(_queue_SimpleQueue_get_many), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _queue_SimpleQueue_get_many__doc__},
+
+static PyObject *
+_queue_SimpleQueue_get_many_impl(simplequeueobject *self, PyTypeObject *cls,
+                                 Py_ssize_t max_items, int block,
+                                 PyObject *timeout_obj);
+
+static PyObject *
+_queue_SimpleQueue_get_many(simplequeueobject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"max_items", "block", "timeout", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "get_many", 0};
+    PyObject *argsbuf[3];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    Py_ssize_t max_items = PY_SSIZE_T_MAX;
+    int block = 1;
+    PyObject *timeout_obj = Py_None;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 3, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[0]) {
+        if (!_Py_convert_optional_to_ssize_t(args[0], &max_items)) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    if (args[1]) {
+        block = PyObject_IsTrue(args[1]);
+        if (block < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    timeout_obj = args[2];
+skip_optional_pos:
+    return_value = _queue_SimpleQueue_get_many_impl(self, cls, max_items, block, timeout_obj);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(_queue_SimpleQueue_get_nowait__doc__,
 "get_nowait($self, /)\n"
 "--\n"
@@ -257,4 +352,4 @@ _queue_SimpleQueue_qsize(simplequeueobject *self, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=88ec8033aeb7241c input=a9049054013a1b77]*/
+/*[clinic end generated code: output=9c5e23cc340e3d15 input=a9049054013a1b77]*/
@@ -266,6 +266,11 @@ shutdown(how) -- shut down traffic in one or both directions\n\
 
 #  include <fcntl.h>
 
+/* UDP_SEGMENT and UDP_GRO */
+#ifdef __linux__
+#  include <netinet/udp.h>
+#endif
+
 #else
 
 /* MS_WINDOWS includes */
@@ -4266,6 +4271,149 @@ SCM_RIGHTS mechanism.");
 #endif    /* CMSG_LEN */
 
 
+#ifdef HAVE_RECVMMSG
+struct sock_recvmmsg {
+    struct mmsghdr *msgvec;
+    unsigned int vlen;
+    int flags;
+    int result;
+};
+
+static int
+sock_recvmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_recvmmsg *ctx = data;
+
+    ctx->result = recvmmsg(s->sock_fd, ctx->msgvec, ctx->vlen, ctx->flags,
+                           NULL);
+    return (ctx->result >= 0);
+}
+
+/* s.recvmmsg_into(buffers[, flags]) method */
+
+static PyObject *
+sock_recvmmsg_into(PySocketSockObject *s, PyObject *args)
+{
+    int flags = 0;
+    socklen_t addrbuflen;
+    Py_ssize_t i, nitems, nbufs = 0;
+    struct mmsghdr *msgvec = NULL;
+    struct iovec *iovs = NULL;
+    sock_addr_t *addrbufs = NULL;
+    Py_buffer *bufs = NULL;
+    PyObject *buffers_arg, *fast, *retval = NULL;
+    struct sock_recvmmsg ctx;
+
+    if (!PyArg_ParseTuple(args, "O|i:recvmmsg_into", &buffers_arg, &flags))
+        return NULL;
+
+    if ((fast = PySequence_Fast(buffers_arg,
+                                "recvmmsg_into() argument 1 must be an "
+                                "iterable")) == NULL)
+        return NULL;
+    nitems = PySequence_Fast_GET_SIZE(fast);
+    if (nitems > INT_MAX) {
+        PyErr_SetString(PyExc_OSError,
+                        "recvmmsg_into() argument 1 is too long");
+        goto finally;
+    }
+    if (!getsockaddrlen(s, &addrbuflen))
+        goto finally;
+
+    /* Each buffer receives one datagram into a single iovec, and gets its
+       own address buffer.  Save the Py_buffer structs to release
+       afterwards. */
+    if (nitems > 0 && ((msgvec = PyMem_Calloc(nitems,
+                                              sizeof(struct mmsghdr))) == NULL ||
+                       (iovs = PyMem_New(struct iovec, nitems)) == NULL ||
+                       (addrbufs = PyMem_New(sock_addr_t, nitems)) == NULL ||
+                       (bufs = PyMem_New(Py_buffer, nitems)) == NULL)) {
+        PyErr_NoMemory();
+        goto finally;
+    }
+    for (; nbufs < nitems; nbufs++) {
+        struct msghdr *msg = &msgvec[nbufs].msg_hdr;
+
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(fast, nbufs),
+                         "w*;recvmmsg_into() argument 1 must be an iterable "
+                         "of single-segment read-write buffers",
+                         &bufs[nbufs]))
+            goto finally;
+        iovs[nbufs].iov_base = bufs[nbufs].buf;
+        iovs[nbufs].iov_len = bufs[nbufs].len;
+
+        /* See the comment about msg_name in sock_recvmsg_guts(). */
+        memset(&addrbufs[nbufs], 0, addrbuflen);
+        SAS2SA(&addrbufs[nbufs])->sa_family = AF_UNSPEC;
+        msg->msg_name = SAS2SA(&addrbufs[nbufs]);
+        msg->msg_namelen = addrbuflen;
+        msg->msg_iov = &iovs[nbufs];
+        msg->msg_iovlen = 1;
+    }
+
+    if (!IS_SELECTABLE(s)) {
+        select_error();
+        goto finally;
+    }
+
+    ctx.msgvec = msgvec;
+    ctx.vlen = (unsigned int)nitems;
+    ctx.flags = flags;
+#ifdef MSG_WAITFORONE
+    /* Don't block once the first datagram has been received. */
+    ctx.flags |= MSG_WAITFORONE;
+#endif
+    if (sock_call(s, 0, sock_recvmmsg_impl, &ctx) < 0)
+        goto finally;
+
+    if ((retval = PyList_New(ctx.result)) == NULL)
+        goto finally;
+    for (i = 0; i < ctx.result; i++) {
+        struct msghdr *msg = &msgvec[i].msg_hdr;
+        PyObject *item;
+
+        item = Py_BuildValue("nN",
+                             (Py_ssize_t)msgvec[i].msg_len,
+                             makesockaddr(s->sock_fd, msg->msg_name,
+                                          ((msg->msg_namelen > addrbuflen) ?
+                                           addrbuflen : msg->msg_namelen),
+                                          s->sock_proto));
+        if (item == NULL) {
+            Py_CLEAR(retval);
+            goto finally;
+        }
+        PyList_SET_ITEM(retval, i, item);
+    }
+
+finally:
+    for (i = 0; i < nbufs; i++)
+        PyBuffer_Release(&bufs[i]);
+    PyMem_Free(bufs);
+    PyMem_Free(addrbufs);
+    PyMem_Free(iovs);
+    PyMem_Free(msgvec);
+    Py_DECREF(fast);
+    return retval;
+}
+
+PyDoc_STRVAR(recvmmsg_into_doc,
+"recvmmsg_into(buffers[, flags]) -> list of (nbytes, address)\n\
+\n\
+Receive several datagrams from the socket with a single system call.\n\
+The buffers argument must be an iterable of objects that export\n\
+writable buffers (e.g. bytearray objects or memoryview slices); each\n\
+buffer receives at most one datagram, and the part of a datagram which\n\
+does not fit into its buffer is discarded.  The flags argument\n\
+defaults to 0 and has the same meaning as for recv().  Once a first\n\
+datagram has been received, the call doesn't wait for more.\n\
+\n\
+The return value is a list with one (nbytes, address) tuple per\n\
+datagram received, in the order of the buffers they were written to.\n\
+nbytes is the number of bytes written into the buffer and address is\n\
+the address of the sending socket.");
+#endif    /* HAVE_RECVMMSG */
+
+
 struct sock_send {
     char *buf;
     Py_ssize_t len;
@@ -4779,6 +4927,125 @@ the message.  The return value is the number of bytes of non-ancillary\n\
 data sent.");
 #endif    /* CMSG_LEN */
 
+
+#ifdef HAVE_SENDMMSG
+struct sock_sendmmsg {
+    struct mmsghdr *msgvec;
+    unsigned int vlen;
+    int flags;
+    int result;
+};
+
+static int
+sock_sendmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_sendmmsg *ctx = data;
+
+    ctx->result = sendmmsg(s->sock_fd, ctx->msgvec, ctx->vlen, ctx->flags);
+    return (ctx->result >= 0);
+}
+
+/* s.sendmmsg(buffers[, flags[, address]]) method */
+
+static PyObject *
+sock_sendmmsg(PySocketSockObject *s, PyObject *args)
+{
+    int addrlen = 0, flags = 0;
+    sock_addr_t addrbuf;
+    Py_ssize_t i, nitems, nbufs = 0;
+    struct mmsghdr *msgvec = NULL;
+    struct iovec *iovs = NULL;
+    Py_buffer *bufs = NULL;
+    PyObject *data_arg, *addr_arg = NULL, *fast = NULL, *retval = NULL;
+    struct sock_sendmmsg ctx;
+
+    if (!PyArg_ParseTuple(args, "O|iO:sendmmsg",
+                          &data_arg, &flags, &addr_arg)) {
+        return NULL;
+    }
+
+    /* Parse destination address. */
+    if (addr_arg != NULL && addr_arg != Py_None) {
+        if (!getsockaddrarg(s, addr_arg, &addrbuf, &addrlen, "sendmmsg")) {
+            return NULL;
+        }
+    }
+    else {
+        addr_arg = Py_None;
+    }
+    if (PySys_Audit("socket.sendmmsg", "OO", s, addr_arg) < 0) {
+        return NULL;
+    }
+
+    fast = PySequence_Fast(data_arg,
+                           "sendmmsg() argument 1 must be an iterable");
+    if (fast == NULL) {
+        return NULL;
+    }
+    nitems = PySequence_Fast_GET_SIZE(fast);
+    if (nitems > INT_MAX) {
+        PyErr_SetString(PyExc_OSError, "sendmmsg() argument 1 is too long");
+        goto finally;
+    }
+
+    /* Each buffer is sent as a separate datagram.  Save the Py_buffer
+       structs to release afterwards. */
+    if (nitems > 0 && ((msgvec = PyMem_Calloc(nitems,
+                                              sizeof(struct mmsghdr))) == NULL ||
+                       (iovs = PyMem_New(struct iovec, nitems)) == NULL ||
+                       (bufs = PyMem_New(Py_buffer, nitems)) == NULL)) {
+        PyErr_NoMemory();
+        goto finally;
+    }
+    for (; nbufs < nitems; nbufs++) {
+        struct msghdr *msg = &msgvec[nbufs].msg_hdr;
+
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(fast, nbufs),
+                         "y*;sendmmsg() argument 1 must be an iterable of "
+                         "bytes-like objects",
+                         &bufs[nbufs]))
+            goto finally;
+        iovs[nbufs].iov_base = bufs[nbufs].buf;
+        iovs[nbufs].iov_len = bufs[nbufs].len;
+
+        if (addrlen > 0) {
+            msg->msg_name = SAS2SA(&addrbuf);
+            msg->msg_namelen = addrlen;
+        }
+        msg->msg_iov = &iovs[nbufs];
+        msg->msg_iovlen = 1;
+    }
+
+    ctx.msgvec = msgvec;
+    ctx.vlen = (unsigned int)nitems;
+    ctx.flags = flags;
+    if (sock_call(s, 1, sock_sendmmsg_impl, &ctx) < 0)
+        goto finally;
+
+    retval = PyLong_FromLong(ctx.result);
+
+finally:
+    for (i = 0; i < nbufs; i++)
+        PyBuffer_Release(&bufs[i]);
+    PyMem_Free(bufs);
+    PyMem_Free(iovs);
+    PyMem_Free(msgvec);
+    Py_DECREF(fast);
+    return retval;
+}
+
+PyDoc_STRVAR(sendmmsg_doc,
+"sendmmsg(buffers[, flags[, address]]) -> count\n\
+\n\
+Send several datagrams to the socket with a single system call.  The\n\
+buffers argument is an iterable of bytes-like objects, each of which\n\
+is sent as a separate datagram.  The flags argument defaults to 0 and\n\
+has the same meaning as for send().  If address is supplied and not\n\
+None, it sets the destination address of all the datagrams.  The\n\
+return value is the number of datagrams sent, which may be less than\n\
+the number of buffers.");
+#endif    /* HAVE_SENDMMSG */
+
 #ifdef HAVE_SOCKADDR_ALG
 static PyObject*
 sock_sendmsg_afalg(PySocketSockObject *self, PyObject *args, PyObject *kwds)
@@ -5144,6 +5411,14 @@ static PyMethodDef sock_methods[] = {
     {"sendmsg",           (PyCFunction)sock_sendmsg, METH_VARARGS,
                       sendmsg_doc},
 #endif
+#ifdef HAVE_RECVMMSG
+    {"recvmmsg_into",     (PyCFunction)sock_recvmmsg_into, METH_VARARGS,
+                      recvmmsg_into_doc},
+#endif
+#ifdef HAVE_SENDMMSG
+    {"sendmmsg",          (PyCFunction)sock_sendmmsg, METH_VARARGS,
+                      sendmmsg_doc},
+#endif
 #ifdef HAVE_SOCKADDR_ALG
     {"sendmsg_afalg",     _PyCFunction_CAST(sock_sendmsg_afalg), METH_VARARGS | METH_KEYWORDS,
                       sendmsg_afalg_doc},
@@ -8142,6 +8417,12 @@ PyInit__socket(void)
     #endif
     PyModule_AddIntMacro(m, UDPLITE_RECV_CSCOV);
 #endif
+#ifdef  UDP_SEGMENT
+    PyModule_AddIntMacro(m, UDP_SEGMENT);
+#endif
+#ifdef  UDP_GRO
+    PyModule_AddIntMacro(m, UDP_GRO);
+#endif
 #ifdef  IPPROTO_IDP
     PyModule_AddIntMacro(m, IPPROTO_IDP);
 #endif
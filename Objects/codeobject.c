@@ -11,6 +11,88 @@
 #include "pycore_tuple.h"         // _PyTuple_ITEMS()
 #include "clinic/codeobject.c.h"
 
+static const char *
+code_event_name(PyCodeEvent event) {
+    switch (event) {
+        case PY_CODE_EVENT_CREATE:
+            return "PY_CODE_EVENT_CREATE";
+        case PY_CODE_EVENT_DESTROY:
+            return "PY_CODE_EVENT_DESTROY";
+    }
+    Py_UNREACHABLE();
+}
+
+static void
+notify_code_watchers(PyCodeEvent event, PyCodeObject *co)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (!interp->active_code_watchers) {
+        return;
+    }
+    /* The event may happen while an exception is being raised */
+    PyObject *exc_type, *exc_value, *exc_tb;
+    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+    uint8_t bits = interp->active_code_watchers;
+    int i = 0;
+    while (bits) {
+        assert(i < CODE_MAX_WATCHERS);
+        if (bits & 1) {
+            PyCode_WatchCallback cb = interp->code_watchers[i];
+            // callback must be non-null if the watcher bit is set
+            assert(cb != NULL);
+            if (cb(event, co) < 0) {
+                // Like for dict watchers, don't pass the code object as
+                // context: the unraisablehook could resurrect it.
+                PyObject *context = PyUnicode_FromFormat(
+                    "%s watcher callback for <code object %U at %p>",
+                    code_event_name(event), co->co_name, co);
+                if (context == NULL) {
+                    context = Py_NewRef(Py_None);
+                }
+                PyErr_WriteUnraisable(context);
+                Py_DECREF(context);
+            }
+        }
+        i++;
+        bits >>= 1;
+    }
+    PyErr_Restore(exc_type, exc_value, exc_tb);
+}
+
+int
+PyCode_AddWatcher(PyCode_WatchCallback callback)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    for (int i = 0; i < CODE_MAX_WATCHERS; i++) {
+        if (!interp->code_watchers[i]) {
+            interp->code_watchers[i] = callback;
+            interp->active_code_watchers |= (1 << i);
+            return i;
+        }
+    }
+    PyErr_SetString(PyExc_RuntimeError, "no more code watcher IDs available");
+    return -1;
+}
+
+int
+PyCode_ClearWatcher(int watcher_id)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (watcher_id < 0 || watcher_id >= CODE_MAX_WATCHERS) {
+        PyErr_Format(PyExc_ValueError, "invalid code watcher ID %d",
+                     watcher_id);
+        return -1;
+    }
+    if (!interp->code_watchers[watcher_id]) {
+        PyErr_Format(PyExc_ValueError, "no code watcher set for ID %d",
+                     watcher_id);
+        return -1;
+    }
+    interp->code_watchers[watcher_id] = NULL;
+    interp->active_code_watchers &= ~(1 << watcher_id);
+    return 0;
+}
+
 
 /******************
  * generic helpers
@@ -488,6 +570,7 @@ _PyCode_New(struct _PyCodeConstructor *con)
     }
     init_code(co, con);
     Py_XDECREF(replacement_locations);
+    notify_code_watchers(PY_CODE_EVENT_CREATE, co);
     return co;
 }
 
@@ -1593,6 +1676,17 @@ code_new_impl(PyTypeObject *type, int argcount, int posonlyargcount,
 static void
 code_dealloc(PyCodeObject *co)
 {
+    assert(Py_REFCNT(co) == 0);
+    if (_PyInterpreterState_GET()->active_code_watchers) {
+        /* The watchers may resurrect the code object */
+        Py_SET_REFCNT(co, 1);
+        notify_code_watchers(PY_CODE_EVENT_DESTROY, co);
+        if (Py_REFCNT(co) > 1) {
+            Py_SET_REFCNT(co, Py_REFCNT(co) - 1);
+            return;
+        }
+        Py_SET_REFCNT(co, 0);
+    }
     if (co->co_extra != NULL) {
         PyInterpreterState *interp = _PyInterpreterState_GET();
         _PyCodeObjectExtra *co_extra = co->co_extra;
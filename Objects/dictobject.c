@@ -30,6 +30,9 @@ As of Python 3.6, this is compact and ordered. Basic idea is described here:
 | dk_entries[]        |
 |                     |
 +---------------------+
+| dk_tags[]           |
+| (large generic only)|
++---------------------+
 
 dk_indices is actual hashtable.  It holds index in entries, or DKIX_EMPTY(-1)
 or DKIX_DUMMY(-2).
@@ -43,6 +46,10 @@ Size of indices is dk_size.  Type of each index in indices is vary on dk_size:
 dk_entries is array of PyDictKeyEntry when dk_kind == DICT_KEYS_GENERAL or
 PyDictUnicodeEntry otherwise. Its length is USABLE_FRACTION(dk_size).
 
+dk_tags is only present in DICT_KEYS_GENERAL tables with
+dk_size >= 2**DK_LOG2_TAGS_MINSIZE.  It holds one byte per slot of dk_indices,
+derived from the hash of the entry the slot points to (see DK_TAGS()).
+
 NOTE: Since negative value is used for DKIX_EMPTY and DKIX_DUMMY, type of
 dk_indices entry is signed integer and int16 is used for table which
 dk_size == 256.
@@ -118,6 +125,7 @@ As a consequence of this, split keys have a maximum size of 16.
 #include "pycore_code.h"          // stats
 #include "pycore_dict.h"          // PyDictKeysObject
 #include "pycore_gc.h"            // _PyObject_GC_IS_TRACKED()
+#include "pycore_long.h"          // _PyLong_ExactEqual()
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_pyerrors.h"      // _PyErr_Fetch()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
@@ -289,6 +297,18 @@ unicode_get_hash(PyObject *o)
     return _PyASCIIObject_CAST(o)->hash;
 }
 
+/* Called when a key is added to or deleted from the combined table of mp.
+   The keys version of a dict watched by the specializer is kept, since the
+   index of the other keys does not change: its watcher resets the version
+   itself when needed. */
+static inline void
+reset_keys_version(PyDictObject *mp)
+{
+    if (mp->ma_values != NULL || !_PyDict_IsWatchedBySpecializer(mp)) {
+        mp->ma_keys->dk_version = 0;
+    }
+}
+
 /* Print summary info about the state of the optimized allocator */
 void
 _PyDict_DebugMallocStats(FILE *out)
@@ -361,7 +381,8 @@ dictkeys_set_index(PyDictKeysObject *keys, Py_ssize_t i, Py_ssize_t ix)
     int log2size = DK_LOG_SIZE(keys);
 
     assert(ix >= DKIX_DUMMY);
-    assert(keys->dk_version == 0);
+    /* The keys version is reset, except by reset_keys_version() for the
+       dicts watched by the specializer */
 
     if (log2size < 8) {
         int8_t *indices = (int8_t*)(keys->dk_indices);
@@ -400,6 +421,49 @@ dictkeys_set_index(PyDictKeysObject *keys, Py_ssize_t i, Py_ssize_t ix)
  */
 #define USABLE_FRACTION(n) (((n) << 1)/3)
 
+/* Large generic (non-unicode) tables keep a byte of hash "tag" per index
+ * slot, stored after dk_entries.  When probing, the tag is compared before
+ * the entry is dereferenced, so collisions with unrelated keys are rejected
+ * without touching dk_entries, which no longer fits in the CPU caches for
+ * tables of this size.  The tag is derived from all the bits of the hash, as
+ * the hashes of ints only vary in their low bits.  Tags are only meaningful
+ * for slots holding an index >= 0.
+ */
+#define DK_LOG2_TAGS_MINSIZE 14
+
+#define DK_HAS_TAGS(dk) \
+    ((dk)->dk_kind == DICT_KEYS_GENERAL && \
+     DK_LOG_SIZE(dk) >= DK_LOG2_TAGS_MINSIZE)
+
+#define DK_TAGS(dk) \
+    (assert(DK_HAS_TAGS(dk)), \
+     (uint8_t *)(DK_ENTRIES(dk) + USABLE_FRACTION(DK_SIZE(dk))))
+
+#if SIZEOF_SIZE_T > 4
+#  define DK_TAG_MULTIPLIER ((size_t)0x9E3779B97F4A7C15)
+#else
+#  define DK_TAG_MULTIPLIER ((size_t)0x9E3779B9)
+#endif
+
+static inline uint8_t
+dictkeys_hash_tag(Py_hash_t hash)
+{
+    return (uint8_t)(((size_t)hash * DK_TAG_MULTIPLIER) >> (SIZEOF_SIZE_T*8 - 8));
+}
+
+/* Write an index of dk_entries to a generic table, and its tag if the
+   table has tags. */
+static inline void
+dictkeys_set_generic_index(PyDictKeysObject *keys, Py_ssize_t i,
+                           Py_ssize_t ix, Py_hash_t hash)
+{
+    assert(ix >= 0);
+    dictkeys_set_index(keys, i, ix);
+    if (DK_HAS_TAGS(keys)) {
+        DK_TAGS(keys)[i] = dictkeys_hash_tag(hash);
+    }
+}
+
 /* Find the smallest dk_size >= minsize. */
 static inline uint8_t
 calculate_log2_keysize(Py_ssize_t minsize)
@@ -531,6 +595,10 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
         for (Py_ssize_t i=0; i < DK_SIZE(keys); i++) {
             Py_ssize_t ix = dictkeys_get_index(keys, i);
             CHECK(DKIX_DUMMY <= ix && ix <= usable);
+            if (ix >= 0 && DK_HAS_TAGS(keys)) {
+                Py_hash_t hash = DK_ENTRIES(keys)[ix].me_hash;
+                CHECK(DK_TAGS(keys)[i] == dictkeys_hash_tag(hash));
+            }
         }
 
         if (keys->dk_kind == DICT_KEYS_GENERAL) {
@@ -629,9 +697,14 @@ new_keys_object(uint8_t log2_size, bool unicode)
     else
 #endif
     {
+        size_t tags_size = 0;
+        if (!unicode && log2_size >= DK_LOG2_TAGS_MINSIZE) {
+            tags_size = (size_t)1 << log2_size;
+        }
         dk = PyObject_Malloc(sizeof(PyDictKeysObject)
                              + ((size_t)1 << log2_bytes)
-                             + entry_size * usable);
+                             + entry_size * usable
+                             + tags_size);
         if (dk == NULL) {
             PyErr_NoMemory();
             return NULL;
@@ -953,10 +1026,65 @@ unicodekeys_lookup_unicode(PyDictKeysObject* dk, PyObject *key, Py_hash_t hash)
     Py_UNREACHABLE();
 }
 
+// Search key from large Generic table, filtering slots with their hash tag.
+static Py_ssize_t
+dictkeys_generic_lookup_tagged(PyDictObject *mp, PyDictKeysObject* dk, PyObject *key, Py_hash_t hash)
+{
+    PyDictKeyEntry *ep0 = DK_ENTRIES(dk);
+    const uint8_t *tags = DK_TAGS(dk);
+    const uint8_t tag = dictkeys_hash_tag(hash);
+    size_t mask = DK_MASK(dk);
+    size_t perturb = hash;
+    size_t i = (size_t)hash & mask;
+    Py_ssize_t ix;
+    for (;;) {
+        ix = dictkeys_get_index(dk, i);
+        if (ix >= 0) {
+            if (tags[i] == tag) {
+                PyDictKeyEntry *ep = &ep0[ix];
+                assert(ep->me_key != NULL);
+                if (ep->me_key == key) {
+                    return ix;
+                }
+                if (ep->me_hash == hash) {
+                    if (_PyLong_ExactEqual(ep->me_key, key)) {
+                        return ix;
+                    }
+                    PyObject *startkey = ep->me_key;
+                    Py_INCREF(startkey);
+                    int cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
+                    Py_DECREF(startkey);
+                    if (cmp < 0) {
+                        return DKIX_ERROR;
+                    }
+                    if (dk == mp->ma_keys && ep->me_key == startkey) {
+                        if (cmp > 0) {
+                            return ix;
+                        }
+                    }
+                    else {
+                        /* The dict was mutated, restart */
+                        return DKIX_KEY_CHANGED;
+                    }
+                }
+            }
+        }
+        else if (ix == DKIX_EMPTY) {
+            return DKIX_EMPTY;
+        }
+        perturb >>= PERTURB_SHIFT;
+        i = mask & (i*5 + perturb + 1);
+    }
+    Py_UNREACHABLE();
+}
+
 // Search key from Generic table.
 static Py_ssize_t
 dictkeys_generic_lookup(PyDictObject *mp, PyDictKeysObject* dk, PyObject *key, Py_hash_t hash)
 {
+    if (DK_HAS_TAGS(dk)) {
+        return dictkeys_generic_lookup_tagged(mp, dk, key, hash);
+    }
     PyDictKeyEntry *ep0 = DK_ENTRIES(dk);
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
@@ -971,6 +1099,9 @@ dictkeys_generic_lookup(PyDictObject *mp, PyDictKeysObject* dk, PyObject *key, P
                 return ix;
             }
             if (ep->me_hash == hash) {
+                if (_PyLong_ExactEqual(ep->me_key, key)) {
+                    return ix;
+                }
                 PyObject *startkey = ep->me_key;
                 Py_INCREF(startkey);
                 int cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
@@ -1240,8 +1371,10 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
     MAINTAIN_TRACKING(mp, key, value);
 
     if (ix == DKIX_EMPTY) {
+        uint64_t new_version = _PyDict_NotifyEvent(
+                PyDict_EVENT_ADDED, mp, key, value);
         /* Insert into new slot. */
-        mp->ma_keys->dk_version = 0;
+        reset_keys_version(mp);
         assert(old_value == NULL);
         if (mp->ma_keys->dk_usable <= 0) {
             /* Need to resize. */
@@ -1250,9 +1383,9 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
         }
 
         Py_ssize_t hashpos = find_empty_slot(mp->ma_keys, hash);
-        dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
 
         if (DK_IS_UNICODE(mp->ma_keys)) {
+            dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
             PyDictUnicodeEntry *ep;
             ep = &DK_UNICODE_ENTRIES(mp->ma_keys)[mp->ma_keys->dk_nentries];
             ep->me_key = key;
@@ -1267,6 +1400,8 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
             }
         }
         else {
+            dictkeys_set_generic_index(mp->ma_keys, hashpos,
+                                       mp->ma_keys->dk_nentries, hash);
             PyDictKeyEntry *ep;
             ep = &DK_ENTRIES(mp->ma_keys)[mp->ma_keys->dk_nentries];
             ep->me_key = key;
@@ -1274,7 +1409,7 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
             ep->me_value = value;
         }
         mp->ma_used++;
-        mp->ma_version_tag = DICT_NEXT_VERSION();
+        mp->ma_version_tag = new_version;
         mp->ma_keys->dk_usable--;
         mp->ma_keys->dk_nentries++;
         assert(mp->ma_keys->dk_usable >= 0);
@@ -1283,6 +1418,9 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
     }
 
     if (old_value != value) {
+        uint64_t new_version = _PyDict_NotifyEvent(
+                old_value == NULL ? PyDict_EVENT_ADDED : PyDict_EVENT_MODIFIED,
+                mp, key, value);
         if (_PyDict_HasSplitTable(mp)) {
             mp->ma_values->values[ix] = value;
             if (old_value == NULL) {
@@ -1299,7 +1437,7 @@ insertdict(PyDictObject *mp, PyObject *key, Py_hash_t hash, PyObject *value)
                 DK_ENTRIES(mp->ma_keys)[ix].me_value = value;
             }
         }
-        mp->ma_version_tag = DICT_NEXT_VERSION();
+        mp->ma_version_tag = new_version;
     }
     Py_XDECREF(old_value); /* which **CAN** re-enter (see issue #22653) */
     ASSERT_CONSISTENT(mp);
@@ -1320,6 +1458,9 @@ insert_to_emptydict(PyDictObject *mp, PyObject *key, Py_hash_t hash,
 {
     assert(mp->ma_keys == Py_EMPTY_KEYS);
 
+    uint64_t new_version = _PyDict_NotifyEvent(
+            PyDict_EVENT_ADDED, mp, key, value);
+
     int unicode = PyUnicode_CheckExact(key);
     PyDictKeysObject *newkeys = new_keys_object(PyDict_LOG_MINSIZE, unicode);
     if (newkeys == NULL) {
@@ -1347,7 +1488,7 @@ insert_to_emptydict(PyDictObject *mp, PyObject *key, Py_hash_t hash,
         ep->me_value = value;
     }
     mp->ma_used++;
-    mp->ma_version_tag = DICT_NEXT_VERSION();
+    mp->ma_version_tag = new_version;
     mp->ma_keys->dk_usable--;
     mp->ma_keys->dk_nentries++;
     return 0;
@@ -1367,7 +1508,7 @@ build_indices_generic(PyDictKeysObject *keys, PyDictKeyEntry *ep, Py_ssize_t n)
             perturb >>= PERTURB_SHIFT;
             i = mask & (i*5 + perturb + 1);
         }
-        dictkeys_set_index(keys, i, ix);
+        dictkeys_set_generic_index(keys, i, ix, hash);
     }
 }
 
@@ -1948,7 +2089,7 @@ delete_index_from_values(PyDictValues *values, Py_ssize_t ix)
 
 static int
 delitem_common(PyDictObject *mp, Py_hash_t hash, Py_ssize_t ix,
-               PyObject *old_value)
+               PyObject *old_value, uint64_t new_version)
 {
     PyObject *old_key;
 
@@ -1956,7 +2097,7 @@ delitem_common(PyDictObject *mp, Py_hash_t hash, Py_ssize_t ix,
     assert(hashpos >= 0);
 
     mp->ma_used--;
-    mp->ma_version_tag = DICT_NEXT_VERSION();
+    mp->ma_version_tag = new_version;
     if (mp->ma_values) {
         assert(old_value == mp->ma_values->values[ix]);
         mp->ma_values->values[ix] = NULL;
@@ -1966,7 +2107,7 @@ delitem_common(PyDictObject *mp, Py_hash_t hash, Py_ssize_t ix,
         ASSERT_CONSISTENT(mp);
     }
     else {
-        mp->ma_keys->dk_version = 0;
+        reset_keys_version(mp);
         dictkeys_set_index(mp->ma_keys, hashpos, DKIX_DUMMY);
         if (DK_IS_UNICODE(mp->ma_keys)) {
             PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(mp->ma_keys)[ix];
@@ -2025,7 +2166,9 @@ _PyDict_DelItem_KnownHash(PyObject *op, PyObject *key, Py_hash_t hash)
         return -1;
     }
 
-    return delitem_common(mp, hash, ix, old_value);
+    uint64_t new_version = _PyDict_NotifyEvent(
+            PyDict_EVENT_DELETED, mp, key, NULL);
+    return delitem_common(mp, hash, ix, old_value, new_version);
 }
 
 /* This function promises that the predicate -> deletion sequence is atomic
@@ -2066,8 +2209,11 @@ _PyDict_DelItemIf(PyObject *op, PyObject *key,
     hashpos = lookdict_index(mp->ma_keys, hash, ix);
     assert(hashpos >= 0);
 
-    if (res > 0)
-        return delitem_common(mp, hashpos, ix, old_value);
+    if (res > 0) {
+        uint64_t new_version = _PyDict_NotifyEvent(
+                PyDict_EVENT_DELETED, mp, key, NULL);
+        return delitem_common(mp, hashpos, ix, old_value, new_version);
+    }
     else
         return 0;
 }
@@ -2090,11 +2236,13 @@ PyDict_Clear(PyObject *op)
         return;
     }
     /* Empty the dict... */
+    uint64_t new_version = _PyDict_NotifyEvent(
+            PyDict_EVENT_CLEARED, mp, NULL, NULL);
     dictkeys_incref(Py_EMPTY_KEYS);
     mp->ma_keys = Py_EMPTY_KEYS;
     mp->ma_values = NULL;
     mp->ma_used = 0;
-    mp->ma_version_tag = DICT_NEXT_VERSION();
+    mp->ma_version_tag = new_version;
     /* ...then clear the keys and values */
     if (oldvalues != NULL) {
         n = oldkeys->dk_nentries;
@@ -2233,8 +2381,10 @@ _PyDict_Pop_KnownHash(PyObject *dict, PyObject *key, Py_hash_t hash, PyObject *d
         return NULL;
     }
     assert(old_value != NULL);
+    uint64_t new_version = _PyDict_NotifyEvent(
+            PyDict_EVENT_DELETED, mp, key, NULL);
     Py_INCREF(old_value);
-    delitem_common(mp, hash, ix, old_value);
+    delitem_common(mp, hash, ix, old_value, new_version);
 
     ASSERT_CONSISTENT(mp);
     return old_value;
@@ -2359,6 +2509,17 @@ _PyDict_FromKeys(PyObject *cls, PyObject *iterable, PyObject *value)
 static void
 dict_dealloc(PyDictObject *mp)
 {
+    assert(Py_REFCNT(mp) == 0);
+    if (mp->ma_version_tag & DICT_VERSION_MASK) {
+        /* The watchers may resurrect the dict */
+        Py_SET_REFCNT(mp, 1);
+        _PyDict_NotifyEvent(PyDict_EVENT_DEALLOCATED, mp, NULL, NULL);
+        if (Py_REFCNT(mp) > 1) {
+            Py_SET_REFCNT(mp, Py_REFCNT(mp) - 1);
+            return;
+        }
+        Py_SET_REFCNT(mp, 0);
+    }
     PyDictValues *values = mp->ma_values;
     PyDictKeysObject *keys = mp->ma_keys;
     Py_ssize_t i, n;
@@ -2847,6 +3008,8 @@ dict_merge(PyObject *a, PyObject *b, int override)
                     other->ma_used == okeys->dk_nentries &&
                     (DK_LOG_SIZE(okeys) == PyDict_LOG_MINSIZE ||
                      USABLE_FRACTION(DK_SIZE(okeys)/2) < other->ma_used)) {
+                uint64_t new_version = _PyDict_NotifyEvent(
+                        PyDict_EVENT_CLONED, mp, b, NULL);
                 PyDictKeysObject *keys = clone_combined_dict_keys(other);
                 if (keys == NULL) {
                     return -1;
@@ -2860,7 +3023,7 @@ dict_merge(PyObject *a, PyObject *b, int override)
                 }
 
                 mp->ma_used = other->ma_used;
-                mp->ma_version_tag = DICT_NEXT_VERSION();
+                mp->ma_version_tag = new_version;
                 ASSERT_CONSISTENT(mp);
 
                 if (_PyObject_GC_IS_TRACKED(other) && !_PyObject_GC_IS_TRACKED(mp)) {
@@ -3332,7 +3495,9 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
         return NULL;
 
     if (ix == DKIX_EMPTY) {
-        mp->ma_keys->dk_version = 0;
+        uint64_t new_version = _PyDict_NotifyEvent(
+                PyDict_EVENT_ADDED, mp, key, defaultobj);
+        reset_keys_version(mp);
         value = defaultobj;
         if (mp->ma_keys->dk_usable <= 0) {
             if (insertion_resize(mp, 1) < 0) {
@@ -3340,8 +3505,8 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
             }
         }
         Py_ssize_t hashpos = find_empty_slot(mp->ma_keys, hash);
-        dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
         if (DK_IS_UNICODE(mp->ma_keys)) {
+            dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
             assert(PyUnicode_CheckExact(key));
             PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(mp->ma_keys)[mp->ma_keys->dk_nentries];
             ep->me_key = key;
@@ -3357,6 +3522,8 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
             }
         }
         else {
+            dictkeys_set_generic_index(mp->ma_keys, hashpos,
+                                       mp->ma_keys->dk_nentries, hash);
             PyDictKeyEntry *ep = &DK_ENTRIES(mp->ma_keys)[mp->ma_keys->dk_nentries];
             ep->me_key = key;
             ep->me_hash = hash;
@@ -3366,12 +3533,14 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
         Py_INCREF(value);
         MAINTAIN_TRACKING(mp, key, value);
         mp->ma_used++;
-        mp->ma_version_tag = DICT_NEXT_VERSION();
+        mp->ma_version_tag = new_version;
         mp->ma_keys->dk_usable--;
         mp->ma_keys->dk_nentries++;
         assert(mp->ma_keys->dk_usable >= 0);
     }
     else if (value == NULL) {
+        uint64_t new_version = _PyDict_NotifyEvent(
+                PyDict_EVENT_ADDED, mp, key, defaultobj);
         value = defaultobj;
         assert(_PyDict_HasSplitTable(mp));
         assert(mp->ma_values->values[ix] == NULL);
@@ -3380,7 +3549,7 @@ PyDict_SetDefault(PyObject *d, PyObject *key, PyObject *defaultobj)
         mp->ma_values->values[ix] = value;
         _PyDictValues_AddToInsertionOrder(mp->ma_values, ix);
         mp->ma_used++;
-        mp->ma_version_tag = DICT_NEXT_VERSION();
+        mp->ma_version_tag = new_version;
     }
 
     ASSERT_CONSISTENT(mp);
@@ -3483,6 +3652,7 @@ dict_popitem_impl(PyDictObject *self)
     /* Pop last item */
     PyObject *key, *value;
     Py_hash_t hash;
+    uint64_t new_version;
     if (DK_IS_UNICODE(self->ma_keys)) {
         PyDictUnicodeEntry *ep0 = DK_UNICODE_ENTRIES(self->ma_keys);
         i = self->ma_keys->dk_nentries - 1;
@@ -3492,6 +3662,8 @@ dict_popitem_impl(PyDictObject *self)
         assert(i >= 0);
 
         key = ep0[i].me_key;
+        new_version = _PyDict_NotifyEvent(
+                PyDict_EVENT_DELETED, self, key, NULL);
         hash = unicode_get_hash(key);
         value = ep0[i].me_value;
         ep0[i].me_key = NULL;
@@ -3506,6 +3678,8 @@ dict_popitem_impl(PyDictObject *self)
         assert(i >= 0);
 
         key = ep0[i].me_key;
+        new_version = _PyDict_NotifyEvent(
+                PyDict_EVENT_DELETED, self, key, NULL);
         hash = ep0[i].me_hash;
         value = ep0[i].me_value;
         ep0[i].me_key = NULL;
@@ -3523,7 +3697,7 @@ dict_popitem_impl(PyDictObject *self)
     /* We can't dk_usable++ since there is DKIX_DUMMY in indices */
     self->ma_keys->dk_nentries = i;
     self->ma_used--;
-    self->ma_version_tag = DICT_NEXT_VERSION();
+    self->ma_version_tag = new_version;
     ASSERT_CONSISTENT(self);
     return res;
 }
@@ -3591,9 +3765,11 @@ _PyDict_KeysSize(PyDictKeysObject *keys)
 {
     size_t es = keys->dk_kind == DICT_KEYS_GENERAL
         ?  sizeof(PyDictKeyEntry) : sizeof(PyDictUnicodeEntry);
+    size_t tags_size = DK_HAS_TAGS(keys) ? (size_t)DK_SIZE(keys) : 0;
     return (sizeof(PyDictKeysObject)
             + ((size_t)1 << keys->dk_log2_index_bytes)
-            + USABLE_FRACTION(DK_SIZE(keys)) * es);
+            + USABLE_FRACTION(DK_SIZE(keys)) * es
+            + tags_size);
 }
 
 static PyObject *
@@ -5740,3 +5916,161 @@ uint32_t _PyDictKeys_GetVersionForCurrentState(PyDictKeysObject *dictkeys)
     dictkeys->dk_version = v;
     return v;
 }
+
+
+/* Dictionary watchers */
+
+void
+_PyDict_WatchForSpecializer(PyDictObject *mp)
+{
+    assert(_PyInterpreterState_GET()->dict_state.watchers[DICT_SPECIALIZER_WATCHER]);
+    if (!_PyDict_IsWatchedBySpecializer(mp)) {
+        /* The specializations made so far assumed that adding a key resets
+           the keys version */
+        _PyDict_ResetKeysVersion(mp);
+        mp->ma_version_tag |= (1LL << DICT_SPECIALIZER_WATCHER);
+    }
+}
+
+void
+_PyDict_ResetKeysVersion(PyDictObject *mp)
+{
+    if (mp->ma_keys != Py_EMPTY_KEYS) {
+        mp->ma_keys->dk_version = 0;
+    }
+}
+
+static int
+validate_watcher_id(PyInterpreterState *interp, int watcher_id)
+{
+    if (watcher_id < 0 || watcher_id >= DICT_MAX_WATCHERS) {
+        PyErr_Format(PyExc_ValueError, "Invalid dict watcher ID %d", watcher_id);
+        return -1;
+    }
+    /* Only _PyDict_WatchForSpecializer() may set the specializer's bit:
+       it resets the keys version that LOAD_GLOBAL caches depend on. */
+    if (watcher_id == DICT_SPECIALIZER_WATCHER) {
+        PyErr_Format(PyExc_ValueError,
+                     "Dict watcher ID %d is used by the interpreter",
+                     watcher_id);
+        return -1;
+    }
+    if (!interp->dict_state.watchers[watcher_id]) {
+        PyErr_Format(PyExc_ValueError, "No dict watcher set for ID %d", watcher_id);
+        return -1;
+    }
+    return 0;
+}
+
+int
+PyDict_Watch(int watcher_id, PyObject* dict)
+{
+    if (!PyDict_Check(dict)) {
+        PyErr_SetString(PyExc_ValueError, "Cannot watch non-dictionary");
+        return -1;
+    }
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (validate_watcher_id(interp, watcher_id)) {
+        return -1;
+    }
+    ((PyDictObject*)dict)->ma_version_tag |= (1LL << watcher_id);
+    return 0;
+}
+
+int
+PyDict_Unwatch(int watcher_id, PyObject* dict)
+{
+    if (!PyDict_Check(dict)) {
+        PyErr_SetString(PyExc_ValueError, "Cannot watch non-dictionary");
+        return -1;
+    }
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (validate_watcher_id(interp, watcher_id)) {
+        return -1;
+    }
+    ((PyDictObject*)dict)->ma_version_tag &= ~(1LL << watcher_id);
+    return 0;
+}
+
+int
+PyDict_AddWatcher(PyDict_WatchCallback callback)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+
+    for (int i = 0; i < DICT_MAX_WATCHERS; i++) {
+        if (i == DICT_SPECIALIZER_WATCHER) {
+            continue;
+        }
+        if (!interp->dict_state.watchers[i]) {
+            interp->dict_state.watchers[i] = callback;
+            return i;
+        }
+    }
+
+    PyErr_SetString(PyExc_RuntimeError, "no more dict watcher IDs available");
+    return -1;
+}
+
+int
+PyDict_ClearWatcher(int watcher_id)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (validate_watcher_id(interp, watcher_id)) {
+        return -1;
+    }
+    interp->dict_state.watchers[watcher_id] = NULL;
+    return 0;
+}
+
+static const char *
+dict_event_name(PyDict_WatchEvent event) {
+    switch (event) {
+        case PyDict_EVENT_ADDED:
+            return "PyDict_EVENT_ADDED";
+        case PyDict_EVENT_MODIFIED:
+            return "PyDict_EVENT_MODIFIED";
+        case PyDict_EVENT_DELETED:
+            return "PyDict_EVENT_DELETED";
+        case PyDict_EVENT_CLONED:
+            return "PyDict_EVENT_CLONED";
+        case PyDict_EVENT_CLEARED:
+            return "PyDict_EVENT_CLEARED";
+        case PyDict_EVENT_DEALLOCATED:
+            return "PyDict_EVENT_DEALLOCATED";
+    }
+    Py_UNREACHABLE();
+}
+
+void
+_PyDict_SendEvent(int watcher_bits,
+                  PyDict_WatchEvent event,
+                  PyDictObject *mp,
+                  PyObject *key,
+                  PyObject *value)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    /* The event may happen while an exception is being raised */
+    PyObject *exc_type, *exc_value, *exc_tb;
+    PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+    for (int i = 0; i < DICT_MAX_WATCHERS; i++) {
+        if (watcher_bits & 1) {
+            PyDict_WatchCallback cb = interp->dict_state.watchers[i];
+            if (cb && (cb(event, (PyObject*)mp, key, value) < 0)) {
+                // We don't want to resurrect the dict by potentially having an
+                // unraisablehook keep a reference to it, so we don't pass the
+                // dict as context, just an informative string message.  Dict
+                // repr can call arbitrary code, so we invent a simpler version.
+                PyObject *context = PyUnicode_FromFormat(
+                    "%s watcher callback for <dict at %p>",
+                    dict_event_name(event), mp);
+                if (context == NULL) {
+                    context = Py_NewRef(Py_None);
+                }
+                PyErr_WriteUnraisable(context);
+                Py_DECREF(context);
+            }
+        }
+        watcher_bits >>= 1;
+    }
+    PyErr_Restore(exc_type, exc_value, exc_tb);
+}
@@ -88,6 +88,32 @@ list_resize(PyListObject *self, Py_ssize_t newsize)
     return 0;
 }
 
+static int
+list_preallocate_exact(PyListObject *self, Py_ssize_t size);
+
+/* Make room for n more items without changing the size of the list.
+   An empty list is allocated exactly, otherwise the list is over-allocated
+   as for an append. */
+static int
+list_reserve(PyListObject *self, Py_ssize_t n)
+{
+    Py_ssize_t m = Py_SIZE(self);
+    assert(n >= 0);
+    assert(m <= PY_SSIZE_T_MAX - n);
+    if (n <= self->allocated - m) {
+        return 0;
+    }
+    if (self->ob_item == NULL) {
+        return list_preallocate_exact(self, n);
+    }
+    if (list_resize(self, m + n) < 0) {
+        return -1;
+    }
+    /* Make the list sane again. */
+    Py_SET_SIZE(self, m);
+    return 0;
+}
+
 static int
 list_preallocate_exact(PyListObject *self, Py_ssize_t size)
 {
@@ -932,16 +958,8 @@ list_extend(PyListObject *self, PyObject *iterable)
          * eventually run out of memory during the loop.
          */
     }
-    else if (self->ob_item == NULL) {
-        if (n && list_preallocate_exact(self, n) < 0)
-            goto error;
-    }
-    else {
-        /* Make room. */
-        if (list_resize(self, m + n) < 0)
-            goto error;
-        /* Make the list sane again. */
-        Py_SET_SIZE(self, m);
+    else if (list_reserve(self, n) < 0) {
+        goto error;
     }
 
     /* Run iterator to exhaustion. */
@@ -987,6 +1005,71 @@ _PyList_Extend(PyListObject *self, PyObject *iterable)
     return list_extend(self, iterable);
 }
 
+int
+_PyList_Reserve(PyObject *op, Py_ssize_t n)
+{
+    if (!PyList_Check(op)) {
+        PyErr_BadInternalCall();
+        return -1;
+    }
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative count");
+        return -1;
+    }
+    PyListObject *self = (PyListObject *)op;
+    if (Py_SIZE(self) > PY_SSIZE_T_MAX - n) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return list_reserve(self, n);
+}
+
+int
+_PyList_AppendArrayTakeRefs(PyObject *op, PyObject *const *items,
+                            Py_ssize_t n)
+{
+    assert(PyList_Check(op));
+    assert(n >= 0);
+    PyListObject *self = (PyListObject *)op;
+    Py_ssize_t m = Py_SIZE(self);
+    if (n == 0) {
+        return 0;
+    }
+    if (m > PY_SSIZE_T_MAX - n) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    /* list_reserve() may free the items of the list */
+    assert(items + n <= self->ob_item ||
+           items >= self->ob_item + self->allocated);
+    if (list_reserve(self, n) < 0) {
+        return -1;
+    }
+    memcpy(self->ob_item + m, items, n * sizeof(PyObject *));
+    Py_SET_SIZE(self, m + n);
+    return 0;
+}
+
+int
+_PyList_AppendArray(PyObject *op, PyObject *const *items, Py_ssize_t n)
+{
+    if (!PyList_Check(op)) {
+        PyErr_BadInternalCall();
+        return -1;
+    }
+    if (n < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative count");
+        return -1;
+    }
+    if (_PyList_AppendArrayTakeRefs(op, items, n) < 0) {
+        return -1;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        Py_INCREF(items[i]);
+    }
+    return 0;
+}
+
 static PyObject *
 list_inplace_concat(PyListObject *self, PyObject *other)
 {
@@ -2182,6 +2265,154 @@ unsafe_float_compare(PyObject *v, PyObject *w, MergeState *ms)
     return res;
 }
 
+/* Radix sort: for large lists whose keys are all bounded ints or all floats
+ * (the cases handled by unsafe_long_compare and unsafe_float_compare), the
+ * keys are unboxed into unsigned 64-bit integers ordered like the original
+ * values, and sorted with a stable least-significant-digit radix sort, a
+ * byte at a time.  Passes where all the keys have the same byte are skipped,
+ * so small ints only cost a few passes.  The sort is stable, so the result
+ * is the same as the one of the merge sort.
+ *
+ * Lists with a NaN are left to the merge sort, since NaNs don't have an
+ * order to preserve.  -0.0 and 0.0 compare equal, so they get the same key.
+ */
+#define RADIX_SORT_MIN_SIZE 1024
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+typedef struct {
+    uint64_t key;
+    Py_ssize_t index;
+} radix_item;
+
+static inline uint64_t
+radix_long_key(PyObject *v)
+{
+    assert(Py_IS_TYPE(v, &PyLong_Type));
+    assert(Py_ABS(Py_SIZE(v)) <= 1);
+    int64_t x = Py_SIZE(v) == 0 ? 0 : (int64_t)((PyLongObject *)v)->ob_digit[0];
+    if (Py_SIZE(v) < 0) {
+        x = -x;
+    }
+    /* Flip the sign bit so negative values sort first. */
+    return (uint64_t)x ^ ((uint64_t)1 << 63);
+}
+
+/* Return 0 and leave *key unset if v is a NaN. */
+static inline int
+radix_float_key(PyObject *v, uint64_t *key)
+{
+    assert(Py_IS_TYPE(v, &PyFloat_Type));
+    double d = PyFloat_AS_DOUBLE(v);
+    uint64_t bits;
+    if (Py_IS_NAN(d)) {
+        return 0;
+    }
+    if (d == 0.0) {
+        d = 0.0;  /* -0.0 */
+    }
+    memcpy(&bits, &d, sizeof(bits));
+    /* Negative floats: reverse their order; positive ones: put them after
+       the negative ones. */
+    if (bits >> 63) {
+        *key = ~bits;
+    }
+    else {
+        *key = bits | ((uint64_t)1 << 63);
+    }
+    return 1;
+}
+
+/* Sort the n keys (and values, if any) of lo.  Return 1 if the slice was
+ * sorted, or 0 if the radix sort was not applicable (NaN found or memory
+ * allocation failure, which is not reported), in which case the slice is
+ * left unchanged.
+ */
+static int
+radix_sort(sortslice *lo, Py_ssize_t n, int floats)
+{
+    radix_item *items, *tmp;
+    PyObject **objs;
+    size_t counts[RADIX_PASSES][RADIX_BUCKETS];
+    Py_ssize_t i;
+    int p, sorted = 1;
+
+    items = PyMem_New(radix_item, 2 * n);
+    if (items == NULL) {
+        return 0;
+    }
+    tmp = items + n;
+
+    /* Unbox the keys and check if the keys are already sorted. */
+    for (i = 0; i < n; i++) {
+        uint64_t key;
+        if (floats) {
+            if (!radix_float_key(lo->keys[i], &key)) {
+                PyMem_Free(items);
+                return 0;
+            }
+        }
+        else {
+            key = radix_long_key(lo->keys[i]);
+        }
+        if (i > 0 && key < items[i-1].key) {
+            sorted = 0;
+        }
+        items[i].key = key;
+        items[i].index = i;
+    }
+    if (sorted) {
+        PyMem_Free(items);
+        return 1;
+    }
+
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < n; i++) {
+        uint64_t key = items[i].key;
+        for (p = 0; p < RADIX_PASSES; p++) {
+            counts[p][(key >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    for (p = 0; p < RADIX_PASSES; p++) {
+        size_t *count = counts[p];
+        int shift = p * RADIX_BITS;
+        if (count[(items[0].key >> shift) & (RADIX_BUCKETS - 1)] == (size_t)n) {
+            /* All the keys have the same byte. */
+            continue;
+        }
+        /* Turn the counts into the start offsets of the buckets. */
+        size_t offset = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (i = 0; i < n; i++) {
+            tmp[count[(items[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = items[i];
+        }
+        radix_item *swap = items;
+        items = tmp;
+        tmp = swap;
+    }
+
+    /* Apply the permutation, reusing the spare buffer for the objects. */
+    objs = (PyObject **)tmp;
+    for (i = 0; i < n; i++) {
+        objs[i] = lo->keys[items[i].index];
+    }
+    memcpy(lo->keys, objs, n * sizeof(PyObject *));
+    if (lo->values != NULL) {
+        for (i = 0; i < n; i++) {
+            objs[i] = lo->values[items[i].index];
+        }
+        memcpy(lo->values, objs, n * sizeof(PyObject *));
+    }
+    PyMem_Free(items < tmp ? items : tmp);
+    return 1;
+}
+
 /* Tuple compare: compare *any* two tuples, using
  * ms->tuple_elem_compare to compare the first elements, which is set
  * using the same pre-sort check as we use for ms->key_compare,
@@ -2423,6 +2654,16 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
         reverse_slice(&saved_ob_item[0], &saved_ob_item[saved_ob_size]);
     }
 
+    if (nremaining >= RADIX_SORT_MIN_SIZE &&
+        (ms.key_compare == unsafe_long_compare ||
+         ms.key_compare == unsafe_float_compare))
+    {
+        if (radix_sort(&lo, nremaining,
+                       ms.key_compare == unsafe_float_compare)) {
+            goto succeed;
+        }
+    }
+
     /* March over the array once, left to right, finding natural runs,
      * and extending short natural runs to minrun elements.
      */
@@ -2555,6 +2796,27 @@ PyList_Reverse(PyObject *v)
     return 0;
 }
 
+PyObject *
+_PyList_FromArraySteal(PyObject *const *src, Py_ssize_t n)
+{
+    if (n == 0) {
+        return PyList_New(0);
+    }
+
+    PyListObject *list = (PyListObject *)PyList_New(n);
+    if (list == NULL) {
+        for (Py_ssize_t i = 0; i < n; i++) {
+            Py_DECREF(src[i]);
+        }
+        return NULL;
+    }
+
+    PyObject **dst = list->ob_item;
+    memcpy(dst, src, n * sizeof(PyObject *));
+
+    return (PyObject *)list;
+}
+
 PyObject *
 PyList_AsTuple(PyObject *v)
 {
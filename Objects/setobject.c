@@ -32,6 +32,7 @@
 */
 
 #include "Python.h"
+#include "pycore_long.h"          // _PyLong_ExactEqual()
 #include "pycore_object.h"        // _PyObject_GC_UNTRACK()
 #include <stddef.h>               // offsetof()
 
@@ -78,6 +79,8 @@ set_lookkey(PySetObject *so, PyObject *key, Py_hash_t hash)
                     && PyUnicode_CheckExact(key)
                     && _PyUnicode_EQ(startkey, key))
                     return entry;
+                if (_PyLong_ExactEqual(startkey, key))
+                    return entry;
                 table = so->table;
                 Py_INCREF(startkey);
                 cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
@@ -137,6 +140,8 @@ set_add_entry(PySetObject *so, PyObject *key, Py_hash_t hash)
                     && PyUnicode_CheckExact(key)
                     && _PyUnicode_EQ(startkey, key))
                     goto found_active;
+                if (_PyLong_ExactEqual(startkey, key))
+                    goto found_active;
                 table = so->table;
                 Py_INCREF(startkey);
                 cmp = PyObject_RichCompareBool(startkey, key, Py_EQ);
@@ -32,12 +32,13 @@ class object "PyObject *" "&PyBaseObject_Type"
    MCACHE_MAX_ATTR_SIZE, since it might be a problem if very large
    strings are used as attribute names. */
 #define MCACHE_MAX_ATTR_SIZE    100
-#define MCACHE_HASH(version, name_hash)                                 \
+#define MCACHE_HASH(mask, version, name_hash)                           \
         (((unsigned int)(version) ^ (unsigned int)(name_hash))          \
-         & ((1 << MCACHE_SIZE_EXP) - 1))
+         & (mask))
 
-#define MCACHE_HASH_METHOD(type, name)                                  \
-    MCACHE_HASH((type)->tp_version_tag, ((Py_ssize_t)(name)) >> 3)
+#define MCACHE_HASH_METHOD(cache, type, name)                           \
+    MCACHE_HASH((cache)->mask, (type)->tp_version_tag,                  \
+                ((Py_ssize_t)(name)) >> 3)
 #define MCACHE_CACHEABLE_NAME(name)                             \
         PyUnicode_CheckExact(name) &&                           \
         PyUnicode_IS_READY(name) &&                             \
@@ -299,7 +300,7 @@ get_type_cache(void)
 static void
 type_cache_clear(struct type_cache *cache, PyObject *value)
 {
-    for (Py_ssize_t i = 0; i < (1 << MCACHE_SIZE_EXP); i++) {
+    for (size_t i = 0; i <= cache->mask; i++) {
         struct type_cache_entry *entry = &cache->hashtable[i];
         entry->version = 0;
         Py_XSETREF(entry->name, _Py_XNewRef(value));
@@ -308,12 +309,11 @@ type_cache_clear(struct type_cache *cache, PyObject *value)
 }
 
 
-void
-_PyType_InitCache(PyInterpreterState *interp)
+static void
+type_cache_init_entries(struct type_cache_entry *entries, size_t size)
 {
-    struct type_cache *cache = &interp->types.type_cache;
-    for (Py_ssize_t i = 0; i < (1 << MCACHE_SIZE_EXP); i++) {
-        struct type_cache_entry *entry = &cache->hashtable[i];
+    for (size_t i = 0; i < size; i++) {
+        struct type_cache_entry *entry = &entries[i];
         assert(entry->name == NULL);
 
         entry->version = 0;
@@ -325,21 +325,95 @@ _PyType_InitCache(PyInterpreterState *interp)
 }
 
 
+/* Replace the cache by one of size entries.  The cached entries are
+   dropped: they are rebuilt on demand by _PyType_Lookup().  On memory
+   allocation failure, the cache keeps its current size; no exception is
+   set. */
+static void
+type_cache_resize(struct type_cache *cache, size_t size)
+{
+    assert(size <= (1 << MCACHE_MAX_SIZE_EXP));
+    struct type_cache_entry *entries = PyMem_RawCalloc(size, sizeof(*entries));
+    if (entries == NULL) {
+        return;
+    }
+    type_cache_init_entries(entries, size);
+
+    type_cache_clear(cache, NULL);
+    if (cache->hashtable != &cache->fallback_entry) {
+        PyMem_RawFree(cache->hashtable);
+    }
+    cache->hashtable = entries;
+    cache->mask = (unsigned int)(size - 1);
+    cache->resizes++;
+}
+
+
+void
+_PyType_InitCache(PyInterpreterState *interp)
+{
+    struct type_cache *cache = &interp->types.type_cache;
+    cache->hashtable = &cache->fallback_entry;
+    cache->mask = 0;
+    type_cache_init_entries(cache->hashtable, 1);
+    type_cache_resize(cache, 1 << MCACHE_MIN_SIZE_EXP);
+    cache->resizes = 0;
+}
+
+
+/* Called when a type gets Py_TPFLAGS_VALID_VERSION_TAG. */
+static void
+type_cache_add_versioned_type(struct type_cache *cache)
+{
+    cache->versioned_types++;
+    size_t size = (size_t)cache->mask + 1;
+    if (size < (1 << MCACHE_MIN_SIZE_EXP)) {
+        // The initial allocation failed
+        type_cache_resize(cache, 1 << MCACHE_MIN_SIZE_EXP);
+    }
+    else if ((cache->versioned_types << MCACHE_ENTRIES_PER_TYPE_EXP) > size
+             && size < (1 << MCACHE_MAX_SIZE_EXP))
+    {
+        type_cache_resize(cache, size * 2);
+    }
+}
+
+
+/* Called when a type loses Py_TPFLAGS_VALID_VERSION_TAG or is deallocated
+   with it.  Static types are shared by the interpreters, and can lose the
+   flag in another interpreter than the one where they got it: the count is
+   therefore only an estimate, which never goes below zero. */
+static void
+type_cache_remove_versioned_type(struct type_cache *cache)
+{
+    if (cache->versioned_types == 0) {
+        return;
+    }
+    cache->versioned_types--;
+    size_t size = (size_t)cache->mask + 1;
+    if ((cache->versioned_types << (MCACHE_ENTRIES_PER_TYPE_EXP + 2)) < size
+        && size > (1 << MCACHE_MIN_SIZE_EXP))
+    {
+        type_cache_resize(cache, size / 2);
+    }
+}
+
+
+static void
+type_clear_version_tag(PyTypeObject *type)
+{
+    if (_PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG)) {
+        type_cache_remove_versioned_type(get_type_cache());
+    }
+    type->tp_flags &= ~Py_TPFLAGS_VALID_VERSION_TAG;
+    type->tp_version_tag = 0; /* 0 is not a valid version tag */
+}
+
+
 static unsigned int
 _PyType_ClearCache(PyInterpreterState *interp)
 {
     struct type_cache *cache = &interp->types.type_cache;
-#if MCACHE_STATS
-    size_t total = cache->hits + cache->collisions + cache->misses;
-    fprintf(stderr, "-- Method cache hits        = %zd (%d%%)\n",
-            cache->hits, (int) (100.0 * cache->hits / total));
-    fprintf(stderr, "-- Method cache true misses = %zd (%d%%)\n",
-            cache->misses, (int) (100.0 * cache->misses / total));
-    fprintf(stderr, "-- Method cache collisions  = %zd (%d%%)\n",
-            cache->collisions, (int) (100.0 * cache->collisions / total));
-    fprintf(stderr, "-- Method cache size        = %zd KiB\n",
-            sizeof(cache->hashtable) / 1024);
-#endif
 
     // Set to None, rather than NULL, so _PyType_Lookup() can
     // use Py_SETREF() rather than using slower Py_XSETREF().
@@ -357,11 +431,31 @@ PyType_ClearCache(void)
 }
 
 
+PyObject *
+_PyType_GetCacheStats(PyInterpreterState *interp)
+{
+    struct type_cache *cache = &interp->types.type_cache;
+    return Py_BuildValue("{sIsnsnsnsnsn}",
+                         "size", cache->mask + 1,
+                         "versioned_types", (Py_ssize_t)cache->versioned_types,
+                         "hits", (Py_ssize_t)cache->hits,
+                         "misses", (Py_ssize_t)cache->misses,
+                         "collisions", (Py_ssize_t)cache->collisions,
+                         "resizes", (Py_ssize_t)cache->resizes);
+}
+
+
 void
 _PyTypes_Fini(PyInterpreterState *interp)
 {
     struct type_cache *cache = &interp->types.type_cache;
     type_cache_clear(cache, NULL);
+    if (cache->hashtable != &cache->fallback_entry) {
+        PyMem_RawFree(cache->hashtable);
+        cache->hashtable = &cache->fallback_entry;
+        cache->mask = 0;
+    }
+    cache->versioned_types = 0;
     if (_Py_IsMainInterpreter(interp)) {
         clear_slotdefs();
     }
@@ -398,6 +492,27 @@ PyType_Modified(PyTypeObject *type)
         return;
     }
 
+    if (type->tp_watched) {
+        /* The type may be modified while an exception is being raised */
+        PyObject *exc_type, *exc_value, *exc_tb;
+        PyErr_Fetch(&exc_type, &exc_value, &exc_tb);
+        PyInterpreterState *interp = _PyInterpreterState_GET();
+        int bits = type->tp_watched;
+        int i = 0;
+        while (bits) {
+            assert(i < TYPE_MAX_WATCHERS);
+            if (bits & 1) {
+                PyType_WatchCallback cb = interp->types.watchers[i];
+                if (cb && (cb(type) < 0)) {
+                    PyErr_WriteUnraisable((PyObject *)type);
+                }
+            }
+            i++;
+            bits >>= 1;
+        }
+        PyErr_Restore(exc_type, exc_value, exc_tb);
+    }
+
     PyObject *subclasses = lookup_subclasses(type);
     if (subclasses != NULL) {
         assert(PyDict_CheckExact(subclasses));
@@ -413,8 +528,7 @@ PyType_Modified(PyTypeObject *type)
         }
     }
 
-    type->tp_flags &= ~Py_TPFLAGS_VALID_VERSION_TAG;
-    type->tp_version_tag = 0; /* 0 is not a valid version tag */
+    type_clear_version_tag(type);
 }
 
 static void
@@ -466,8 +580,7 @@ type_mro_modified(PyTypeObject *type, PyObject *bases) {
     }
     return;
  clear:
-    type->tp_flags &= ~Py_TPFLAGS_VALID_VERSION_TAG;
-    type->tp_version_tag = 0; /* 0 is not a valid version tag */
+    type_clear_version_tag(type);
 }
 
 static int
@@ -500,10 +613,90 @@ assign_version_tag(struct type_cache *cache, PyTypeObject *type)
             return 0;
     }
     type->tp_flags |= Py_TPFLAGS_VALID_VERSION_TAG;
+    type_cache_add_versioned_type(cache);
     return 1;
 }
 
 
+/* Type watchers */
+
+static int
+validate_watcher_id(PyInterpreterState *interp, int watcher_id)
+{
+    if (watcher_id < 0 || watcher_id >= TYPE_MAX_WATCHERS) {
+        PyErr_Format(PyExc_ValueError, "Invalid type watcher ID %d", watcher_id);
+        return -1;
+    }
+    if (!interp->types.watchers[watcher_id]) {
+        PyErr_Format(PyExc_ValueError, "No type watcher set for ID %d", watcher_id);
+        return -1;
+    }
+    return 0;
+}
+
+int
+PyType_AddWatcher(PyType_WatchCallback callback)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+
+    for (int i = 0; i < TYPE_MAX_WATCHERS; i++) {
+        if (!interp->types.watchers[i]) {
+            interp->types.watchers[i] = callback;
+            return i;
+        }
+    }
+
+    PyErr_SetString(PyExc_RuntimeError, "no more type watcher IDs available");
+    return -1;
+}
+
+int
+PyType_ClearWatcher(int watcher_id)
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (validate_watcher_id(interp, watcher_id) < 0) {
+        return -1;
+    }
+    interp->types.watchers[watcher_id] = NULL;
+    return 0;
+}
+
+int
+PyType_Watch(int watcher_id, PyObject* obj)
+{
+    if (!PyType_Check(obj)) {
+        PyErr_SetString(PyExc_ValueError, "Cannot watch non-type");
+        return -1;
+    }
+    PyTypeObject *type = (PyTypeObject *)obj;
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (validate_watcher_id(interp, watcher_id) < 0) {
+        return -1;
+    }
+    // PyType_Modified only notifies the watchers of a type with a valid
+    // version tag
+    assign_version_tag(&interp->types.type_cache, type);
+    type->tp_watched |= (1 << watcher_id);
+    return 0;
+}
+
+int
+PyType_Unwatch(int watcher_id, PyObject* obj)
+{
+    if (!PyType_Check(obj)) {
+        PyErr_SetString(PyExc_ValueError, "Cannot watch non-type");
+        return -1;
+    }
+    PyTypeObject *type = (PyTypeObject *)obj;
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (validate_watcher_id(interp, watcher_id) < 0) {
+        return -1;
+    }
+    type->tp_watched &= ~(1 << watcher_id);
+    return 0;
+}
+
+
 static PyMemberDef type_members[] = {
     {"__basicsize__", T_PYSSIZET, offsetof(PyTypeObject,tp_basicsize),READONLY},
     {"__itemsize__", T_PYSSIZET, offsetof(PyTypeObject, tp_itemsize), READONLY},
@@ -4108,14 +4301,12 @@ _PyType_Lookup(PyTypeObject *type, PyObject *name)
     PyObject *res;
     int error;
 
-    unsigned int h = MCACHE_HASH_METHOD(type, name);
     struct type_cache *cache = get_type_cache();
+    unsigned int h = MCACHE_HASH_METHOD(cache, type, name);
     struct type_cache_entry *entry = &cache->hashtable[h];
     if (entry->version == type->tp_version_tag &&
         entry->name == name) {
-#if MCACHE_STATS
         cache->hits++;
-#endif
         assert(_PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG));
         return entry->value;
     }
@@ -4141,19 +4332,17 @@ _PyType_Lookup(PyTypeObject *type, PyObject *name)
     }
 
     if (MCACHE_CACHEABLE_NAME(name) && assign_version_tag(cache, type)) {
-        h = MCACHE_HASH_METHOD(type, name);
+        h = MCACHE_HASH_METHOD(cache, type, name);
         struct type_cache_entry *entry = &cache->hashtable[h];
         entry->version = type->tp_version_tag;
         entry->value = res;  /* borrowed */
         assert(_PyASCIIObject_CAST(name)->hash != -1);
-#if MCACHE_STATS
         if (entry->name != Py_None && entry->name != name) {
             cache->collisions++;
         }
         else {
             cache->misses++;
         }
-#endif
         assert(_PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG));
         Py_SETREF(entry->name, Py_NewRef(name));
     }
@@ -4339,6 +4528,7 @@ _PyDictKeys_DecRef(PyDictKeysObject *keys);
 static void
 type_dealloc_common(PyTypeObject *type)
 {
+    type_clear_version_tag(type);
     if (type->tp_bases != NULL) {
         PyObject *tp, *val, *tb;
         PyErr_Fetch(&tp, &val, &tb);
@@ -8053,17 +8243,17 @@ slot_tp_call(PyObject *self, PyObject *args, PyObject *kwds)
 
 /* There are two slot dispatch functions for tp_getattro.
 
-   - slot_tp_getattro() is used when __getattribute__ is overridden
+   - _Py_slot_tp_getattro() is used when __getattribute__ is overridden
      but no __getattr__ hook is present;
 
-   - slot_tp_getattr_hook() is used when a __getattr__ hook is present.
+   - _Py_slot_tp_getattr_hook() is used when a __getattr__ hook is present.
 
-   The code in update_one_slot() always installs slot_tp_getattr_hook(); this
-   detects the absence of __getattr__ and then installs the simpler slot if
-   necessary. */
+   The code in update_one_slot() always installs _Py_slot_tp_getattr_hook();
+   this detects the absence of __getattr__ and then installs the simpler slot
+   if necessary.  The specializer (Python/specialize.c) recognizes both. */
 
-static PyObject *
-slot_tp_getattro(PyObject *self, PyObject *name)
+PyObject *
+_Py_slot_tp_getattro(PyObject *self, PyObject *name)
 {
     PyObject *stack[2] = {self, name};
     return vectorcall_method(&_Py_ID(__getattribute__), stack, 2);
@@ -8094,8 +8284,8 @@ call_attribute(PyObject *self, PyObject *attr, PyObject *name)
     return res;
 }
 
-static PyObject *
-slot_tp_getattr_hook(PyObject *self, PyObject *name)
+PyObject *
+_Py_slot_tp_getattr_hook(PyObject *self, PyObject *name)
 {
     PyTypeObject *tp = Py_TYPE(self);
     PyObject *getattr, *getattribute, *res;
@@ -8108,8 +8298,8 @@ slot_tp_getattr_hook(PyObject *self, PyObject *name)
     getattr = _PyType_Lookup(tp, &_Py_ID(__getattr__));
     if (getattr == NULL) {
         /* No __getattr__ hook: use a simpler dispatcher */
-        tp->tp_getattro = slot_tp_getattro;
-        return slot_tp_getattro(self, name);
+        tp->tp_getattro = _Py_slot_tp_getattro;
+        return _Py_slot_tp_getattro(self, name);
     }
     Py_INCREF(getattr);
     /* speed hack: we could use lookup_maybe, but that would resolve the
@@ -8469,10 +8659,10 @@ static slotdef slotdefs[] = {
            PyWrapperFlag_KEYWORDS),
     TPSLOT("__str__", tp_str, slot_tp_str, wrap_unaryfunc,
            "__str__($self, /)\n--\n\nReturn str(self)."),
-    TPSLOT("__getattribute__", tp_getattro, slot_tp_getattr_hook,
+    TPSLOT("__getattribute__", tp_getattro, _Py_slot_tp_getattr_hook,
            wrap_binaryfunc,
            "__getattribute__($self, name, /)\n--\n\nReturn getattr(self, name)."),
-    TPSLOT("__getattr__", tp_getattro, slot_tp_getattr_hook, NULL, ""),
+    TPSLOT("__getattr__", tp_getattro, _Py_slot_tp_getattr_hook, NULL, ""),
     TPSLOT("__setattr__", tp_setattro, slot_tp_setattro, wrap_setattr,
            "__setattr__($self, name, value, /)\n--\n\nImplement setattr(self, name, value)."),
     TPSLOT("__delattr__", tp_setattro, slot_tp_setattro, wrap_delattr,
@@ -44,6 +44,7 @@ extern PyObject* PyInit__heapq(void);
 extern PyObject* PyInit__bisect(void);
 extern PyObject* PyInit__symtable(void);
 extern PyObject* PyInit_mmap(void);
+extern PyObject* PyInit__concurrent_futures(void);
 extern PyObject* PyInit__csv(void);
 extern PyObject* PyInit__sre(void);
 extern PyObject* PyInit_winreg(void);
@@ -124,6 +125,7 @@ struct _inittab _PyImport_Inittab[] = {
     {"_collections", PyInit__collections},
     {"_symtable", PyInit__symtable},
     {"mmap", PyInit_mmap},
+    {"_concurrent_futures", PyInit__concurrent_futures},
     {"_csv", PyInit__csv},
     {"_sre", PyInit__sre},
     {"winreg", PyInit_winreg},
@@ -186,13 +186,16 @@ _resize_tokens_array(Parser *p) {
     }
     p->tokens = new_tokens;
 
+    // Allocate the new tokens in a single block.  The size of the array
+    // doubles, so the blocks start at the powers of two (see
+    // _PyPegen_Parser_Free()).
+    Token *block = PyMem_Calloc(newsize - p->size, sizeof(Token));
+    if (block == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
     for (int i = p->size; i < newsize; i++) {
-        p->tokens[i] = PyMem_Calloc(1, sizeof(Token));
-        if (p->tokens[i] == NULL) {
-            p->size = i; // Needed, in order to cleanup correctly after parser fails
-            PyErr_NoMemory();
-            return -1;
-        }
+        p->tokens[i] = &block[i - p->size];
     }
     p->size = newsize;
     return 0;
@@ -283,39 +286,20 @@ _PyPegen_get_memo_statistics()
     }
     return ret;
 }
-#endif
 
-int  // bool
-_PyPegen_is_memoized(Parser *p, int type, void *pres)
+void
+_PyPegen_count_memo_hit(Parser *p, int type, Memo *m)
 {
-    if (p->mark == p->fill) {
-        if (_PyPegen_fill_token(p) < 0) {
-            p->error_indicator = 1;
-            return -1;
-        }
-    }
-
-    Token *t = p->tokens[p->mark];
-
-    for (Memo *m = t->memo; m != NULL; m = m->next) {
-        if (m->type == type) {
-#if defined(PY_DEBUG)
-            if (0 <= type && type < NSTATISTICS) {
-                long count = m->mark - p->mark;
-                // A memoized negative result counts for one.
-                if (count <= 0) {
-                    count = 1;
-                }
-                memo_statistics[type] += count;
-            }
-#endif
-            p->mark = m->mark;
-            *(void **)(pres) = m->node;
-            return 1;
+    if (0 <= type && type < NSTATISTICS) {
+        long count = m->mark - p->mark;
+        // A memoized negative result counts for one.
+        if (count <= 0) {
+            count = 1;
         }
+        memo_statistics[type] += count;
     }
-    return 0;
 }
+#endif
 
 int
 _PyPegen_lookahead_with_name(int positive, expr_ty (func)(Parser *), Parser *p)
@@ -353,23 +337,6 @@ _PyPegen_lookahead(int positive, void *(func)(Parser *), Parser *p)
     return (res != NULL) == positive;
 }
 
-Token *
-_PyPegen_expect_token(Parser *p, int type)
-{
-    if (p->mark == p->fill) {
-        if (_PyPegen_fill_token(p) < 0) {
-            p->error_indicator = 1;
-            return NULL;
-        }
-    }
-    Token *t = p->tokens[p->mark];
-    if (t->type != type) {
-        return NULL;
-    }
-    p->mark += 1;
-    return t;
-}
-
 void*
 _PyPegen_expect_forced_result(Parser *p, void* result, const char* expected) {
 
@@ -778,9 +745,11 @@ void
 _PyPegen_Parser_Free(Parser *p)
 {
     Py_XDECREF(p->normalize);
-    for (int i = 0; i < p->size; i++) {
+    // Free the blocks of tokens allocated by _resize_tokens_array()
+    for (int i = 1; i < p->size; i *= 2) {
         PyMem_Free(p->tokens[i]);
     }
+    PyMem_Free(p->tokens[0]);
     PyMem_Free(p->tokens);
     growable_comment_array_deallocate(&p->type_ignore_comments);
     PyMem_Free(p);
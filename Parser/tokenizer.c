@@ -19,18 +19,56 @@
 /* Alternate tab spacing */
 #define ALTTABSIZE 1
 
-#define is_potential_identifier_start(c) (\
-              (c >= 'a' && c <= 'z')\
-               || (c >= 'A' && c <= 'Z')\
-               || c == '_'\
-               || (c >= 128))
-
-#define is_potential_identifier_char(c) (\
-              (c >= 'a' && c <= 'z')\
-               || (c >= 'A' && c <= 'Z')\
-               || (c >= '0' && c <= '9')\
-               || c == '_'\
-               || (c >= 128))
+/* Classes of the characters which can be part of an identifier: letters,
+   '_' and all the non-ASCII bytes (verify_identifier() checks the identifiers
+   containing some) can start one, digits can only continue one. */
+#define ID_CHAR 1
+#define ID_START 2
+#define ID_STARTCHAR (ID_START | ID_CHAR)
+
+static const unsigned char identifier_chars[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    /* 0-9 */
+    ID_CHAR, ID_CHAR, ID_CHAR, ID_CHAR, ID_CHAR,
+    ID_CHAR, ID_CHAR, ID_CHAR, ID_CHAR, ID_CHAR,
+    0, 0, 0, 0, 0, 0,
+    /* @, A-O */
+    0, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    /* P-Z, [, \, ], ^, _ */
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, 0,
+    0, 0, 0, ID_STARTCHAR,
+    /* `, a-o */
+    0, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    /* p-z, {, |, }, ~, DEL */
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR,
+    ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, 0,
+    0, 0, 0, 0,
+    /* 128-255 */
+#define ID_ROW ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, \
+               ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, \
+               ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, \
+               ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR, ID_STARTCHAR
+    ID_ROW, ID_ROW, ID_ROW, ID_ROW, ID_ROW, ID_ROW, ID_ROW, ID_ROW,
+#undef ID_ROW
+};
+
+/* c is a char returned by tok_nextc(), or EOF */
+#define is_potential_identifier_start(c) \
+    ((unsigned int)(c) < 256 && (identifier_chars[(c)] & ID_START))
+
+#define is_potential_identifier_char(c) \
+    ((unsigned int)(c) < 256 && (identifier_chars[(c)] & ID_CHAR))
 
 
 /* Don't ever change this -- it would break the portability of Python code */
@@ -1009,15 +1047,16 @@ print_escape(FILE *f, const char *s, Py_ssize_t size)
 }
 #endif
 
-/* Get next char, updating state; error code goes into tok->done */
+/* Refill the buffer and get the next char, updating state; error code goes
+   into tok->done */
 
 static int
-tok_nextc(struct tok_state *tok)
+tok_underflow(struct tok_state *tok)
 {
     int rc;
     for (;;) {
         if (tok->cur != tok->inp) {
-            return Py_CHARMASK(*tok->cur++); /* Fast path */
+            return Py_CHARMASK(*tok->cur++);
         }
         if (tok->done != E_OK) {
            return EOF;
@@ -1047,6 +1086,17 @@ tok_nextc(struct tok_state *tok)
     Py_UNREACHABLE();
 }
 
+/* Get next char, updating state; error code goes into tok->done */
+
+static inline int
+tok_nextc(struct tok_state *tok)
+{
+    if (tok->cur != tok->inp) {
+        return Py_CHARMASK(*tok->cur++); /* Fast path */
+    }
+    return tok_underflow(tok);
+}
+
 /* Back-up one character */
 
 static void
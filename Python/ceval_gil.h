@@ -47,6 +47,20 @@
      run and end up being the first to re-acquire it, making the "timeslices"
      much longer than expected.
      (Note: this mechanism is enabled with FORCE_SWITCHING above)
+
+   - Optionally (see `sys._setgilpriority()`), a thread coming back from a
+     blocking call through PyEval_RestoreThread() is a "priority" waiter:
+     it sets gil_drop_request as soon as it finds the GIL taken instead of
+     waiting for `interval` microseconds, and other waiters refrain from
+     taking the GIL while priority waiters are queued. A thread serving
+     I/O therefore gets the GIL back after at most one eval loop turn of
+     a CPU-bound thread, at the cost of more frequent switches for the
+     latter.
+
+   - When enabled with `sys._setgilstats()`, take_gil() and drop_gil()
+     count acquisitions, wait and hold times and the reasons for dropping
+     the GIL (see struct _gil_stats).  The gil-wait-start, gil-acquire and
+     gil-drop DTrace probes fire at the same points.
 */
 
 #include "condvar.h"
@@ -73,6 +87,9 @@
 #define COND_SIGNAL(cond) \
     if (PyCOND_SIGNAL(&(cond))) { \
         Py_FatalError("PyCOND_SIGNAL(" #cond ") failed"); };
+#define COND_BROADCAST(cond) \
+    if (PyCOND_BROADCAST(&(cond))) { \
+        Py_FatalError("PyCOND_BROADCAST(" #cond ") failed"); };
 #define COND_WAIT(cond, mut) \
     if (PyCOND_WAIT(&(cond), &(mut))) { \
         Py_FatalError("PyCOND_WAIT(" #cond ") failed"); };
@@ -113,6 +130,7 @@ static void create_gil(struct _gil_runtime_state *gil)
     COND_INIT(gil->switch_cond);
 #endif
     _Py_atomic_store_relaxed(&gil->last_holder, 0);
+    gil->priority_waiters = 0;
     _Py_ANNOTATE_RWLOCK_CREATE(&gil->locked);
     _Py_atomic_store_explicit(&gil->locked, 0, _Py_memory_order_release);
 }
@@ -140,9 +158,60 @@ static void recreate_gil(struct _gil_runtime_state *gil)
     create_gil(gil);
 }
 
+/* Return the index of the histogram bucket counting ns nanoseconds. */
+static int
+gil_stats_bucket(_PyTime_t ns)
+{
+    uint64_t us = ns > 0 ? (uint64_t)ns / 1000 : 0;
+    int bucket = 0;
+    while (us != 0 && bucket < _PyGIL_HIST_SIZE - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/* Account for tstate taking the GIL.  wait_start is when tstate started
+   waiting for the GIL, or 0 if it didn't have to.  Called with the GIL
+   mutex held. */
+static void
+gil_stats_acquired(struct _gil_stats *stats, PyThreadState *tstate,
+                   _PyTime_t wait_start, int switched)
+{
+    _PyTime_t now = _PyTime_GetPerfCounter();
+    stats->acquisitions++;
+    tstate->gil_acquisitions++;
+    if (switched) {
+        stats->switches++;
+    }
+    if (wait_start != 0) {
+        _PyTime_t waited = now - wait_start;
+        stats->contended++;
+        stats->wait_time += waited;
+        stats->wait_hist[gil_stats_bucket(waited)]++;
+        tstate->gil_wait_time += waited;
+    }
+    stats->hold_start = now;
+}
+
+/* Account for the GIL being dropped.  Called with the GIL mutex held. */
+static void
+gil_stats_dropped(struct _gil_stats *stats, int reason)
+{
+    stats->drops[reason]++;
+    if (stats->hold_start != 0) {
+        _PyTime_t held = _PyTime_GetPerfCounter() - stats->hold_start;
+        stats->hold_time += held;
+        stats->hold_hist[gil_stats_bucket(held)]++;
+        stats->hold_start = 0;
+    }
+}
+
+/* Drop the GIL.  requested is non-zero if the GIL is dropped because
+   another thread asked for it through gil_drop_request. */
 static void
 drop_gil(struct _ceval_runtime_state *ceval, struct _ceval_state *ceval2,
-         PyThreadState *tstate)
+         PyThreadState *tstate, int requested)
 {
     struct _gil_runtime_state *gil = &ceval->gil;
     if (!_Py_atomic_load_relaxed(&gil->locked)) {
@@ -158,13 +227,42 @@ drop_gil(struct _ceval_runtime_state *ceval, struct _ceval_state *ceval2,
     }
 
     MUTEX_LOCK(gil->mutex);
+    int reason = _PyGIL_DROP_RELEASE;
+    if (requested) {
+        reason = (gil->priority_request ? _PyGIL_DROP_PRIORITY
+                                        : _PyGIL_DROP_INTERVAL);
+    }
+#ifdef FORCE_SWITCHING
+    /* Decided under the mutex, so that the forced switch is counted with
+       the other statistics */
+    int force_switch = (tstate != NULL &&
+                        _Py_atomic_load_relaxed(&ceval2->gil_drop_request));
+#endif
+    if (gil->stats.enabled) {
+        gil_stats_dropped(&gil->stats, reason);
+#ifdef FORCE_SWITCHING
+        if (force_switch) {
+            gil->stats.forced_switches++;
+        }
+#endif
+    }
+    if (PyDTrace_GIL_DROP_ENABLED()) {
+        PyDTrace_GIL_DROP(reason);
+    }
     _Py_ANNOTATE_RWLOCK_RELEASED(&gil->locked, /*is_write=*/1);
     _Py_atomic_store_relaxed(&gil->locked, 0);
-    COND_SIGNAL(gil->cond);
+    if (gil->priority_waiters) {
+        /* A single signal could wake up a waiter which has to hold back:
+           make sure the priority waiters get to see the GIL released. */
+        COND_BROADCAST(gil->cond);
+    }
+    else {
+        COND_SIGNAL(gil->cond);
+    }
     MUTEX_UNLOCK(gil->mutex);
 
 #ifdef FORCE_SWITCHING
-    if (_Py_atomic_load_relaxed(&ceval2->gil_drop_request) && tstate != NULL) {
+    if (force_switch) {
         MUTEX_LOCK(gil->switch_mutex);
         /* Not switched yet => wait */
         if (((PyThreadState*)_Py_atomic_load_relaxed(&gil->last_holder)) == tstate)
@@ -204,11 +302,14 @@ tstate_must_exit(PyThreadState *tstate)
 
 /* Take the GIL.
 
+   If priority is non-zero and the I/O priority policy is enabled, the
+   thread is handed the GIL ahead of other waiters (see the notes above).
+
    The function saves errno at entry and restores its value at exit.
 
    tstate must be non-NULL. */
 static void
-take_gil(PyThreadState *tstate)
+take_gil(PyThreadState *tstate, int priority)
 {
     int err = errno;
 
@@ -235,11 +336,43 @@ take_gil(PyThreadState *tstate)
 
     MUTEX_LOCK(gil->mutex);
 
-    if (!_Py_atomic_load_relaxed(&gil->locked)) {
+    int waited = 0;
+    _PyTime_t wait_start = 0;
+    priority = priority && gil->io_priority;
+    if (!_Py_atomic_load_relaxed(&gil->locked)
+        && (priority || !gil->priority_waiters))
+    {
         goto _ready;
     }
 
-    while (_Py_atomic_load_relaxed(&gil->locked)) {
+    waited = 1;
+    if (PyDTrace_GIL_WAIT_START_ENABLED()) {
+        PyDTrace_GIL_WAIT_START();
+    }
+    if (gil->stats.enabled) {
+        wait_start = _PyTime_GetPerfCounter();
+    }
+
+    if (priority) {
+        gil->priority_waiters++;
+        while (_Py_atomic_load_relaxed(&gil->locked)) {
+            /* Don't wait for the switch interval to elapse: ask the
+               GIL-holding thread to drop it right away. */
+            gil->priority_request = 1;
+            SET_GIL_DROP_REQUEST(interp);
+            COND_WAIT(gil->cond, gil->mutex);
+            if (tstate_must_exit(tstate)) {
+                gil->priority_waiters--;
+                COND_BROADCAST(gil->cond);
+                MUTEX_UNLOCK(gil->mutex);
+                PyThread_exit_thread();
+            }
+        }
+        gil->priority_waiters--;
+        goto _ready;
+    }
+
+    while (_Py_atomic_load_relaxed(&gil->locked) || gil->priority_waiters) {
         unsigned long saved_switchnum = gil->switch_number;
 
         unsigned long interval = (gil->interval >= 1 ? gil->interval : 1);
@@ -258,6 +391,7 @@ take_gil(PyThreadState *tstate)
             }
             assert(is_tstate_valid(tstate));
 
+            gil->priority_request = 0;
             SET_GIL_DROP_REQUEST(interp);
         }
     }
@@ -272,9 +406,11 @@ take_gil(PyThreadState *tstate)
     _Py_atomic_store_relaxed(&gil->locked, 1);
     _Py_ANNOTATE_RWLOCK_ACQUIRED(&gil->locked, /*is_write=*/1);
 
+    int switched = 0;
     if (tstate != (PyThreadState*)_Py_atomic_load_relaxed(&gil->last_holder)) {
         _Py_atomic_store_relaxed(&gil->last_holder, (uintptr_t)tstate);
         ++gil->switch_number;
+        switched = 1;
     }
 
 #ifdef FORCE_SWITCHING
@@ -291,12 +427,20 @@ take_gil(PyThreadState *tstate)
            in take_gil() while the main thread called
            wait_for_thread_shutdown() from Py_Finalize(). */
         MUTEX_UNLOCK(gil->mutex);
-        drop_gil(ceval, ceval2, tstate);
+        drop_gil(ceval, ceval2, tstate, 0);
         PyThread_exit_thread();
     }
     assert(is_tstate_valid(tstate));
 
+    if (gil->stats.enabled) {
+        gil_stats_acquired(&gil->stats, tstate, wait_start, switched);
+    }
+    if (PyDTrace_GIL_ACQUIRE_ENABLED()) {
+        PyDTrace_GIL_ACQUIRE(waited);
+    }
+
     if (_Py_atomic_load_relaxed(&ceval2->gil_drop_request)) {
+        gil->priority_request = 0;
         RESET_GIL_DROP_REQUEST(interp);
     }
     else {
@@ -329,3 +473,160 @@ unsigned long _PyEval_GetSwitchInterval()
     struct _gil_runtime_state *gil = &_PyRuntime.ceval.gil;
     return gil->interval;
 }
+
+void _PyEval_SetGILPriority(int enabled)
+{
+    struct _gil_runtime_state *gil = &_PyRuntime.ceval.gil;
+    gil->io_priority = enabled;
+}
+
+int _PyEval_GetGILPriority(void)
+{
+    struct _gil_runtime_state *gil = &_PyRuntime.ceval.gil;
+    return gil->io_priority;
+}
+
+void _PyEval_SetGILStats(int enabled)
+{
+    _PyRuntimeState *runtime = &_PyRuntime;
+    struct _gil_runtime_state *gil = &runtime->ceval.gil;
+
+    MUTEX_LOCK(gil->mutex);
+    if (enabled) {
+        /* Start counting afresh; the calling thread holds the GIL. */
+        memset(&gil->stats, 0, sizeof(gil->stats));
+        gil->stats.hold_start = _PyTime_GetPerfCounter();
+    }
+    gil->stats.enabled = enabled;
+    MUTEX_UNLOCK(gil->mutex);
+
+    if (enabled) {
+        PyThread_acquire_lock(runtime->interpreters.mutex, WAIT_LOCK);
+        for (PyInterpreterState *i = runtime->interpreters.head;
+             i != NULL; i = i->next)
+        {
+            for (PyThreadState *t = i->threads.head; t != NULL; t = t->next) {
+                t->gil_acquisitions = 0;
+                t->gil_wait_time = 0;
+            }
+        }
+        PyThread_release_lock(runtime->interpreters.mutex);
+    }
+}
+
+static PyObject *
+gil_stats_histogram(const uint64_t *hist)
+{
+    PyObject *list = PyList_New(_PyGIL_HIST_SIZE);
+    if (list == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < _PyGIL_HIST_SIZE; i++) {
+        PyObject *count = PyLong_FromUnsignedLongLong(hist[i]);
+        if (count == NULL) {
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, count);
+    }
+    return list;
+}
+
+static PyObject *
+gil_stats_threads(_PyRuntimeState *runtime)
+{
+    PyObject *result = PyDict_New();
+    if (result == NULL) {
+        return NULL;
+    }
+
+    /* Thread states can come and go even when the GIL is held: see
+       _PyThread_CurrentFrames(). */
+    PyThread_acquire_lock(runtime->interpreters.mutex, WAIT_LOCK);
+    for (PyInterpreterState *i = runtime->interpreters.head;
+         i != NULL; i = i->next)
+    {
+        for (PyThreadState *t = i->threads.head; t != NULL; t = t->next) {
+            PyObject *id = PyLong_FromUnsignedLong(t->thread_id);
+            if (id == NULL) {
+                goto fail;
+            }
+            PyObject *value = Py_BuildValue(
+                "(Kd)", (unsigned long long)t->gil_acquisitions,
+                _PyTime_AsSecondsDouble(t->gil_wait_time));
+            if (value == NULL) {
+                Py_DECREF(id);
+                goto fail;
+            }
+            int res = PyDict_SetItem(result, id, value);
+            Py_DECREF(id);
+            Py_DECREF(value);
+            if (res < 0) {
+                goto fail;
+            }
+        }
+    }
+    PyThread_release_lock(runtime->interpreters.mutex);
+    return result;
+
+fail:
+    PyThread_release_lock(runtime->interpreters.mutex);
+    Py_DECREF(result);
+    return NULL;
+}
+
+PyObject *
+_PyEval_GetGILStats(void)
+{
+    _PyRuntimeState *runtime = &_PyRuntime;
+    struct _gil_runtime_state *gil = &runtime->ceval.gil;
+    struct _gil_stats stats;
+
+    MUTEX_LOCK(gil->mutex);
+    stats = gil->stats;
+    MUTEX_UNLOCK(gil->mutex);
+    if (stats.enabled && stats.hold_start != 0) {
+        /* Include the current hold of the calling thread. */
+        stats.hold_time += _PyTime_GetPerfCounter() - stats.hold_start;
+    }
+
+    PyObject *wait_hist = NULL, *hold_hist = NULL, *threads = NULL;
+    PyObject *result = NULL;
+    wait_hist = gil_stats_histogram(stats.wait_hist);
+    if (wait_hist == NULL) {
+        goto done;
+    }
+    hold_hist = gil_stats_histogram(stats.hold_hist);
+    if (hold_hist == NULL) {
+        goto done;
+    }
+    threads = gil_stats_threads(runtime);
+    if (threads == NULL) {
+        goto done;
+    }
+    result = Py_BuildValue(
+        "{sOsKsKsKsKs{sKsKsK}sdsdsOsOsO}",
+        "enabled", stats.enabled ? Py_True : Py_False,
+        "acquisitions", (unsigned long long)stats.acquisitions,
+        "contended", (unsigned long long)stats.contended,
+        "switches", (unsigned long long)stats.switches,
+        "forced_switches", (unsigned long long)stats.forced_switches,
+        "drops",
+            "release",
+            (unsigned long long)stats.drops[_PyGIL_DROP_RELEASE],
+            "interval",
+            (unsigned long long)stats.drops[_PyGIL_DROP_INTERVAL],
+            "priority",
+            (unsigned long long)stats.drops[_PyGIL_DROP_PRIORITY],
+        "wait_time", _PyTime_AsSecondsDouble(stats.wait_time),
+        "hold_time", _PyTime_AsSecondsDouble(stats.hold_time),
+        "wait_histogram", wait_hist,
+        "hold_histogram", hold_hist,
+        "threads", threads);
+
+done:
+    Py_XDECREF(wait_hist);
+    Py_XDECREF(hold_hist);
+    Py_XDECREF(threads);
+    return result;
+}
@@ -372,6 +372,133 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(sys__setgilpriority__doc__,
+"_setgilpriority($module, enabled, /)\n"
+"--\n"
+"\n"
+"Enable or disable handing the GIL over first to threads leaving I/O.\n"
+"\n"
+"When enabled, a thread returning from a blocking call which released\n"
+"the GIL asks the running thread to drop it immediately, instead of\n"
+"waiting for the switch interval to elapse, and is given the GIL ahead\n"
+"of other waiting threads.\n"
+"\n"
+"This lowers the latency of I/O-bound threads competing with CPU-bound\n"
+"threads, at the cost of more frequent thread switches.");
+
+#define SYS__SETGILPRIORITY_METHODDEF    \
+    {"_setgilpriority", (PyCFunction)sys__setgilpriority, METH_O, sys__setgilpriority__doc__},
+
+static PyObject *
+sys__setgilpriority_impl(PyObject *module, int enabled);
+
+static PyObject *
+sys__setgilpriority(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int enabled;
+
+    enabled = PyObject_IsTrue(arg);
+    if (enabled < 0) {
+        goto exit;
+    }
+    return_value = sys__setgilpriority_impl(module, enabled);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__getgilpriority__doc__,
+"_getgilpriority($module, /)\n"
+"--\n"
+"\n"
+"Return True if I/O priority GIL handoff is enabled.\n"
+"\n"
+"See sys._setgilpriority().");
+
+#define SYS__GETGILPRIORITY_METHODDEF    \
+    {"_getgilpriority", (PyCFunction)sys__getgilpriority, METH_NOARGS, sys__getgilpriority__doc__},
+
+static int
+sys__getgilpriority_impl(PyObject *module);
+
+static PyObject *
+sys__getgilpriority(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = sys__getgilpriority_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyBool_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__setgilstats__doc__,
+"_setgilstats($module, enabled, /)\n"
+"--\n"
+"\n"
+"Enable or disable GIL statistics; see sys._getgilstats().\n"
+"\n"
+"Enabling them resets all the counters.");
+
+#define SYS__SETGILSTATS_METHODDEF    \
+    {"_setgilstats", (PyCFunction)sys__setgilstats, METH_O, sys__setgilstats__doc__},
+
+static PyObject *
+sys__setgilstats_impl(PyObject *module, int enabled);
+
+static PyObject *
+sys__setgilstats(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int enabled;
+
+    enabled = PyObject_IsTrue(arg);
+    if (enabled < 0) {
+        goto exit;
+    }
+    return_value = sys__setgilstats_impl(module, enabled);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__getgilstats__doc__,
+"_getgilstats($module, /)\n"
+"--\n"
+"\n"
+"Return a dict of statistics about the GIL.\n"
+"\n"
+"The statistics are only gathered while enabled with sys._setgilstats().\n"
+"The dict has the number of GIL acquisitions (\"acquisitions\"), of those\n"
+"which had to wait for another thread (\"contended\"), of changes of the\n"
+"thread holding the GIL (\"switches\") and of drops where the dropping\n"
+"thread waited for another thread to take over (\"forced_switches\").\n"
+"\"drops\" maps the reasons the GIL was dropped (\"release\" around blocking\n"
+"calls, \"interval\" and \"priority\" when asked for by a waiting thread) to\n"
+"their count.  \"wait_time\" and \"hold_time\" are the total times in seconds\n"
+"spent waiting for and holding the GIL, and \"wait_histogram\" and\n"
+"\"hold_histogram\" count these durations by power-of-two buckets of\n"
+"microseconds.  \"threads\" maps thread identifiers to a tuple of the\n"
+"number of acquisitions and the wait time of each thread.");
+
+#define SYS__GETGILSTATS_METHODDEF    \
+    {"_getgilstats", (PyCFunction)sys__getgilstats, METH_NOARGS, sys__getgilstats__doc__},
+
+static PyObject *
+sys__getgilstats_impl(PyObject *module);
+
+static PyObject *
+sys__getgilstats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__getgilstats_impl(module);
+}
+
 PyDoc_STRVAR(sys_setrecursionlimit__doc__,
 "setrecursionlimit($module, limit, /)\n"
 "--\n"
@@ -947,6 +1074,31 @@ sys__clear_type_cache(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__clear_type_cache_impl(module);
 }
 
+PyDoc_STRVAR(sys__get_type_cache_stats__doc__,
+"_get_type_cache_stats($module, /)\n"
+"--\n"
+"\n"
+"Return a dict of statistics about the internal type lookup cache.\n"
+"\n"
+"The dict has the current number of entries (\"size\"), the number of\n"
+"live types with a valid version tag (\"versioned_types\"), the number\n"
+"of lookups answered from the cache (\"hits\"), the number of lookups\n"
+"which fell back to a walk of the MRO, either on an empty entry\n"
+"(\"misses\") or evicting another type or name (\"collisions\"), and the\n"
+"number of times the cache was grown or shrunk (\"resizes\").");
+
+#define SYS__GET_TYPE_CACHE_STATS_METHODDEF    \
+    {"_get_type_cache_stats", (PyCFunction)sys__get_type_cache_stats, METH_NOARGS, sys__get_type_cache_stats__doc__},
+
+static PyObject *
+sys__get_type_cache_stats_impl(PyObject *module);
+
+static PyObject *
+sys__get_type_cache_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__get_type_cache_stats_impl(module);
+}
+
 PyDoc_STRVAR(sys_is_finalizing__doc__,
 "is_finalizing($module, /)\n"
 "--\n"
@@ -1118,4 +1270,4 @@ sys_getandroidapilevel(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=41122dae1bb7158c input=a9049054013a1b77]*/
+/*[clinic end generated code: output=0116408506d9f738 input=a9049054013a1b77]*/
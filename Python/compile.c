@@ -35,6 +35,8 @@
 #include "pycore_pymem.h"         // _PyMem_IsPtrFreed()
 #include "pycore_symtable.h"      // PySTEntryObject
 
+#include "opcode_metadata.h"      // _PyOpcode_num_popped/pushed
+
 
 #define DEFAULT_BLOCK_SIZE 16
 #define DEFAULT_CODE_SIZE 128
@@ -285,6 +287,9 @@ typedef struct basicblock_ {
     unsigned b_cold : 1;
     /* b_warm is used by the cold-detection algorithm to mark blocks which are definitely not cold */
     unsigned b_warm : 1;
+    /* Locals which may be unbound on entry to the block, used by
+       add_checks_for_loads_of_unknown_variables() */
+    uint64_t *b_unbound;
 } basicblock;
 
 
@@ -493,13 +498,15 @@ static int compiler_sync_comprehension_generator(
                                       struct compiler *c,
                                       asdl_comprehension_seq *generators, int gen_index,
                                       int depth,
-                                      expr_ty elt, expr_ty val, int type);
+                                      expr_ty elt, expr_ty val, int type,
+                                      int iter_on_stack);
 
 static int compiler_async_comprehension_generator(
                                       struct compiler *c,
                                       asdl_comprehension_seq *generators, int gen_index,
                                       int depth,
-                                      expr_ty elt, expr_ty val, int type);
+                                      expr_ty elt, expr_ty val, int type,
+                                      int iter_on_stack);
 
 static int compiler_pattern(struct compiler *, pattern_ty, pattern_context *);
 static int compiler_match(struct compiler *, stmt_ty);
@@ -1009,46 +1016,23 @@ basicblock_next_instr(basicblock *b)
 static int
 stack_effect(int opcode, int oparg, int jump)
 {
+    /* Instructions declaring their stack effect in Python/bytecodes.c,
+       none of which jumps. */
+    int popped = _PyOpcode_num_popped(opcode, oparg);
+    int pushed = _PyOpcode_num_pushed(opcode, oparg);
+    if (popped >= 0 && pushed >= 0) {
+        return pushed - popped;
+    }
+
     switch (opcode) {
-        case NOP:
         case EXTENDED_ARG:
         case RESUME:
         case CACHE:
             return 0;
 
-        /* Stack manipulation */
-        case POP_TOP:
-            return -1;
-        case SWAP:
-            return 0;
-
-        /* Unary operators */
-        case UNARY_POSITIVE:
-        case UNARY_NEGATIVE:
-        case UNARY_NOT:
-        case UNARY_INVERT:
-            return 0;
-
-        case SET_ADD:
-        case LIST_APPEND:
-            return -1;
         case MAP_ADD:
             return -2;
 
-        case BINARY_SUBSCR:
-            return -1;
-        case BINARY_SLICE:
-            return -2;
-        case STORE_SUBSCR:
-            return -3;
-        case STORE_SLICE:
-            return -4;
-        case DELETE_SUBSCR:
-            return -2;
-
-        case GET_ITER:
-            return 0;
-
         case PRINT_EXPR:
             return -1;
         case LOAD_BUILD_CLASS:
@@ -1089,14 +1073,9 @@ stack_effect(int opcode, int oparg, int jump)
             return -1;
         case DELETE_GLOBAL:
             return 0;
-        case LOAD_CONST:
-            return 1;
         case LOAD_NAME:
             return 1;
-        case BUILD_TUPLE:
-        case BUILD_LIST:
         case BUILD_SET:
-        case BUILD_STRING:
             return 1-oparg;
         case BUILD_MAP:
             return 1 - 2*oparg;
@@ -1105,8 +1084,6 @@ stack_effect(int opcode, int oparg, int jump)
         case LOAD_ATTR:
             return (oparg & 1);
         case COMPARE_OP:
-        case IS_OP:
-        case CONTAINS_OP:
             return -1;
         case CHECK_EXC_MATCH:
             return 0;
@@ -1172,10 +1149,7 @@ stack_effect(int opcode, int oparg, int jump)
         case WITH_EXCEPT_START:
             return 1;
 
-        case LOAD_FAST:
-        case LOAD_FAST_CHECK:
-            return 1;
-        case STORE_FAST:
+        case STORE_FAST_MAYBE_NULL:
             return -1;
         case DELETE_FAST:
             return 0;
@@ -1207,8 +1181,6 @@ stack_effect(int opcode, int oparg, int jump)
         case MAKE_CELL:
         case COPY_FREE_VARS:
             return 0;
-        case LOAD_CLOSURE:
-            return 1;
         case LOAD_DEREF:
         case LOAD_CLASSDEREF:
             return 1;
@@ -1249,14 +1221,10 @@ stack_effect(int opcode, int oparg, int jump)
             return -1;
         case MATCH_CLASS:
             return -2;
-        case GET_LEN:
         case MATCH_MAPPING:
         case MATCH_SEQUENCE:
         case MATCH_KEYS:
             return 1;
-        case COPY:
-        case PUSH_NULL:
-            return 1;
         case BINARY_OP:
             return -1;
         default:
@@ -5096,6 +5064,12 @@ compiler_call_helper(struct compiler *c,
   flagged in symtable.c as a generator, so it returns the generator object
   when the function is called.
 
+  Within a function, list, set and dict comprehensions are usually inlined
+  instead (see can_inline_comprehension() in symtable.c): the loop runs in
+  the enclosing frame, and the names bound by the comprehension are saved on
+  the stack with LOAD_FAST_AND_CLEAR before it and restored after it, even
+  if it raises, so they still don't leak.
+
   Possible cleanups:
     - iterate over the generator sequence instead of using recursion
 */
@@ -5105,16 +5079,17 @@ static int
 compiler_comprehension_generator(struct compiler *c,
                                  asdl_comprehension_seq *generators, int gen_index,
                                  int depth,
-                                 expr_ty elt, expr_ty val, int type)
+                                 expr_ty elt, expr_ty val, int type,
+                                 int iter_on_stack)
 {
     comprehension_ty gen;
     gen = (comprehension_ty)asdl_seq_GET(generators, gen_index);
     if (gen->is_async) {
         return compiler_async_comprehension_generator(
-            c, generators, gen_index, depth, elt, val, type);
+            c, generators, gen_index, depth, elt, val, type, iter_on_stack);
     } else {
         return compiler_sync_comprehension_generator(
-            c, generators, gen_index, depth, elt, val, type);
+            c, generators, gen_index, depth, elt, val, type, iter_on_stack);
     }
 }
 
@@ -5122,7 +5097,8 @@ static int
 compiler_sync_comprehension_generator(struct compiler *c,
                                       asdl_comprehension_seq *generators, int gen_index,
                                       int depth,
-                                      expr_ty elt, expr_ty val, int type)
+                                      expr_ty elt, expr_ty val, int type,
+                                      int iter_on_stack)
 {
     /* generate code for the iterator, then each of the ifs,
        and then write to the element */
@@ -5137,9 +5113,12 @@ compiler_sync_comprehension_generator(struct compiler *c,
     gen = (comprehension_ty)asdl_seq_GET(generators, gen_index);
 
     if (gen_index == 0) {
-        /* Receive outermost iter as an implicit argument */
-        c->u->u_argcount = 1;
-        ADDOP_I(c, LOAD_FAST, 0);
+        /* Receive outermost iter as an implicit argument, unless the
+           comprehension is inlined and it is already on the stack */
+        if (!iter_on_stack) {
+            c->u->u_argcount = 1;
+            ADDOP_I(c, LOAD_FAST, 0);
+        }
     }
     else {
         /* Sub-iter - calculate on the fly */
@@ -5187,7 +5166,7 @@ compiler_sync_comprehension_generator(struct compiler *c,
     if (++gen_index < asdl_seq_LEN(generators))
         if (!compiler_comprehension_generator(c,
                                               generators, gen_index, depth,
-                                              elt, val, type))
+                                              elt, val, type, 0))
         return 0;
 
     /* only append after the last for generator */
@@ -5233,7 +5212,8 @@ static int
 compiler_async_comprehension_generator(struct compiler *c,
                                       asdl_comprehension_seq *generators, int gen_index,
                                       int depth,
-                                      expr_ty elt, expr_ty val, int type)
+                                      expr_ty elt, expr_ty val, int type,
+                                      int iter_on_stack)
 {
     comprehension_ty gen;
     Py_ssize_t i, n;
@@ -5244,9 +5224,12 @@ compiler_async_comprehension_generator(struct compiler *c,
     gen = (comprehension_ty)asdl_seq_GET(generators, gen_index);
 
     if (gen_index == 0) {
-        /* Receive outermost iter as an implicit argument */
-        c->u->u_argcount = 1;
-        ADDOP_I(c, LOAD_FAST, 0);
+        /* Receive outermost iter as an implicit argument, unless the
+           comprehension is inlined and it is already on the stack */
+        if (!iter_on_stack) {
+            c->u->u_argcount = 1;
+            ADDOP_I(c, LOAD_FAST, 0);
+        }
     }
     else {
         /* Sub-iter - calculate on the fly */
@@ -5279,7 +5262,7 @@ compiler_async_comprehension_generator(struct compiler *c,
     if (++gen_index < asdl_seq_LEN(generators))
         if (!compiler_comprehension_generator(c,
                                               generators, gen_index, depth,
-                                              elt, val, type))
+                                              elt, val, type, 0))
         return 0;
 
     /* only append after the last for generator */
@@ -5324,6 +5307,175 @@ compiler_async_comprehension_generator(struct compiler *c,
     return 1;
 }
 
+typedef struct {
+    PyObject *pushed_locals;    /* names saved on the stack, in push order */
+    PyObject *temp_symbols;     /* symbols of the enclosing scope overridden
+                                   while compiling the comprehension */
+} inlined_comprehension_state;
+
+static int
+push_inlined_comprehension_state(struct compiler *c, PySTEntryObject *entry,
+                                 inlined_comprehension_state *state)
+{
+    PyObject *symbols = c->u->u_ste->ste_symbols;
+    PyObject *k, *v;
+    Py_ssize_t pos = 0;
+
+    while (PyDict_Next(entry->ste_symbols, &pos, &k, &v)) {
+        long symbol = PyLong_AS_LONG(v);
+        long scope = (symbol >> SCOPE_OFFSET) & SCOPE_MASK;
+        if (scope != LOCAL || (symbol & DEF_PARAM)) {
+            /* not bound by the comprehension, or its ".0" argument */
+            continue;
+        }
+        /* The symbol table merged the comprehension's names into the
+           enclosing scope. */
+        PyObject *outv = PyDict_GetItemWithError(symbols, k);
+        if (outv == NULL) {
+            assert(PyErr_Occurred());
+            return 0;
+        }
+        long outsc = (PyLong_AS_LONG(outv) >> SCOPE_OFFSET) & SCOPE_MASK;
+        if (outsc != LOCAL) {
+            /* A global or a cell outside of the comprehension: use the
+               comprehension's symbol while compiling it. */
+            if (state->temp_symbols == NULL) {
+                state->temp_symbols = PyDict_New();
+                if (state->temp_symbols == NULL) {
+                    return 0;
+                }
+            }
+            if (PyDict_SetItem(state->temp_symbols, k, outv) < 0 ||
+                PyDict_SetItem(symbols, k, v) < 0)
+            {
+                return 0;
+            }
+        }
+        if (state->pushed_locals == NULL) {
+            state->pushed_locals = PyList_New(0);
+            if (state->pushed_locals == NULL) {
+                return 0;
+            }
+        }
+        if (PyList_Append(state->pushed_locals, k) < 0) {
+            return 0;
+        }
+        /* Save the outer value (or NULL) and unbind the name */
+        ADDOP_NAME(c, LOAD_FAST_AND_CLEAR, k, varnames);
+    }
+    if (state->pushed_locals != NULL) {
+        /* Bring the outermost iterator back on top of the saved values.
+           This rotates them, restore_inlined_comprehension_locals()
+           undoes it. */
+        ADDOP_I(c, SWAP, PyList_GET_SIZE(state->pushed_locals) + 1);
+    }
+    return 1;
+}
+
+static int
+restore_inlined_comprehension_locals(struct compiler *c,
+                                     inlined_comprehension_state *state)
+{
+    Py_ssize_t n = PyList_GET_SIZE(state->pushed_locals);
+    /* Keep the result (or the exception) below the saved values */
+    ADDOP_I(c, SWAP, n + 1);
+    for (Py_ssize_t i = n - 1; i >= 0; i--) {
+        PyObject *k = PyList_GET_ITEM(state->pushed_locals, i);
+        ADDOP_NAME(c, STORE_FAST_MAYBE_NULL, k, varnames);
+    }
+    return 1;
+}
+
+static int
+pop_inlined_comprehension_state(struct compiler *c,
+                                inlined_comprehension_state *state)
+{
+    int res = 1;
+    if (state->temp_symbols != NULL) {
+        PyObject *k, *v;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(state->temp_symbols, &pos, &k, &v)) {
+            if (PyDict_SetItem(c->u->u_ste->ste_symbols, k, v) < 0) {
+                res = 0;
+                break;
+            }
+        }
+    }
+    Py_CLEAR(state->temp_symbols);
+    Py_CLEAR(state->pushed_locals);
+    return res;
+}
+
+static int
+compiler_inlined_comprehension(struct compiler *c, expr_ty e, int type,
+                               asdl_comprehension_seq *generators,
+                               expr_ty elt, expr_ty val,
+                               PySTEntryObject *entry,
+                               inlined_comprehension_state *state)
+{
+    comprehension_ty outermost;
+    int op;
+
+    switch (type) {
+    case COMP_LISTCOMP:
+        op = BUILD_LIST;
+        break;
+    case COMP_SETCOMP:
+        op = BUILD_SET;
+        break;
+    case COMP_DICTCOMP:
+        op = BUILD_MAP;
+        break;
+    default:
+        PyErr_Format(PyExc_SystemError,
+                     "cannot inline comprehension type %d", type);
+        return 0;
+    }
+
+    outermost = (comprehension_ty) asdl_seq_GET(generators, 0);
+    assert(!outermost->is_async);
+    VISIT(c, expr, outermost->iter);
+    ADDOP(c, GET_ITER);
+    if (!push_inlined_comprehension_state(c, entry, state)) {
+        return 0;
+    }
+
+    NEW_JUMP_TARGET_LABEL(c, cleanup);
+    NEW_JUMP_TARGET_LABEL(c, end);
+    if (state->pushed_locals != NULL) {
+        /* No fblock: there is no return, break or continue in a
+           comprehension. */
+        ADDOP_JUMP(c, SETUP_FINALLY, cleanup);
+    }
+
+    ADDOP_I(c, op, 0);
+    ADDOP_I(c, SWAP, 2);
+    if (!compiler_comprehension_generator(c, generators, 0, 0, elt,
+                                          val, type, 1))
+        return 0;
+
+    if (state->pushed_locals == NULL) {
+        return 1;
+    }
+    ADDOP(c, POP_BLOCK);
+    ADDOP_JUMP(c, JUMP, end);
+
+    /* The comprehension raised: restore the saved values and reraise */
+    USE_LABEL(c, cleanup);
+    UNSET_LOC(c);
+    /* Discard the incomplete result below the exception */
+    ADDOP_I(c, SWAP, 2);
+    ADDOP(c, POP_TOP);
+    if (!restore_inlined_comprehension_locals(c, state)) {
+        return 0;
+    }
+    ADDOP_I(c, RERAISE, 0);
+
+    USE_LABEL(c, end);
+    SET_LOC(c, e);
+    return restore_inlined_comprehension_locals(c, state);
+}
+
 static int
 compiler_comprehension(struct compiler *c, expr_ty e, int type,
                        identifier name, asdl_comprehension_seq *generators, expr_ty elt,
@@ -5336,6 +5488,22 @@ compiler_comprehension(struct compiler *c, expr_ty e, int type,
     int is_async_generator = 0;
     int is_top_level_await = IS_TOP_LEVEL_AWAIT(c);
 
+    PySTEntryObject *entry = PySymtable_Lookup(c->c_st, (void *)e);
+    if (entry == NULL) {
+        return 0;
+    }
+    if (entry->ste_comp_inlined) {
+        inlined_comprehension_state state = {NULL, NULL};
+        int res = compiler_inlined_comprehension(c, e, type, generators,
+                                                 elt, val, entry, &state);
+        if (!pop_inlined_comprehension_state(c, &state)) {
+            res = 0;
+        }
+        Py_DECREF(entry);
+        return res;
+    }
+    Py_DECREF(entry);
+
     outermost = (comprehension_ty) asdl_seq_GET(generators, 0);
     if (!compiler_enter_scope(c, name, COMPILER_SCOPE_COMPREHENSION,
                               (void *)e, e->lineno))
@@ -5378,7 +5546,7 @@ compiler_comprehension(struct compiler *c, expr_ty e, int type,
     }
 
     if (!compiler_comprehension_generator(c, generators, 0, 0, elt,
-                                          val, type))
+                                          val, type, 0))
         goto error_in_scope;
 
     if (type != COMP_GENEXP) {
@@ -7860,19 +8028,53 @@ assemble_jump_offsets(basicblock *entryblock)
 }
 
 
-// Ensure each basicblock is only put onto the stack once.
-#define MAYBE_PUSH(B) do {                          \
-        if ((B)->b_visited == 0) {                  \
-            *(*stack_top)++ = (B);                  \
-            (B)->b_visited = 1;                     \
-        }                                           \
-    } while (0)
+/* Find the locals which may be unbound at each LOAD_FAST, and make those
+   loads LOAD_FAST_CHECK.
+
+   This is a forward dataflow analysis over all locals at once.  The state
+   at any point is a bit vector of the locals which may be unbound there,
+   followed by a bit vector of the locals which may have been unbound when
+   last saved by LOAD_FAST_AND_CLEAR: an inlined comprehension saves the
+   outer value of its iteration variables that way and puts it back with
+   STORE_FAST_MAYBE_NULL, which thus only leaves the local unbound if it may
+   have been before the comprehension.  The entry state of a block is the
+   union of the states flowing into it, including those at each instruction
+   covered by an exception handler, and the analysis runs until no entry
+   state changes.  States only ever grow, so a LOAD_FAST can be rewritten as
+   soon as the local is found to be possibly unbound. */
+
+#define UNBOUND_TEST(V, I) (((V)[(I) / 64] >> ((I) % 64)) & 1)
+#define UNBOUND_SET(V, I) ((V)[(I) / 64] |= (uint64_t)1 << ((I) % 64))
+#define UNBOUND_CLEAR(V, I) ((V)[(I) / 64] &= ~((uint64_t)1 << ((I) % 64)))
 
+// Merge a state into the entry state of b, and schedule b if it grew.
 static void
-scan_block_for_local(int target, basicblock *b, bool unsafe_to_start,
+merge_unbound_locals(basicblock *b, const uint64_t *state, int nwords,
                      basicblock ***stack_top)
 {
-    bool unsafe = unsafe_to_start;
+    bool changed = false;
+    for (int i = 0; i < nwords; i++) {
+        uint64_t merged = b->b_unbound[i] | state[i];
+        if (merged != b->b_unbound[i]) {
+            b->b_unbound[i] = merged;
+            changed = true;
+        }
+    }
+    if (changed && !b->b_visited) {
+        *(*stack_top)++ = b;
+        b->b_visited = 1;
+    }
+}
+
+static void
+scan_block_for_unbound_locals(basicblock *b, uint64_t *state, int nlocals,
+                              int nwords, basicblock ***stack_top)
+{
+    uint64_t *unbound = state;
+    uint64_t *saved = state + nwords / 2;
+    memcpy(state, b->b_unbound, nwords * sizeof(uint64_t));
+    basicblock *handler = NULL;
+    bool dirty = true;
     for (int i = 0; i < b->b_iused; i++) {
         struct instr *instr = &b->b_instr[i];
         assert(instr->i_opcode != EXTENDED_ARG);
@@ -7882,86 +8084,142 @@ scan_block_for_local(int target, basicblock *b, bool unsafe_to_start,
         assert(instr->i_opcode != LOAD_CONST__LOAD_FAST);
         assert(instr->i_opcode != STORE_FAST__STORE_FAST);
         assert(instr->i_opcode != LOAD_FAST__LOAD_CONST);
-        if (unsafe && instr->i_except != NULL) {
-            MAYBE_PUSH(instr->i_except);
-        }
-        if (instr->i_oparg != target) {
-            continue;
+        if (instr->i_except != NULL && (dirty || instr->i_except != handler)) {
+            handler = instr->i_except;
+            merge_unbound_locals(handler, state, nwords, stack_top);
+            dirty = false;
         }
+        int target = instr->i_oparg;
         switch (instr->i_opcode) {
-            case LOAD_FAST_CHECK:
-                // if this doesn't raise, then var is defined
-                unsafe = false;
-                break;
             case LOAD_FAST:
-                if (unsafe) {
+                // LOAD_FAST of a cell (from LOAD_CLOSURE) is always safe
+                if (target >= nlocals) {
+                    break;
+                }
+                if (UNBOUND_TEST(unbound, target)) {
                     instr->i_opcode = LOAD_FAST_CHECK;
                 }
-                unsafe = false;
-                break;
+                /* fall through */
+            case LOAD_FAST_CHECK:
+                // if this doesn't raise, then var is defined
             case STORE_FAST:
-                unsafe = false;
+                UNBOUND_CLEAR(unbound, target);
+                dirty = true;
                 break;
             case DELETE_FAST:
-                unsafe = true;
+                UNBOUND_SET(unbound, target);
+                dirty = true;
+                break;
+            case LOAD_FAST_AND_CLEAR:
+                if (UNBOUND_TEST(unbound, target)) {
+                    UNBOUND_SET(saved, target);
+                }
+                UNBOUND_SET(unbound, target);
+                dirty = true;
+                break;
+            case STORE_FAST_MAYBE_NULL:
+                if (UNBOUND_TEST(saved, target)) {
+                    UNBOUND_SET(unbound, target);
+                }
+                else {
+                    UNBOUND_CLEAR(unbound, target);
+                }
+                dirty = true;
                 break;
         }
     }
-    if (unsafe) {
-        // unsafe at end of this block,
-        // so unsafe at start of next blocks
-        if (b->b_next && BB_HAS_FALLTHROUGH(b)) {
-            MAYBE_PUSH(b->b_next);
-        }
-        if (b->b_iused > 0) {
-            struct instr *last = &b->b_instr[b->b_iused-1];
-            if (is_jump(last)) {
-                assert(last->i_target != NULL);
-                MAYBE_PUSH(last->i_target);
-            }
-        }
+    if (b->b_next && BB_HAS_FALLTHROUGH(b)) {
+        merge_unbound_locals(b->b_next, state, nwords, stack_top);
+    }
+    struct instr *last = basicblock_last_instr(b);
+    if (last != NULL && is_jump(last)) {
+        assert(last->i_target != NULL);
+        merge_unbound_locals(last->i_target, state, nwords, stack_top);
     }
 }
-#undef MAYBE_PUSH
 
 static int
 add_checks_for_loads_of_unknown_variables(basicblock *entryblock,
                                           struct compiler *c)
 {
+    Py_ssize_t nparams = PyList_GET_SIZE(c->u->u_ste->ste_varnames);
+    int nlocals = (int)PyDict_GET_SIZE(c->u->u_varnames);
+    if (nlocals == 0) {
+        return 0;
+    }
+    // Two bit vectors of nlocals bits each, see above.
+    int nwords = 2 * ((nlocals + 63) / 64);
+    int nblocks = 0;
+    for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
+        nblocks++;
+    }
+    if ((size_t)nblocks + 1 > PY_SSIZE_T_MAX / sizeof(uint64_t) / nwords) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    uint64_t *states = PyMem_Calloc((size_t)(nblocks + 1) * nwords,
+                                    sizeof(uint64_t));
+    if (states == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
     basicblock **stack = make_cfg_traversal_stack(entryblock);
     if (stack == NULL) {
+        PyMem_Free(states);
         return -1;
     }
-    Py_ssize_t nparams = PyList_GET_SIZE(c->u->u_ste->ste_varnames);
-    int nlocals = (int)PyDict_GET_SIZE(c->u->u_varnames);
-    for (int target = 0; target < nlocals; target++) {
-        for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
-            b->b_visited = 0;
-        }
-        basicblock **stack_top = stack;
+    uint64_t *state = states + (size_t)nblocks * nwords;
 
-        // First pass: find the relevant DFS starting points:
-        // the places where "being uninitialized" originates,
-        // which are the entry block and any DELETE_FAST statements.
-        if (target >= nparams) {
-            // only non-parameter locals start out uninitialized.
-            *(stack_top++) = entryblock;
-            entryblock->b_visited = 1;
-        }
-        for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
-            scan_block_for_local(target, b, false, &stack_top);
-        }
+    // Every block is scanned at least once, since DELETE_FAST and
+    // LOAD_FAST_AND_CLEAR unbind locals whatever the entry state.  Push
+    // the blocks in reverse order to start from the entry block.
+    basicblock **stack_top = stack + nblocks;
+    uint64_t *block_state = states;
+    for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
+        b->b_unbound = block_state;
+        block_state += nwords;
+        *--stack_top = b;
+        b->b_visited = 1;
+    }
+    stack_top = stack + nblocks;
+    // only non-parameter locals start out unbound.
+    for (int target = (int)nparams; target < nlocals; target++) {
+        UNBOUND_SET(entryblock->b_unbound, target);
+    }
 
-        // Second pass: Depth-first search to propagate uncertainty
-        while (stack_top > stack) {
-            basicblock *b = *--stack_top;
-            scan_block_for_local(target, b, true, &stack_top);
-        }
+    while (stack_top > stack) {
+        basicblock *b = *--stack_top;
+        b->b_visited = 0;
+        scan_block_for_unbound_locals(b, state, nlocals, nwords, &stack_top);
+    }
+
+    for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
+        b->b_unbound = NULL;
     }
     PyMem_Free(stack);
+    PyMem_Free(states);
     return 0;
 }
 
+#undef UNBOUND_TEST
+#undef UNBOUND_SET
+#undef UNBOUND_CLEAR
+
+/* STORE_FAST_MAYBE_NULL only exists so that the pass above does not treat
+   the local as initialized; it is a plain STORE_FAST at runtime. */
+static void
+convert_maybe_null_stores(basicblock *entryblock)
+{
+    for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
+        for (int i = 0; i < b->b_iused; i++) {
+            struct instr *instr = &b->b_instr[i];
+            if (instr->i_opcode == STORE_FAST_MAYBE_NULL) {
+                instr->i_opcode = STORE_FAST;
+            }
+        }
+    }
+}
+
 static PyObject *
 dict_keys_inorder(PyObject *dict, Py_ssize_t offset)
 {
@@ -8261,7 +8519,8 @@ static int
 calculate_jump_targets(basicblock *entryblock);
 
 static int
-optimize_cfg(basicblock *entryblock, PyObject *consts, PyObject *const_cache);
+optimize_cfg(basicblock *entryblock, PyObject *consts, PyObject *const_cache,
+             int nlocals);
 
 static int
 trim_unused_consts(basicblock *entryblock, PyObject *consts);
@@ -8588,7 +8847,7 @@ assemble(struct compiler *c, int addNone)
     if (calculate_jump_targets(entryblock)) {
         goto error;
     }
-    if (optimize_cfg(entryblock, consts, c->c_const_cache)) {
+    if (optimize_cfg(entryblock, consts, c->c_const_cache, nlocals)) {
         goto error;
     }
     if (trim_unused_consts(entryblock, consts)) {
@@ -8628,6 +8887,7 @@ assemble(struct compiler *c, int addNone)
     if (add_checks_for_loads_of_unknown_variables(entryblock, c) < 0) {
         goto error;
     }
+    convert_maybe_null_stores(entryblock);
 
     /* Can't modify the bytecode after computing jump offsets. */
     assemble_jump_offsets(entryblock);
@@ -8877,7 +9137,13 @@ swaptimize(basicblock *block, int *ix)
 // - can't invoke arbitrary code (besides finalizers)
 // - only touch the TOS (and pop it when finished)
 #define SWAPPABLE(opcode) \
-    ((opcode) == STORE_FAST || (opcode) == POP_TOP)
+    ((opcode) == STORE_FAST || (opcode) == STORE_FAST_MAYBE_NULL || \
+     (opcode) == POP_TOP)
+
+#define STORES_TO(instr) \
+    (((instr).i_opcode == STORE_FAST || \
+      (instr).i_opcode == STORE_FAST_MAYBE_NULL) \
+     ? (instr).i_oparg : -1)
 
 static int
 next_swappable_instruction(basicblock *block, int i, int lineno)
@@ -8930,6 +9196,24 @@ apply_static_swaps(basicblock *block, int i)
                 return;
             }
         }
+        // The reordering is not safe if the two instructions to be swapped
+        // store to the same location, or if any intervening instruction
+        // stores to the same location as either of them:
+        int store_j = STORES_TO(block->b_instr[j]);
+        int store_k = STORES_TO(block->b_instr[k]);
+        if (store_j >= 0 || store_k >= 0) {
+            if (store_j == store_k) {
+                return;
+            }
+            for (int idx = j + 1; idx < k; idx++) {
+                int store_idx = STORES_TO(block->b_instr[idx]);
+                if (store_idx >= 0 &&
+                    (store_idx == store_j || store_idx == store_k))
+                {
+                    return;
+                }
+            }
+        }
         // Success!
         swap->i_opcode = NOP;
         struct instr temp = block->b_instr[j];
@@ -8961,6 +9245,75 @@ jump_thread(struct instr *inst, struct instr *target, int opcode)
 /* Maximum size of basic block that should be copied in optimizer */
 #define MAX_COPY_SIZE 4
 
+/* Forward constants through locals within a line: in
+
+       LOAD_CONST c; STORE_FAST x; ...; LOAD_FAST x
+
+   the LOAD_FAST becomes LOAD_CONST c (the very same object) if x is not
+   stored to in between, so that the constant can be folded into whatever
+   follows.  Like apply_static_swaps(), this never looks past the end of a
+   line, so the locals seen (and set) by a tracing function are unaffected.
+*/
+static int
+forward_constants_through_locals(basicblock *entryblock, int nlocals)
+{
+    if (nlocals == 0) {
+        return 0;
+    }
+    /* For each local, the position of the last LOAD_CONST; STORE_FAST pair
+       to it, and the constant stored.  Only positions at or after
+       line_start belong to the current line. */
+    int *stored_at = PyMem_Malloc(2 * (size_t)nlocals * sizeof(int));
+    if (stored_at == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    int *stored_const = stored_at + nlocals;
+    for (int i = 0; i < nlocals; i++) {
+        stored_at[i] = -1;
+    }
+    int pos = 0;
+    for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
+        int line_start = pos;
+        int lineno = -1;
+        for (int i = 0; i < b->b_iused; i++, pos++) {
+            struct instr *instr = &b->b_instr[i];
+            // Instructions without a line number belong to the line before
+            if (i == 0 ||
+                (instr->i_loc.lineno >= 0 && instr->i_loc.lineno != lineno))
+            {
+                lineno = instr->i_loc.lineno;
+                line_start = pos;
+            }
+            int oparg = instr->i_oparg;
+            switch (instr->i_opcode) {
+                case LOAD_FAST:
+                    if (oparg < nlocals && stored_at[oparg] >= line_start) {
+                        instr->i_opcode = LOAD_CONST;
+                        instr->i_oparg = stored_const[oparg];
+                    }
+                    break;
+                case STORE_FAST:
+                    if (pos > line_start && instr[-1].i_opcode == LOAD_CONST) {
+                        stored_at[oparg] = pos;
+                        stored_const[oparg] = instr[-1].i_oparg;
+                        break;
+                    }
+                    /* fall through */
+                case DELETE_FAST:
+                case LOAD_FAST_AND_CLEAR:
+                case STORE_FAST_MAYBE_NULL:
+                    if (oparg < nlocals) {
+                        stored_at[oparg] = -1;
+                    }
+                    break;
+            }
+        }
+    }
+    PyMem_Free(stored_at);
+    return 0;
+}
+
 /* Optimization */
 static int
 optimize_basic_block(PyObject *const_cache, basicblock *bb, PyObject *consts)
@@ -8994,6 +9347,11 @@ optimize_basic_block(PyObject *const_cache, basicblock *bb, PyObject *consts)
                 int is_true;
                 int jump_if_true;
                 switch(nextop) {
+                    case POP_TOP:
+                        /* Remove LOAD_CONST const; POP_TOP */
+                        inst->i_opcode = NOP;
+                        bb->b_instr[i+1].i_opcode = NOP;
+                        break;
                     case POP_JUMP_IF_FALSE:
                     case POP_JUMP_IF_TRUE:
                         cnt = get_const_value(inst->i_opcode, oparg, consts);
@@ -9183,6 +9541,23 @@ optimize_basic_block(PyObject *const_cache, basicblock *bb, PyObject *consts)
                 }
                 apply_static_swaps(bb, i);
                 break;
+            case COPY:
+                /* Remove COPY 1; POP_TOP */
+                if (oparg == 1 && nextop == POP_TOP) {
+                    inst->i_opcode = NOP;
+                    bb->b_instr[i+1].i_opcode = NOP;
+                }
+                break;
+            case STORE_FAST:
+                /* Replace the first of STORE_FAST x; STORE_FAST x, a dead
+                   store, with POP_TOP. */
+                if (nextop == STORE_FAST && oparg == bb->b_instr[i+1].i_oparg &&
+                    inst->i_loc.lineno == bb->b_instr[i+1].i_loc.lineno)
+                {
+                    inst->i_opcode = POP_TOP;
+                    inst->i_oparg = 0;
+                }
+                break;
             case KW_NAMES:
                 break;
             case PUSH_NULL:
@@ -9481,7 +9856,8 @@ calculate_jump_targets(basicblock *entryblock)
 */
 
 static int
-optimize_cfg(basicblock *entryblock, PyObject *consts, PyObject *const_cache)
+optimize_cfg(basicblock *entryblock, PyObject *consts, PyObject *const_cache,
+             int nlocals)
 {
     assert(PyDict_CheckExact(const_cache));
     for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
@@ -9494,6 +9870,9 @@ optimize_cfg(basicblock *entryblock, PyObject *consts, PyObject *const_cache)
             return -1;
         }
     }
+    if (forward_constants_through_locals(entryblock, nlocals)) {
+        return -1;
+    }
     for (basicblock *b = entryblock; b != NULL; b = b->b_next) {
         if (optimize_basic_block(const_cache, b, consts)) {
             return -1;
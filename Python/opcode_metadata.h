@@ -0,0 +1,176 @@
+// This file is generated by Tools/cases_generator/generate_cases.py
+// from Python/bytecodes.c
+// Do not edit!
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+/* The number of stack items popped by an instruction, or -1 if it doesn't
+   declare its stack effect in Python/bytecodes.c. */
+static inline int
+_PyOpcode_num_popped(int opcode, int oparg)
+{
+    switch (opcode) {
+        case NOP:
+            return 0;
+        case LOAD_CLOSURE:
+            return 0;
+        case LOAD_FAST_CHECK:
+            return 0;
+        case LOAD_FAST:
+            return 0;
+        case LOAD_FAST_AND_CLEAR:
+            return 0;
+        case LOAD_CONST:
+            return 0;
+        case STORE_FAST:
+            return 1;
+        case POP_TOP:
+            return 1;
+        case PUSH_NULL:
+            return 0;
+        case UNARY_POSITIVE:
+            return 1;
+        case UNARY_NEGATIVE:
+            return 1;
+        case UNARY_NOT:
+            return 1;
+        case UNARY_INVERT:
+            return 1;
+        case BINARY_SUBSCR:
+            return 2;
+        case BINARY_SLICE:
+            return 3;
+        case STORE_SLICE:
+            return 4;
+        case LIST_APPEND:
+            return 2 + (oparg-1);
+        case SET_ADD:
+            return 2 + (oparg-1);
+        case STORE_SUBSCR:
+            return 3;
+        case DELETE_SUBSCR:
+            return 2;
+        case BUILD_STRING:
+            return oparg;
+        case BUILD_TUPLE:
+            return oparg;
+        case BUILD_LIST:
+            return oparg;
+        case IS_OP:
+            return 2;
+        case CONTAINS_OP:
+            return 2;
+        case GET_LEN:
+            return 1;
+        case GET_ITER:
+            return 1;
+        case COPY:
+            return 1 + (oparg-1);
+        case SWAP:
+            return 2 + (oparg-2);
+        default:
+            return -1;
+    }
+}
+
+/* The number of stack items pushed by an instruction, or -1 if it doesn't
+   declare its stack effect in Python/bytecodes.c. */
+static inline int
+_PyOpcode_num_pushed(int opcode, int oparg)
+{
+    switch (opcode) {
+        case NOP:
+            return 0;
+        case LOAD_CLOSURE:
+            return 1;
+        case LOAD_FAST_CHECK:
+            return 1;
+        case LOAD_FAST:
+            return 1;
+        case LOAD_FAST_AND_CLEAR:
+            return 1;
+        case LOAD_CONST:
+            return 1;
+        case STORE_FAST:
+            return 0;
+        case POP_TOP:
+            return 0;
+        case PUSH_NULL:
+            return 1;
+        case UNARY_POSITIVE:
+            return 1;
+        case UNARY_NEGATIVE:
+            return 1;
+        case UNARY_NOT:
+            return 1;
+        case UNARY_INVERT:
+            return 1;
+        case BINARY_SUBSCR:
+            return 1;
+        case BINARY_SLICE:
+            return 1;
+        case STORE_SLICE:
+            return 0;
+        case LIST_APPEND:
+            return 1 + (oparg-1);
+        case SET_ADD:
+            return 1 + (oparg-1);
+        case STORE_SUBSCR:
+            return 0;
+        case DELETE_SUBSCR:
+            return 0;
+        case BUILD_STRING:
+            return 1;
+        case BUILD_TUPLE:
+            return 1;
+        case BUILD_LIST:
+            return 1;
+        case IS_OP:
+            return 1;
+        case CONTAINS_OP:
+            return 1;
+        case GET_LEN:
+            return 2;
+        case GET_ITER:
+            return 1;
+        case COPY:
+            return 2 + (oparg-1);
+        case SWAP:
+            return 2 + (oparg-2);
+        default:
+            return -1;
+    }
+}
+
+/* The superinstruction made of the instructions first and second, or 0. */
+static inline int
+_PyOpcode_super_instruction(int first, int second)
+{
+    switch (first) {
+        case LOAD_CONST:
+            switch (second) {
+                case LOAD_FAST:
+                    return LOAD_CONST__LOAD_FAST;
+            }
+            break;
+        case LOAD_FAST:
+            switch (second) {
+                case LOAD_CONST:
+                    return LOAD_FAST__LOAD_CONST;
+                case LOAD_FAST:
+                    return LOAD_FAST__LOAD_FAST;
+            }
+            break;
+        case STORE_FAST:
+            switch (second) {
+                case LOAD_FAST:
+                    return STORE_FAST__LOAD_FAST;
+                case STORE_FAST:
+                    return STORE_FAST__STORE_FAST;
+            }
+            break;
+    }
+    return 0;
+}
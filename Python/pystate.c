@@ -436,6 +436,26 @@ interpreter_clear(PyInterpreterState *interp, PyThreadState *tstate)
     Py_CLEAR(interp->sysdict);
     Py_CLEAR(interp->builtins);
 
+    for (int i = 0; i < DICT_MAX_WATCHERS; i++) {
+        if (i != DICT_SPECIALIZER_WATCHER) {
+            interp->dict_state.watchers[i] = NULL;
+        }
+    }
+
+    for (int i = 0; i < TYPE_MAX_WATCHERS; i++) {
+        interp->types.watchers[i] = NULL;
+    }
+
+    for (int i = 0; i < FUNC_MAX_WATCHERS; i++) {
+        interp->func_watchers[i] = NULL;
+    }
+    interp->active_func_watchers = 0;
+
+    for (int i = 0; i < CODE_MAX_WATCHERS; i++) {
+        interp->code_watchers[i] = NULL;
+    }
+    interp->active_code_watchers = 0;
+
     // XXX Once we have one allocator per interpreter (i.e.
     // per-interpreter GC) we must ensure that all of the interpreter's
     // objects have been cleaned up at the point.
@@ -7,8 +7,10 @@
 #include "pycore_moduleobject.h"
 #include "pycore_object.h"
 #include "pycore_opcode.h"        // _PyOpcode_Caches
+#include "pycore_typeobject.h"    // _Py_slot_tp_getattro()
 #include "structmember.h"         // struct PyMemberDef, T_OFFSET_EX
 #include "pycore_descrobject.h"
+#include "opcode_metadata.h"      // _PyOpcode_super_instruction()
 
 #include <stdlib.h> // rand()
 
@@ -23,6 +25,7 @@ uint8_t _PyOpcode_Adaptive[256] = {
     [LOAD_GLOBAL] = LOAD_GLOBAL_ADAPTIVE,
     [BINARY_SUBSCR] = BINARY_SUBSCR_ADAPTIVE,
     [STORE_SUBSCR] = STORE_SUBSCR_ADAPTIVE,
+    [BINARY_SLICE] = BINARY_SLICE_ADAPTIVE,
     [CALL] = CALL_ADAPTIVE,
     [STORE_ATTR] = STORE_ATTR_ADAPTIVE,
     [BINARY_OP] = BINARY_OP_ADAPTIVE,
@@ -304,34 +307,14 @@ _PyCode_Quicken(PyCodeObject *code)
                 case RESUME:
                     _Py_SET_OPCODE(instructions[i], RESUME_QUICK);
                     break;
-                case LOAD_FAST:
-                    switch(previous_opcode) {
-                        case LOAD_FAST:
-                            _Py_SET_OPCODE(instructions[i - 1],
-                                           LOAD_FAST__LOAD_FAST);
-                            break;
-                        case STORE_FAST:
-                            _Py_SET_OPCODE(instructions[i - 1],
-                                           STORE_FAST__LOAD_FAST);
-                            break;
-                        case LOAD_CONST:
-                            _Py_SET_OPCODE(instructions[i - 1],
-                                           LOAD_CONST__LOAD_FAST);
-                            break;
-                    }
-                    break;
-                case STORE_FAST:
-                    if (previous_opcode == STORE_FAST) {
-                        _Py_SET_OPCODE(instructions[i - 1],
-                                       STORE_FAST__STORE_FAST);
-                    }
-                    break;
-                case LOAD_CONST:
-                    if (previous_opcode == LOAD_FAST) {
-                        _Py_SET_OPCODE(instructions[i - 1],
-                                       LOAD_FAST__LOAD_CONST);
+                default: {
+                    int super_opcode = _PyOpcode_super_instruction(
+                        previous_opcode, opcode);
+                    if (super_opcode) {
+                        _Py_SET_OPCODE(instructions[i - 1], super_opcode);
                     }
                     break;
+                }
             }
             previous_opcode = opcode;
         }
@@ -364,6 +347,7 @@ miss_counter_start(void) {
 #define SPEC_FAIL_WRONG_NUMBER_ARGUMENTS 6
 
 #define SPEC_FAIL_LOAD_GLOBAL_NON_STRING_OR_SPLIT 18
+#define SPEC_FAIL_LOAD_GLOBAL_NON_STANDARD_BUILTINS 19
 
 /* Attributes */
 
@@ -387,6 +371,10 @@ miss_counter_start(void) {
 #define SPEC_FAIL_ATTR_HAS_MANAGED_DICT 25
 #define SPEC_FAIL_ATTR_INSTANCE_ATTRIBUTE 26
 #define SPEC_FAIL_ATTR_METACLASS_ATTRIBUTE 27
+#define SPEC_FAIL_ATTR_METACLASS_OVERRIDDEN 28
+#define SPEC_FAIL_ATTR_HOOK_NOT_PYTHON_FUNCTION 29
+#define SPEC_FAIL_ATTR_HOOK_INSTANCE_DICT 30
+#define SPEC_FAIL_ATTR_GETATTR_AND_DESCRIPTOR 31
 
 /* Binary subscr and store subscr */
 
@@ -557,9 +545,20 @@ typedef enum {
     MUTABLE,   /* Instance of a mutable class; might, or might not, be a descriptor */
     ABSENT, /* Attribute is not present on the class */
     DUNDER_CLASS, /* __class__ attribute */
-    GETSET_OVERRIDDEN /* __getattribute__ or __setattr__ has been overridden */
+    GETSET_OVERRIDDEN, /* __getattribute__ or __setattr__ has been overridden */
+    GETATTRIBUTE_IS_PYTHON_FUNCTION  /* Python __getattribute__ and no __getattr__ */
 } DescriptorClassification;
 
+/* Is getattribute (the result of looking up __getattribute__ on a type)
+   object.__getattribute__? */
+static int
+is_generic_getattribute(PyObject *getattribute)
+{
+    return getattribute == NULL ||
+        (Py_IS_TYPE(getattribute, &PyWrapperDescr_Type) &&
+         ((PyWrapperDescrObject *)getattribute)->d_wrapped ==
+         (void *)PyObject_GenericGetAttr);
+}
 
 static DescriptorClassification
 analyze_descriptor(PyTypeObject *type, PyObject *name, PyObject **descr, int store)
@@ -570,11 +569,28 @@ analyze_descriptor(PyTypeObject *type, PyObject *name, PyObject **descr, int sto
             return GETSET_OVERRIDDEN;
         }
     }
-    else {
-        if (type->tp_getattro != PyObject_GenericGetAttr) {
+    else if (type->tp_getattro == _Py_slot_tp_getattro ||
+             type->tp_getattro == _Py_slot_tp_getattr_hook)
+    {
+        /* __getattribute__ or __getattr__ is defined in Python */
+        PyObject *getattribute = _PyType_Lookup(type, &_Py_ID(__getattribute__));
+        if (!is_generic_getattribute(getattribute)) {
+            if (Py_IS_TYPE(getattribute, &PyFunction_Type) &&
+                _PyType_Lookup(type, &_Py_ID(__getattr__)) == NULL)
+            {
+                *descr = getattribute;
+                return GETATTRIBUTE_IS_PYTHON_FUNCTION;
+            }
             *descr = NULL;
             return GETSET_OVERRIDDEN;
         }
+        /* Only __getattr__ is defined.  It is called when the usual lookup
+           fails, so the caller must make sure that the specialized
+           instruction cannot raise AttributeError. */
+    }
+    else if (type->tp_getattro != PyObject_GenericGetAttr) {
+        *descr = NULL;
+        return GETSET_OVERRIDDEN;
     }
     PyObject *descriptor = _PyType_Lookup(type, name);
     *descr = descriptor;
@@ -676,6 +692,85 @@ static int specialize_attr_loadmethod(PyObject* owner, _Py_CODEUNIT* instr, PyOb
 static int specialize_class_load_attr(PyObject* owner, _Py_CODEUNIT* instr, PyObject* name);
 static int function_kind(PyCodeObject *code);
 
+/* Cache the Python function func (__getattribute__, __getattr__ or the
+   __get__ method of a descriptor), to be called with nargs arguments by a
+   specialized LOAD_ATTR pushing a frame for it. */
+static int
+specialize_attr_hook(PyTypeObject *type, _Py_CODEUNIT *instr,
+                     PyObject *func, int nargs)
+{
+    _PyLoadMethodCache *cache = (_PyLoadMethodCache *)(instr + 1);
+    if (Py_TYPE(func) != &PyFunction_Type) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_HOOK_NOT_PYTHON_FUNCTION);
+        return 0;
+    }
+    PyCodeObject *fcode = (PyCodeObject *)((PyFunctionObject *)func)->func_code;
+    int kind = function_kind(fcode);
+    if (kind != SIMPLE_FUNCTION) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, kind);
+        return 0;
+    }
+    if (fcode->co_argcount != nargs) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
+        return 0;
+    }
+    int version = _PyFunction_GetVersionForCurrentState((PyFunctionObject *)func);
+    if (version == 0) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OUT_OF_VERSIONS);
+        return 0;
+    }
+    write_u32(cache->keys_version, version);
+    assert(type->tp_version_tag != 0);
+    write_u32(cache->type_version, type->tp_version_tag);
+    /* borrowed */
+    write_obj(cache->descr, func);
+    return 1;
+}
+
+/* Is name missing from the instance dictionary of owner, in a way that
+   LOAD_ATTR_GETATTR_HOOK and LOAD_ATTR_DESCRIPTOR can check cheaply?
+   Either the type has no instance dictionaries, or the values are stored
+   inline and the shared keys do not include name. */
+static int
+lacks_instance_attribute(PyObject *owner, PyTypeObject *type, PyObject *name)
+{
+    if (type->tp_flags & Py_TPFLAGS_MANAGED_DICT) {
+        PyDictOrValues dorv = *_PyObject_DictOrValuesPointer(owner);
+        if (!_PyDictOrValues_IsValues(dorv)) {
+            return 0;
+        }
+        PyDictKeysObject *keys = ((PyHeapTypeObject *)type)->ht_cached_keys;
+        return _PyDictKeys_StringLookup(keys, name) == DKIX_EMPTY;
+    }
+    return type->tp_dictoffset == 0;
+}
+
+/* The attribute is an instance of a Python class defining __get__. */
+static int
+specialize_python_descriptor(PyObject *owner, _Py_CODEUNIT *instr,
+                             PyObject *name, PyObject *descr)
+{
+    PyTypeObject *type = Py_TYPE(owner);
+    PyObject *get = _PyType_Lookup(Py_TYPE(descr), &_Py_ID(__get__));
+    if (get == NULL) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_MUTABLE_CLASS);
+        return 0;
+    }
+    if (!lacks_instance_attribute(owner, type, name)) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_HOOK_INSTANCE_DICT);
+        return 0;
+    }
+    if (!specialize_attr_hook(type, instr, get, 3)) {
+        return 0;
+    }
+    /* Cache the descriptor rather than its __get__ method, which is looked
+       up again (and its version checked) on each execution. */
+    _PyLoadMethodCache *cache = (_PyLoadMethodCache *)(instr + 1);
+    write_obj(cache->descr, descr);
+    _Py_SET_OPCODE(*instr, LOAD_ATTR_DESCRIPTOR);
+    return 1;
+}
+
 int
 _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
 {
@@ -705,6 +800,20 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
     PyObject *descr = NULL;
     DescriptorClassification kind = analyze_descriptor(type, name, &descr, 0);
     assert(descr != NULL || kind == ABSENT || kind == GETSET_OVERRIDDEN);
+    /* The __getattr__ hook, if any, of a class with the usual
+       __getattribute__ */
+    PyObject *getattr = NULL;
+    if (type->tp_getattro != PyObject_GenericGetAttr &&
+        kind != GETSET_OVERRIDDEN && kind != GETATTRIBUTE_IS_PYTHON_FUNCTION)
+    {
+        getattr = _PyType_Lookup(type, &_Py_ID(__getattr__));
+    }
+    if (getattr != NULL && (kind == PROPERTY || kind == MUTABLE)) {
+        /* The getter could raise AttributeError, and then __getattr__
+           would have to be called. */
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_GETATTR_AND_DESCRIPTOR);
+        goto fail;
+    }
     switch(kind) {
         case OVERRIDING:
             SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_OVERRIDING_DESCRIPTOR);
@@ -790,16 +899,34 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
             SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_NON_OBJECT_SLOT);
             goto fail;
         case MUTABLE:
-            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_MUTABLE_CLASS);
+            if (specialize_python_descriptor(owner, instr, name, descr)) {
+                goto success;
+            }
             goto fail;
         case GETSET_OVERRIDDEN:
             SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OVERRIDDEN);
             goto fail;
+        case GETATTRIBUTE_IS_PYTHON_FUNCTION:
+            if (!specialize_attr_hook(type, instr, descr, 2)) {
+                goto fail;
+            }
+            _Py_SET_OPCODE(*instr, LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN);
+            goto success;
+        case ABSENT:
+            if (getattr != NULL && lacks_instance_attribute(owner, type, name)) {
+                /* The usual lookup fails: call __getattr__ directly.
+                   Instance attributes are specialized below. */
+                if (!specialize_attr_hook(type, instr, getattr, 2)) {
+                    goto fail;
+                }
+                _Py_SET_OPCODE(*instr, LOAD_ATTR_GETATTR_HOOK);
+                goto success;
+            }
+            break;
         case BUILTIN_CLASSMETHOD:
         case PYTHON_CLASSMETHOD:
         case NON_OVERRIDING:
         case NON_DESCRIPTOR:
-        case ABSENT:
             break;
     }
     int err = specialize_dict_access(
@@ -874,6 +1001,7 @@ _Py_Specialize_StoreAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
             SPECIALIZATION_FAIL(STORE_ATTR, SPEC_FAIL_ATTR_MUTABLE_CLASS);
             goto fail;
         case GETSET_OVERRIDDEN:
+        case GETATTRIBUTE_IS_PYTHON_FUNCTION:
             SPECIALIZATION_FAIL(STORE_ATTR, SPEC_FAIL_OVERRIDDEN);
             goto fail;
         case BUILTIN_CLASSMETHOD:
@@ -927,6 +1055,7 @@ load_attr_fail_kind(DescriptorClassification kind)
         case MUTABLE:
             return SPEC_FAIL_ATTR_MUTABLE_CLASS;
         case GETSET_OVERRIDDEN:
+        case GETATTRIBUTE_IS_PYTHON_FUNCTION:
             return SPEC_FAIL_OVERRIDDEN;
         case BUILTIN_CLASSMETHOD:
             return SPEC_FAIL_ATTR_BUILTIN_CLASS_METHOD;
@@ -948,7 +1077,15 @@ specialize_class_load_attr(PyObject *owner, _Py_CODEUNIT *instr,
                              PyObject *name)
 {
     _PyLoadMethodCache *cache = (_PyLoadMethodCache *)(instr + 1);
-    if (!PyType_CheckExact(owner) || _PyType_Lookup(Py_TYPE(owner), name)) {
+    PyTypeObject *metaclass = Py_TYPE(owner);
+    if (metaclass->tp_getattro != PyType_Type.tp_getattro) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_METACLASS_OVERRIDDEN);
+        return -1;
+    }
+    /* This also assigns a version to the metaclass, which LOAD_ATTR_CLASS
+       checks, so that defining the attribute on the metaclass or overriding
+       its __getattribute__ deoptimizes the instruction. */
+    if (_PyType_Lookup(metaclass, name) || metaclass->tp_version_tag == 0) {
         SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_METACLASS_ATTRIBUTE);
         return -1;
     }
@@ -959,6 +1096,7 @@ specialize_class_load_attr(PyObject *owner, _Py_CODEUNIT *instr,
         case METHOD:
         case NON_DESCRIPTOR:
             write_u32(cache->type_version, ((PyTypeObject *)owner)->tp_version_tag);
+            write_u32(cache->keys_version, metaclass->tp_version_tag);
             write_obj(cache->descr, descr);
             _Py_SET_OPCODE(*instr, LOAD_ATTR_CLASS);
             return 0;
@@ -1021,6 +1159,12 @@ PyObject *descr, DescriptorClassification kind)
                 dictkind = LAZY_DICT;
                 keys = NULL;
             }
+            else if (_PyDict_IsWatchedBySpecializer((PyDictObject *)dict)) {
+                /* The keys version of the dict does not change when the
+                   name is added to it */
+                SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_SHADOWED);
+                goto fail;
+            }
             else {
                 keys = ((PyDictObject *)dict)->ma_keys;
                 dictkind = OFFSET_DICT;
@@ -1081,6 +1225,37 @@ PyObject *descr, DescriptorClassification kind)
     return 0;
 }
 
+/* The globals and builtins of specialized LOAD_GLOBAL instructions are
+   watched by this watcher.  Their keys version is kept when keys are added
+   or deleted (see reset_keys_version() in Objects/dictobject.c): the index
+   of the other keys does not change, and a deleted key leaves a NULL value,
+   so LOAD_GLOBAL_MODULE and LOAD_GLOBAL_BUILTIN only deoptimize when the key
+   they load is deleted or the dict is resized.  LOAD_GLOBAL_BUILTIN also
+   assumes that its name is not a global, so adding a global shadowing a
+   builtin resets the keys version of the globals. */
+static int
+globals_watcher(PyDict_WatchEvent event, PyObject *dict,
+                PyObject *key, PyObject *new_value)
+{
+    if (event != PyDict_EVENT_ADDED) {
+        return 0;
+    }
+    PyDictObject *builtins = (PyDictObject *)_PyInterpreterState_GET()->builtins;
+    if (!PyUnicode_CheckExact(key) ||
+        _PyDictKeys_StringLookup(builtins->ma_keys, key) != DKIX_EMPTY)
+    {
+        _PyDict_ResetKeysVersion((PyDictObject *)dict);
+    }
+    return 0;
+}
+
+static void
+watch_globals(PyInterpreterState *interp, PyObject *dict)
+{
+    interp->dict_state.watchers[DICT_SPECIALIZER_WATCHER] = globals_watcher;
+    _PyDict_WatchForSpecializer((PyDictObject *)dict);
+}
+
 int
 _Py_Specialize_LoadGlobal(
     PyObject *globals, PyObject *builtins,
@@ -1103,10 +1278,12 @@ _Py_Specialize_LoadGlobal(
         SPECIALIZATION_FAIL(LOAD_GLOBAL, SPEC_FAIL_LOAD_GLOBAL_NON_STRING_OR_SPLIT);
         goto fail;
     }
+    PyInterpreterState *interp = _PyInterpreterState_GET();
     if (index != DKIX_EMPTY) {
         if (index != (uint16_t)index) {
             goto fail;
         }
+        watch_globals(interp, globals);
         uint32_t keys_version = _PyDictKeys_GetVersionForCurrentState(globals_keys);
         if (keys_version == 0) {
             goto fail;
@@ -1132,6 +1309,16 @@ _Py_Specialize_LoadGlobal(
     if (index != (uint16_t)index) {
         goto fail;
     }
+    if (builtins == interp->builtins) {
+        watch_globals(interp, globals);
+        watch_globals(interp, builtins);
+    }
+    else if (_PyDict_IsWatchedBySpecializer((PyDictObject *)globals)) {
+        /* The watcher only resets the keys version of the globals when
+           adding a key shadowing one of the standard builtins */
+        SPECIALIZATION_FAIL(LOAD_GLOBAL, SPEC_FAIL_LOAD_GLOBAL_NON_STANDARD_BUILTINS);
+        goto fail;
+    }
     uint32_t globals_version = _PyDictKeys_GetVersionForCurrentState(globals_keys);
     if (globals_version == 0) {
         SPECIALIZATION_FAIL(LOAD_GLOBAL, SPEC_FAIL_OUT_OF_VERSIONS);
@@ -1167,16 +1354,7 @@ _Py_Specialize_LoadGlobal(
 static int
 binary_subscr_fail_kind(PyTypeObject *container_type, PyObject *sub)
 {
-    if (container_type == &PyUnicode_Type) {
-        if (PyLong_CheckExact(sub)) {
-            return SPEC_FAIL_SUBSCR_STRING_INT;
-        }
-        if (PySlice_Check(sub)) {
-            return SPEC_FAIL_SUBSCR_STRING_SLICE;
-        }
-        return SPEC_FAIL_OTHER;
-    }
-    else if (strcmp(container_type->tp_name, "array.array") == 0) {
+    if (strcmp(container_type->tp_name, "array.array") == 0) {
         if (PyLong_CheckExact(sub)) {
             return SPEC_FAIL_SUBSCR_ARRAY_INT;
         }
@@ -1241,6 +1419,33 @@ _Py_Specialize_BinarySubscr(
             PySlice_Check(sub) ? SPEC_FAIL_SUBSCR_TUPLE_SLICE : SPEC_FAIL_OTHER);
         goto fail;
     }
+    if (container_type == &PyUnicode_Type) {
+        if (PyLong_CheckExact(sub)) {
+            _Py_SET_OPCODE(*instr, BINARY_SUBSCR_STR_INT);
+            goto success;
+        }
+        SPECIALIZATION_FAIL(BINARY_SUBSCR,
+            PySlice_Check(sub) ? SPEC_FAIL_SUBSCR_STRING_SLICE : SPEC_FAIL_OTHER);
+        goto fail;
+    }
+    if (container_type == &PyBytes_Type) {
+        if (PyLong_CheckExact(sub)) {
+            _Py_SET_OPCODE(*instr, BINARY_SUBSCR_BYTES_INT);
+            goto success;
+        }
+        SPECIALIZATION_FAIL(BINARY_SUBSCR,
+            PySlice_Check(sub) ? SPEC_FAIL_SUBSCR_BUFFER_SLICE : SPEC_FAIL_OTHER);
+        goto fail;
+    }
+    if (container_type == &PyByteArray_Type) {
+        if (PyLong_CheckExact(sub)) {
+            _Py_SET_OPCODE(*instr, BINARY_SUBSCR_BYTEARRAY_INT);
+            goto success;
+        }
+        SPECIALIZATION_FAIL(BINARY_SUBSCR,
+            PySlice_Check(sub) ? SPEC_FAIL_SUBSCR_BYTEARRAY_SLICE : SPEC_FAIL_OTHER);
+        goto fail;
+    }
     if (container_type == &PyDict_Type) {
         _Py_SET_OPCODE(*instr, BINARY_SUBSCR_DICT);
         goto success;
@@ -1321,6 +1526,21 @@ _Py_Specialize_StoreSubscr(PyObject *container, PyObject *sub, _Py_CODEUNIT *ins
         _Py_SET_OPCODE(*instr, STORE_SUBSCR_DICT);
          goto success;
     }
+    if (container_type == &PyByteArray_Type) {
+        if (PyLong_CheckExact(sub)) {
+            if ((Py_SIZE(sub) == 0 || Py_SIZE(sub) == 1)
+                && ((PyLongObject *)sub)->ob_digit[0] < (size_t)PyByteArray_GET_SIZE(container))
+            {
+                _Py_SET_OPCODE(*instr, STORE_SUBSCR_BYTEARRAY_INT);
+                goto success;
+            }
+            SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_OUT_OF_RANGE);
+            goto fail;
+        }
+        SPECIALIZATION_FAIL(STORE_SUBSCR,
+            PySlice_Check(sub) ? SPEC_FAIL_SUBSCR_BYTEARRAY_SLICE : SPEC_FAIL_OTHER);
+        goto fail;
+    }
 #ifdef Py_STATS
     PyMappingMethods *as_mapping = container_type->tp_as_mapping;
     if (as_mapping && (as_mapping->mp_ass_subscript
@@ -1343,17 +1563,6 @@ _Py_Specialize_StoreSubscr(PyObject *container, PyObject *sub, _Py_CODEUNIT *ins
                 SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_OTHER);
             }
         }
-        else if (PyByteArray_CheckExact(container)) {
-            if (PyLong_CheckExact(sub)) {
-                SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_SUBSCR_BYTEARRAY_INT);
-            }
-            else if (PySlice_Check(sub)) {
-                SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_SUBSCR_BYTEARRAY_SLICE);
-            }
-            else {
-                SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_OTHER);
-            }
-        }
         else {
             if (PyLong_CheckExact(sub)) {
                 SPECIALIZATION_FAIL(STORE_SUBSCR, SPEC_FAIL_SUBSCR_BUFFER_INT);
@@ -1394,6 +1603,66 @@ _Py_Specialize_StoreSubscr(PyObject *container, PyObject *sub, _Py_CODEUNIT *ins
     return 0;
 }
 
+/* BINARY_SLICE_*_INT only handle slice bounds which are None or ints
+   of at most one digit. */
+static int
+is_compact_slice_bound(PyObject *bound)
+{
+    return bound == Py_None ||
+        (PyLong_CheckExact(bound) && (size_t)(Py_SIZE(bound) + 1) <= 2);
+}
+
+void
+_Py_Specialize_BinarySlice(PyObject *container, PyObject *start,
+                           PyObject *stop, _Py_CODEUNIT *instr)
+{
+    assert(_PyOpcode_Caches[BINARY_SLICE] ==
+           INLINE_CACHE_ENTRIES_BINARY_SLICE);
+    _PyBinarySliceCache *cache = (_PyBinarySliceCache *)(instr + 1);
+    PyTypeObject *container_type = Py_TYPE(container);
+    if (!is_compact_slice_bound(start) || !is_compact_slice_bound(stop)) {
+        SPECIALIZATION_FAIL(BINARY_SLICE, SPEC_FAIL_OUT_OF_RANGE);
+        goto fail;
+    }
+    if (container_type == &PyList_Type) {
+        _Py_SET_OPCODE(*instr, BINARY_SLICE_LIST_INT);
+        goto success;
+    }
+    if (container_type == &PyBytes_Type) {
+        _Py_SET_OPCODE(*instr, BINARY_SLICE_BYTES_INT);
+        goto success;
+    }
+#ifdef Py_STATS
+    if (container_type == &PyTuple_Type) {
+        SPECIALIZATION_FAIL(BINARY_SLICE, SPEC_FAIL_SUBSCR_TUPLE_SLICE);
+    }
+    else if (container_type == &PyUnicode_Type) {
+        SPECIALIZATION_FAIL(BINARY_SLICE, SPEC_FAIL_SUBSCR_STRING_SLICE);
+    }
+    else if (container_type == &PyByteArray_Type) {
+        SPECIALIZATION_FAIL(BINARY_SLICE, SPEC_FAIL_SUBSCR_BYTEARRAY_SLICE);
+    }
+    else if (strcmp(container_type->tp_name, "array.array") == 0) {
+        SPECIALIZATION_FAIL(BINARY_SLICE, SPEC_FAIL_SUBSCR_ARRAY_SLICE);
+    }
+    else if (container_type->tp_as_buffer) {
+        SPECIALIZATION_FAIL(BINARY_SLICE, SPEC_FAIL_SUBSCR_BUFFER_SLICE);
+    }
+    else {
+        SPECIALIZATION_FAIL(BINARY_SLICE, SPEC_FAIL_OTHER);
+    }
+#endif
+fail:
+    STAT_INC(BINARY_SLICE, failure);
+    assert(!PyErr_Occurred());
+    cache->counter = adaptive_counter_backoff(cache->counter);
+    return;
+success:
+    STAT_INC(BINARY_SLICE, success);
+    assert(!PyErr_Occurred());
+    cache->counter = miss_counter_start();
+}
+
 static int
 specialize_class_call(PyObject *callable, _Py_CODEUNIT *instr, int nargs,
                       PyObject *kwnames)
@@ -1507,6 +1776,65 @@ specialize_method_descriptor(PyMethodDescrObject *descr, _Py_CODEUNIT *instr,
     return -1;
 }
 
+/* CALL_PY_WITH_KEYWORDS matches the keyword arguments with the parameters
+   by walking both in order, comparing the names by identity.  So the
+   keywords must be passed in the order of the parameters, and all the
+   parameters which are not passed must have a default value. */
+static int
+specialize_py_call_kw(PyFunctionObject *func, _Py_CODEUNIT *instr, int nargs,
+                      PyObject *kwnames)
+{
+    _PyCallCache *cache = (_PyCallCache *)(instr + 1);
+    PyCodeObject *code = (PyCodeObject *)func->func_code;
+    int flags = code->co_flags;
+    if (flags & (CO_VARKEYWORDS | CO_VARARGS)) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_COMPLEX_PARAMETERS);
+        return -1;
+    }
+    if ((flags & CO_OPTIMIZED) == 0) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_CO_NOT_OPTIMIZED);
+        return -1;
+    }
+    int kwcount = (int)PyTuple_GET_SIZE(kwnames);
+    int positional = nargs - kwcount;
+    int argcount = code->co_argcount;
+    int total_args = argcount + code->co_kwonlyargcount;
+    int defcount = func->func_defaults == NULL ? 0 : (int)PyTuple_GET_SIZE(func->func_defaults);
+    if (positional > argcount) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
+        return -1;
+    }
+    PyObject **names = &PyTuple_GET_ITEM(code->co_localsplusnames, 0);
+    int k = 0;
+    for (int i = positional; i < total_args; i++) {
+        if (k < kwcount && i >= code->co_posonlyargcount &&
+            names[i] == PyTuple_GET_ITEM(kwnames, k))
+        {
+            k++;
+        }
+        else if (i < argcount ? i < argcount - defcount :
+                 (func->func_kwdefaults == NULL ||
+                  PyDict_GetItem(func->func_kwdefaults, names[i]) == NULL))
+        {
+            SPECIALIZATION_FAIL(CALL, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
+            return -1;
+        }
+    }
+    if (k < kwcount) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_KWNAMES);
+        return -1;
+    }
+    int version = _PyFunction_GetVersionForCurrentState(func);
+    if (version == 0) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    write_u32(cache->func_version, version);
+    cache->min_args = positional;
+    _Py_SET_OPCODE(*instr, CALL_PY_WITH_KEYWORDS);
+    return 0;
+}
+
 static int
 specialize_py_call(PyFunctionObject *func, _Py_CODEUNIT *instr, int nargs,
                    PyObject *kwnames, bool bound_method)
@@ -1521,8 +1849,11 @@ specialize_py_call(PyFunctionObject *func, _Py_CODEUNIT *instr, int nargs,
         return -1;
     }
     if (kwnames) {
-        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_KWNAMES);
-        return -1;
+        if (bound_method) {
+            SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_KWNAMES);
+            return -1;
+        }
+        return specialize_py_call_kw(func, instr, nargs, kwnames);
     }
     if (kind != SIMPLE_FUNCTION) {
         SPECIALIZATION_FAIL(CALL, kind);
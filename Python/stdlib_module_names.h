@@ -21,6 +21,7 @@ static const char* _Py_stdlib_module_names[] = {
 "_collections_abc",
 "_compat_pickle",
 "_compression",
+"_concurrent_futures",
 "_contextvars",
 "_crypt",
 "_csv",
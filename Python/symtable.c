@@ -103,6 +103,7 @@ ste_new(struct symtable *st, identifier name, _Py_block_ty block,
     ste->ste_generator = 0;
     ste->ste_coroutine = 0;
     ste->ste_comprehension = NoComprehension;
+    ste->ste_comp_inlined = 0;
     ste->ste_returns_value = 0;
     ste->ste_needs_class_closure = 0;
     ste->ste_comp_iter_target = 0;
@@ -564,6 +565,132 @@ analyze_name(PySTEntryObject *ste, PyObject *scopes, PyObject *name, long flags,
     return 1;
 }
 
+/* List, set and dict comprehensions are inlined into their enclosing
+   function: the compiler runs the loop in the function's frame and saves
+   and restores the names bound by the comprehension around it.  This is
+   only done when the names the comprehension uses keep the same meaning
+   in the enclosing function.  Generator expressions, asynchronous
+   comprehensions and comprehensions containing a nested scope that is not
+   itself inlined keep their own function, as do all comprehensions at
+   module or class level.
+
+   Return 1 if comp can be inlined into ste, 0 if not, -1 on error.
+*/
+
+static int
+can_inline_comprehension(PySTEntryObject *ste, PySTEntryObject *comp,
+                         PyObject *scopes, PyObject *local)
+{
+    PyObject *name, *v;
+    Py_ssize_t pos = 0;
+
+    if (ste->ste_type != FunctionBlock ||
+        comp->ste_comprehension == NoComprehension ||
+        comp->ste_comprehension == GeneratorExpression ||
+        comp->ste_coroutine)
+    {
+        return 0;
+    }
+    for (Py_ssize_t i = 0; i < PyList_GET_SIZE(comp->ste_children); i++) {
+        PySTEntryObject *child =
+            (PySTEntryObject *)PyList_GET_ITEM(comp->ste_children, i);
+        if (!child->ste_comp_inlined) {
+            return 0;
+        }
+    }
+    while (PyDict_Next(comp->ste_symbols, &pos, &name, &v)) {
+        long flags = PyLong_AS_LONG(v);
+        if (flags & DEF_PARAM) {
+            /* the implicit ".0" argument */
+            continue;
+        }
+        PyObject *outer = PyDict_GetItemWithError(scopes, name);
+        if (outer == NULL) {
+            if (PyErr_Occurred()) {
+                return -1;
+            }
+            continue;
+        }
+        long scope = (flags >> SCOPE_OFFSET) & SCOPE_MASK;
+        long outer_scope = PyLong_AS_LONG(outer);
+        if (scope == LOCAL) {
+            /* A local of the comprehension can shadow a local or a global
+               of the function, but not one of its free variables. */
+            if (outer_scope == FREE) {
+                return 0;
+            }
+        }
+        else if (scope == FREE) {
+            int bound = PySet_Contains(local, name);
+            if (bound < 0) {
+                return -1;
+            }
+            if (!bound && outer_scope != FREE) {
+                return 0;
+            }
+        }
+        else if (outer_scope != GLOBAL_IMPLICIT &&
+                 outer_scope != GLOBAL_EXPLICIT)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Merge the symbols of the inlined comprehension comp into ste.
+
+   Names unknown to ste are added with their scope in the comprehension.
+   Free variables of the comprehension bound in ste become plain locals
+   of ste, so they are removed from comp_free.
+*/
+
+static int
+inline_comprehension(PySTEntryObject *ste, PySTEntryObject *comp,
+                     PyObject *scopes, PyObject *local, PyObject *comp_free)
+{
+    PyObject *name, *v;
+    Py_ssize_t pos = 0;
+
+    while (PyDict_Next(comp->ste_symbols, &pos, &name, &v)) {
+        long flags = PyLong_AS_LONG(v);
+        if (flags & DEF_PARAM) {
+            continue;
+        }
+        long scope = (flags >> SCOPE_OFFSET) & SCOPE_MASK;
+        int known = PyDict_Contains(scopes, name);
+        if (known < 0) {
+            return 0;
+        }
+        if (known) {
+            if (scope == FREE) {
+                int bound = PySet_Contains(local, name);
+                if (bound < 0) {
+                    return 0;
+                }
+                if (bound && PySet_Discard(comp_free, name) < 0) {
+                    return 0;
+                }
+            }
+            continue;
+        }
+        PyObject *v_flags = PyLong_FromLong(flags & ((1 << SCOPE_OFFSET) - 1));
+        if (v_flags == NULL) {
+            return 0;
+        }
+        if (PyDict_SetItem(ste->ste_symbols, name, v_flags) < 0) {
+            Py_DECREF(v_flags);
+            return 0;
+        }
+        Py_DECREF(v_flags);
+        SET_SCOPE(scopes, name, scope);
+        if (scope == FREE) {
+            ste->ste_free = 1;
+        }
+    }
+    return 1;
+}
+
 #undef SET_SCOPE
 
 /* If a name is defined in free and also in locals, then this block
@@ -741,6 +868,7 @@ analyze_block(PySTEntryObject *ste, PyObject *bound, PyObject *free,
 {
     PyObject *name, *v, *local = NULL, *scopes = NULL, *newbound = NULL;
     PyObject *newglobal = NULL, *newfree = NULL, *allfree = NULL;
+    PyObject *child_free = NULL;
     PyObject *temp;
     int i, success = 0;
     Py_ssize_t pos = 0;
@@ -842,9 +970,25 @@ analyze_block(PySTEntryObject *ste, PyObject *bound, PyObject *free,
         PySTEntryObject* entry;
         assert(c && PySTEntry_Check(c));
         entry = (PySTEntryObject*)c;
+        child_free = PySet_New(NULL);
+        if (!child_free)
+            goto error;
         if (!analyze_child_block(entry, newbound, newfree, newglobal,
-                                 allfree))
+                                 child_free))
+            goto error;
+        int inline_comp = can_inline_comprehension(ste, entry, scopes, local);
+        if (inline_comp < 0)
             goto error;
+        if (inline_comp) {
+            if (!inline_comprehension(ste, entry, scopes, local, child_free))
+                goto error;
+            entry->ste_comp_inlined = 1;
+        }
+        temp = PyNumber_InPlaceOr(allfree, child_free);
+        if (!temp)
+            goto error;
+        Py_DECREF(temp);
+        Py_CLEAR(child_free);
         /* Check if any children have free variables */
         if (entry->ste_free || entry->ste_child_free)
             ste->ste_child_free = 1;
@@ -877,6 +1021,7 @@ analyze_block(PySTEntryObject *ste, PyObject *bound, PyObject *free,
     Py_XDECREF(newglobal);
     Py_XDECREF(newfree);
     Py_XDECREF(allfree);
+    Py_XDECREF(child_free);
     if (!success)
         assert(PyErr_Occurred());
     return success;
@@ -30,6 +30,7 @@ Data members:
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_structseq.h"     // _PyStructSequence_InitBuiltinWithFlags()
 #include "pycore_tuple.h"         // _PyTuple_FromArray()
+#include "pycore_typeobject.h"    // _PyType_GetCacheStats()
 
 #include "frameobject.h"          // PyFrame_FastToLocalsWithError()
 #include "pydtrace.h"
@@ -1131,6 +1132,91 @@ sys_getswitchinterval_impl(PyObject *module)
     return 1e-6 * _PyEval_GetSwitchInterval();
 }
 
+/*[clinic input]
+sys._setgilpriority
+
+    enabled: bool
+    /
+
+Enable or disable handing the GIL over first to threads leaving I/O.
+
+When enabled, a thread returning from a blocking call which released
+the GIL asks the running thread to drop it immediately, instead of
+waiting for the switch interval to elapse, and is given the GIL ahead
+of other waiting threads.
+
+This lowers the latency of I/O-bound threads competing with CPU-bound
+threads, at the cost of more frequent thread switches.
+[clinic start generated code]*/
+
+static PyObject *
+sys__setgilpriority_impl(PyObject *module, int enabled)
+/*[clinic end generated code: output=dc3a1a147748933f input=4a24c23b7aa8fe7c]*/
+{
+    _PyEval_SetGILPriority(enabled);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._getgilpriority -> bool
+
+Return True if I/O priority GIL handoff is enabled.
+
+See sys._setgilpriority().
+[clinic start generated code]*/
+
+static int
+sys__getgilpriority_impl(PyObject *module)
+/*[clinic end generated code: output=49f675852fd3c85f input=b91e3550ba68b0ac]*/
+{
+    return _PyEval_GetGILPriority();
+}
+
+/*[clinic input]
+sys._setgilstats
+
+    enabled: bool
+    /
+
+Enable or disable GIL statistics; see sys._getgilstats().
+
+Enabling them resets all the counters.
+[clinic start generated code]*/
+
+static PyObject *
+sys__setgilstats_impl(PyObject *module, int enabled)
+/*[clinic end generated code: output=0f0e60e3ae43dfa8 input=920ca3052a3c1d5e]*/
+{
+    _PyEval_SetGILStats(enabled);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._getgilstats
+
+Return a dict of statistics about the GIL.
+
+The statistics are only gathered while enabled with sys._setgilstats().
+The dict has the number of GIL acquisitions ("acquisitions"), of those
+which had to wait for another thread ("contended"), of changes of the
+thread holding the GIL ("switches") and of drops where the dropping
+thread waited for another thread to take over ("forced_switches").
+"drops" maps the reasons the GIL was dropped ("release" around blocking
+calls, "interval" and "priority" when asked for by a waiting thread) to
+their count.  "wait_time" and "hold_time" are the total times in seconds
+spent waiting for and holding the GIL, and "wait_histogram" and
+"hold_histogram" count these durations by power-of-two buckets of
+microseconds.  "threads" maps thread identifiers to a tuple of the
+number of acquisitions and the wait time of each thread.
+[clinic start generated code]*/
+
+static PyObject *
+sys__getgilstats_impl(PyObject *module)
+/*[clinic end generated code: output=6cfe4e3b51e0e160 input=f7701163bea58968]*/
+{
+    return _PyEval_GetGILStats();
+}
+
 /*[clinic input]
 sys.setrecursionlimit
 
@@ -1906,6 +1992,27 @@ sys__clear_type_cache_impl(PyObject *module)
     Py_RETURN_NONE;
 }
 
+/*[clinic input]
+sys._get_type_cache_stats
+
+Return a dict of statistics about the internal type lookup cache.
+
+The dict has the current number of entries ("size"), the number of
+live types with a valid version tag ("versioned_types"), the number
+of lookups answered from the cache ("hits"), the number of lookups
+which fell back to a walk of the MRO, either on an empty entry
+("misses") or evicting another type or name ("collisions"), and the
+number of times the cache was grown or shrunk ("resizes").
+[clinic start generated code]*/
+
+static PyObject *
+sys__get_type_cache_stats_impl(PyObject *module)
+/*[clinic end generated code: output=e690a83963323d63 input=1271d1f1ff96b966]*/
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    return _PyType_GetCacheStats(interp);
+}
+
 /*[clinic input]
 sys.is_finalizing
 
@@ -2001,6 +2108,7 @@ static PyMethodDef sys_methods[] = {
     {"breakpointhook", _PyCFunction_CAST(sys_breakpointhook),
      METH_FASTCALL | METH_KEYWORDS, breakpointhook_doc},
     SYS__CLEAR_TYPE_CACHE_METHODDEF
+    SYS__GET_TYPE_CACHE_STATS_METHODDEF
     SYS__CURRENT_FRAMES_METHODDEF
     SYS__CURRENT_EXCEPTIONS_METHODDEF
     SYS_DISPLAYHOOK_METHODDEF
@@ -2033,6 +2141,10 @@ static PyMethodDef sys_methods[] = {
     SYS_MDEBUG_METHODDEF
     SYS_SETSWITCHINTERVAL_METHODDEF
     SYS_GETSWITCHINTERVAL_METHODDEF
+    SYS__SETGILPRIORITY_METHODDEF
+    SYS__GETGILPRIORITY_METHODDEF
+    SYS__SETGILSTATS_METHODDEF
+    SYS__GETGILSTATS_METHODDEF
     SYS_SETDLOPENFLAGS_METHODDEF
     {"setprofile", sys_setprofile, METH_O, setprofile_doc},
     SYS_GETPROFILE_METHODDEF
@@ -65,6 +65,9 @@ def clean_lines(text):
 Python/dynload_win.c            # windows.h
 Python/thread_nt.h
 
+# not actually compiled: instruction definitions for Tools/cases_generator
+Python/bytecodes.c
+
 # other OS-dependent
 Python/dynload_aix.c            # sys/ldr.h
 Python/dynload_dl.c             # dl.h
@@ -86,6 +89,7 @@ def clean_lines(text):
 # generated
 Python/deepfreeze/*.c
 Python/frozen_modules/*.h
+Python/generated_cases.c.h
 Python/opcode_targets.h
 Python/stdlib_module_names.h
 
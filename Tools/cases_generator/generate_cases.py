@@ -0,0 +1,649 @@
+"""Generate the interpreter cases and instruction metadata.
+
+Reads the instruction definitions in Python/bytecodes.c and writes:
+
+- Python/generated_cases.c.h, the body of the main interpreter switch in
+  Python/ceval.c, with a TARGET() case for every instruction and
+  superinstruction;
+- Python/opcode_metadata.h, the stack effects declared in the definitions
+  (used by the compiler) and the table of superinstructions (used when
+  quickening code).
+
+With --pair-counts, it first picks the most common instruction pairs that
+can be combined into superinstructions, using the pair counts written by
+Tools/scripts/summarize_stats.py, and updates the superinstruction section
+of Python/bytecodes.c accordingly.
+
+See Tools/cases_generator/README.md for more information.
+"""
+
+import argparse
+import collections
+import os
+import sys
+import tokenize
+
+import lexer
+import parser
+
+ROOT = os.path.join(os.path.dirname(__file__), "..", "..")
+DEFAULT_INPUT = os.path.join(ROOT, "Python", "bytecodes.c")
+DEFAULT_OUTPUT = os.path.join(ROOT, "Python", "generated_cases.c.h")
+DEFAULT_METADATA = os.path.join(ROOT, "Python", "opcode_metadata.h")
+DEFAULT_OPCODE_PY = os.path.join(ROOT, "Lib", "opcode.py")
+
+HEADER = """\
+// This file is generated by Tools/cases_generator/generate_cases.py
+// from Python/bytecodes.c
+// Do not edit!
+"""
+
+# Macros which move the stack pointer or dispatch, and so cannot be used
+# by instructions which declare their stack effect.
+STACK_MACROS = frozenset({
+    "BASIC_POP", "BASIC_PUSH", "BASIC_STACKADJ", "DISPATCH",
+    "NOTRACE_DISPATCH", "NOTRACE_DISPATCH_SAME_OPARG", "POP", "PUSH",
+    "STACK_GROW", "STACK_SHRINK",
+})
+# Things that transfer control elsewhere, which parts of a superinstruction
+# other than the first one cannot do.
+CONTROL_FLOW = frozenset({
+    "DEOPT_IF", "ERROR_IF", "JUMPBY", "JUMPTO", "JUMP_TO_INSTRUCTION",
+    "PREDICT", "goto", "next_instr", "return",
+})
+# The error labels in ceval.c popping that many items off the stack
+MAX_ERROR_POPS = 4
+
+INDENT = " " * 4
+
+
+class GeneratorError(Exception):
+    pass
+
+
+class StackSize:
+    """A symbolic number of stack items: a constant plus C expressions."""
+
+    def __init__(self, const=0, exprs=()):
+        self.const = const
+        self.exprs = list(exprs)
+
+    def add(self, item):
+        if item.size:
+            self.exprs.append(item.size)
+        else:
+            self.const += 1
+
+    def copy(self):
+        return StackSize(self.const, self.exprs)
+
+    def __eq__(self, other):
+        if not isinstance(other, StackSize):
+            return NotImplemented
+        return (self.const == other.const and
+                sorted(self.exprs) == sorted(other.exprs))
+
+    def is_zero(self):
+        return self.const == 0 and not self.exprs
+
+    def to_c(self):
+        terms = [f"({expr})" if not expr.isidentifier() else expr
+                 for expr in self.exprs]
+        if self.const or not terms:
+            terms.insert(0, str(self.const))
+        return " + ".join(terms)
+
+
+def stack_size(items):
+    size = StackSize()
+    for item in items:
+        size.add(item)
+    return size
+
+
+def adjust_stack(popped, pushed):
+    """Return the statements moving the stack pointer by pushed - popped."""
+    # Cancel out the common parts
+    exprs = list(popped.exprs)
+    pushed_exprs = []
+    for expr in pushed.exprs:
+        if expr in exprs:
+            exprs.remove(expr)
+        else:
+            pushed_exprs.append(expr)
+    shrink = StackSize(0, exprs)
+    grow = StackSize(0, pushed_exprs)
+    diff = pushed.const - popped.const
+    if diff > 0:
+        grow.const = diff
+    else:
+        shrink.const = -diff
+    lines = []
+    if not shrink.is_zero():
+        lines.append(f"STACK_SHRINK({shrink.to_c()});")
+    if not grow.is_zero():
+        lines.append(f"STACK_GROW({grow.to_c()});")
+    return lines
+
+
+class Instruction:
+    """An instruction with its definition analyzed."""
+
+    def __init__(self, inst, filename):
+        self.name = inst.name
+        self.inst = inst
+        self.filename = filename
+        self.predicted = None
+        self.predict = None
+        if inst.has_stack_effect:
+            self.lines = self.body_lines()
+            self.check_body()
+
+    @property
+    def has_stack_effect(self):
+        return self.inst.has_stack_effect
+
+    def error(self, msg):
+        return GeneratorError(
+            f"{self.filename}:{self.inst.block.line}: {self.name}: {msg}")
+
+    def body_lines(self):
+        """The lines of the body, without the braces, dedented to the level
+        of the instruction's own indentation."""
+        text = self.inst.block.text
+        assert text[0] == "{" and text[-1] == "}"
+        lines = text[1:-1].split("\n")
+        # The first line is the rest of the line with the opening brace
+        if lines[0].strip():
+            raise self.error("code must start on the line after '{'")
+        lines = lines[1:-1]
+        prefix = self.inst.block.indent + INDENT
+        body = []
+        for line in lines:
+            line = line.rstrip()
+            if line.startswith(prefix):
+                line = line[len(prefix):]
+            elif line.strip() and not line.startswith("#"):
+                raise self.error(f"badly indented line: {line.strip()!r}")
+            body.append(line)
+        return body
+
+    def body_tokens(self):
+        return lexer.tokenize("\n".join(self.lines))
+
+    def uses(self, names):
+        return {token.text for token in self.body_tokens()
+                if token.text in names}
+
+    def check_body(self):
+        bad = self.uses(STACK_MACROS)
+        if bad:
+            raise self.error(
+                f"uses {', '.join(sorted(bad))} although it declares its "
+                f"stack effect")
+        for item in self.inst.outputs:
+            if item.size and not item.is_unused:
+                raise self.error(f"array output {item.name!r} must be unused")
+        if self.lines and self.lines[0].startswith("PREDICTED("):
+            # Jumps to the PREDICTED() label must skip loading the inputs
+            self.predicted = self.lines.pop(0)
+        if self.lines and self.lines[-1].startswith("PREDICT("):
+            # PREDICT() may jump to the next instruction, so it must come
+            # after the outputs are stored
+            self.predict = self.lines.pop()
+        bad = self.uses({"PREDICTED", "PREDICT"})
+        if bad:
+            raise self.error(
+                f"{', '.join(sorted(bad))} must be on the first (PREDICTED) "
+                f"or last (PREDICT) line")
+
+    @property
+    def popped(self):
+        return stack_size(self.inst.inputs)
+
+    @property
+    def pushed(self):
+        return stack_size(self.inst.outputs)
+
+    def cache_entries(self, opcode):
+        base = opcode.deopt.get(self.name, self.name)
+        return opcode.cache_entries.get(base, 0)
+
+    def write_stack_effect_body(self, out, in_super=False):
+        """Write the body of an instruction declaring its stack effect,
+        with the code loading its inputs and storing its outputs."""
+        inst = self.inst
+        if self.predicted and not in_super:
+            out.emit(self.predicted)
+
+        # Load the inputs, from the top of the stack down
+        input_slots = {}
+        depth = StackSize()
+        for item in reversed(inst.inputs):
+            depth.add(item)
+            if item.is_unused:
+                continue
+            if item.size:
+                out.emit(f"PyObject **{item.name} = &PEEK({depth.to_c()});")
+            else:
+                out.emit(f"PyObject *{item.name} = PEEK({depth.to_c()});")
+        # Remember where each input is, counting from the bottom
+        below = StackSize()
+        for item in inst.inputs:
+            input_slots[item.name] = below.copy()
+            below.add(item)
+
+        input_names = {item.name for item in inst.inputs}
+        for item in inst.outputs:
+            if not item.is_unused and item.name not in input_names:
+                out.emit(f"PyObject *{item.name};")
+
+        for line in self.substitute_error_if(self.lines):
+            out.emit(line)
+
+        for line in adjust_stack(self.popped, self.pushed):
+            out.emit(line)
+
+        # Store the outputs, unless they are already in place
+        below = StackSize()
+        output_slots = {}
+        for item in inst.outputs:
+            output_slots[item.name] = below.copy()
+            below.add(item)
+        depth = StackSize()
+        for item in reversed(inst.outputs):
+            depth.add(item)
+            if item.is_unused:
+                continue
+            if input_slots.get(item.name) == output_slots[item.name]:
+                continue
+            out.emit(f"POKE({depth.to_c()}, {item.name});")
+        if self.predict and not in_super:
+            out.emit(self.predict)
+
+    def substitute_error_if(self, lines):
+        """Replace ERROR_IF(cond, label); with a jump to the label which
+        pops the inputs off the stack."""
+        if not lines:
+            return lines
+        text = "\n".join(lines)
+        tokens = list(lexer.tokenize(text))
+        result = []
+        pos = 0
+        i = 0
+        while i < len(tokens):
+            token = tokens[i]
+            if token.text != "ERROR_IF":
+                i += 1
+                continue
+            # ERROR_IF ( cond , label ) ;
+            if tokens[i + 1].text != "(":
+                raise self.error("ERROR_IF must be followed by '('")
+            depth = 0
+            j = i + 1
+            comma = None
+            while True:
+                if tokens[j].text in "([{":
+                    depth += 1
+                elif tokens[j].text in ")]}":
+                    depth -= 1
+                    if depth == 0:
+                        break
+                elif tokens[j].text == "," and depth == 1:
+                    comma = j
+                j += 1
+            if comma is None or comma + 2 != j:
+                raise self.error("ERROR_IF needs a condition and a label")
+            if j + 1 >= len(tokens) or tokens[j + 1].text != ";":
+                raise self.error("ERROR_IF must be followed by ';'")
+            cond = text[tokens[i + 2].begin:tokens[comma].begin].strip()
+            label = tokens[comma + 1].text
+            result.append(text[pos:token.begin])
+            result.append(f"if ({cond}) {self.error_jump(label)}")
+            pos = tokens[j + 1].end
+            i = j + 2
+        result.append(text[pos:])
+        return "".join(result).split("\n")
+
+    def error_jump(self, label):
+        # The inputs passed through unchanged at the bottom of the stack
+        # are still owned by the stack, the others have been consumed by
+        # the instruction and must be popped without being decref'ed.
+        inputs = self.inst.inputs
+        kept = 0
+        for input, output in zip(inputs, self.inst.outputs):
+            if input != output:
+                break
+            kept += 1
+        popped = stack_size(inputs[kept:])
+        if popped.const > MAX_ERROR_POPS:
+            raise self.error(f"cannot pop {popped.const} items on error")
+        if popped.const:
+            label = f"pop_{popped.const}_{label}"
+        if popped.exprs:
+            shrink = StackSize(0, popped.exprs).to_c()
+            return f"{{ STACK_SHRINK({shrink}); goto {label}; }}"
+        return f"goto {label};"
+
+
+class Writer:
+    """Writes lines with indentation."""
+
+    def __init__(self, stream, indent=""):
+        self.stream = stream
+        self.prefix = indent
+
+    def emit(self, line):
+        if line.startswith("#"):
+            # Preprocessor directives stay in the first column
+            self.stream.write(line + "\n")
+        elif line:
+            self.stream.write(self.prefix + line + "\n")
+        else:
+            self.stream.write("\n")
+
+    def indent(self):
+        self.prefix += INDENT
+
+    def dedent(self):
+        self.prefix = self.prefix[:-len(INDENT)]
+
+
+class OpcodeInfo:
+    """What Lib/opcode.py says about the instructions."""
+
+    def __init__(self, filename):
+        namespace = {}
+        with tokenize.open(filename) as fp:
+            code = fp.read()
+        exec(code, namespace)
+        self.opmap = {name: op for name, op in namespace["opmap"].items()
+                      if op < namespace["MIN_PSEUDO_OPCODE"]}
+        self.specializations = namespace["_specializations"]
+        self.deopt = {}
+        for base, family in self.specializations.items():
+            for name in family:
+                self.deopt[name] = base
+        self.cache_entries = {}
+        for name, op in self.opmap.items():
+            self.cache_entries[name] = namespace["_inline_cache_entries"][op]
+
+    def is_known(self, name):
+        return name in self.opmap or name in self.deopt
+
+
+class Analyzer:
+
+    def __init__(self, filename, opcode_py):
+        self.filename = filename
+        with open(filename) as fp:
+            self.src = fp.read()
+        defs = parser.parse(self.src, filename)
+        self.instrs = {name: Instruction(inst, filename)
+                       for name, inst in defs.instrs.items()}
+        self.supers = defs.supers
+        self.opcode = OpcodeInfo(opcode_py)
+
+    def error(self, msg, line="?"):
+        return GeneratorError(f"{self.filename}:{line}: {msg}")
+
+    def check(self):
+        opcode = self.opcode
+        for name in self.instrs:
+            if not opcode.is_known(name):
+                raise self.error(f"{name} is not an opcode in Lib/opcode.py")
+        for name, op in opcode.opmap.items():
+            if name not in self.instrs:
+                raise self.error(f"no definition for opcode {name}")
+        for name, sup in self.supers.items():
+            self.check_super(sup)
+        for name, family in opcode.specializations.items():
+            head = self.instrs.get(name)
+            if head is None or not head.has_stack_effect:
+                continue
+            for member in family:
+                instr = self.instrs.get(member)
+                if instr is None or not instr.has_stack_effect:
+                    continue
+                if (instr.popped != head.popped or
+                        instr.pushed != head.pushed):
+                    raise instr.error(f"stack effect differs from {name}'s")
+
+    def super_problem(self, ops):
+        """Why the instructions cannot make up a superinstruction, or None."""
+        for i, op in enumerate(ops):
+            instr = self.instrs.get(op)
+            if instr is None:
+                return f"{op} is not defined"
+            if not instr.has_stack_effect:
+                return f"{op} does not declare its stack effect"
+            if instr.cache_entries(self.opcode):
+                return f"{op} has inline cache entries"
+            if op in self.opcode.deopt:
+                return f"{op} is a specialized instruction"
+            if instr.predict:
+                return f"{op} predicts the next instruction"
+            if i and instr.uses(CONTROL_FLOW):
+                return f"{op} can fail, deoptimize or jump"
+        return None
+
+    def check_super(self, sup):
+        problem = self.super_problem(sup.ops)
+        if problem:
+            raise self.error(f"{sup.name}: {problem}", sup.line)
+        first = sup.ops[0]
+        if sup.name not in self.opcode.specializations.get(first, ()):
+            raise self.error(
+                f"{sup.name} must be listed in _specializations[{first!r}] "
+                f"in Lib/opcode.py", sup.line)
+
+    # Superinstruction selection
+
+    def canonical_pair(self, first, second):
+        """Map a pair of executed instructions to the pair of unquickened
+        instructions it comes from."""
+        if first in self.supers:
+            first = self.supers[first].ops[-1]
+        if second in self.supers:
+            second = self.supers[second].ops[0]
+        first = self.opcode.deopt.get(first, first)
+        second = self.opcode.deopt.get(second, second)
+        return first, second
+
+    def select_supers(self, filename, count):
+        pairs = collections.Counter()
+        with open(filename) as fp:
+            for line in fp:
+                if not line.strip() or line.startswith("#"):
+                    continue
+                first, second, n = line.split()
+                pairs[self.canonical_pair(first, second)] += int(n)
+        selected = []
+        for (first, second), n in pairs.most_common():
+            if len(selected) == count:
+                break
+            if self.super_problem([first, second]) is None:
+                selected.append((first, second))
+        return sorted(selected)
+
+    def rewrite_supers(self, pairs):
+        begin = parser.find_marker(self.src, parser.BEGIN_SUPER_MARKER)
+        begin += len(parser.BEGIN_SUPER_MARKER) + 1
+        end = parser.find_marker(self.src, parser.END_SUPER_MARKER, begin)
+        lines = [f"super({first}__{second}) = {first} + {second};\n"
+                 for first, second in pairs]
+        self.src = self.src[:begin] + "".join(lines) + self.src[end:]
+        with open(self.filename, "w") as fp:
+            fp.write(self.src)
+        missing = []
+        for first, second in pairs:
+            name = f"{first}__{second}"
+            if name not in self.opcode.specializations.get(first, ()):
+                missing.append((first, name))
+        return missing
+
+    # Output
+
+    def write_cases(self, stream):
+        stream.write(HEADER)
+        out = Writer(stream, INDENT * 2)
+        for instr in self.instrs.values():
+            out.emit("")
+            self.write_instr(out, instr)
+        for sup in self.supers.values():
+            out.emit("")
+            self.write_super(out, sup)
+
+    def write_instr(self, out, instr):
+        if not instr.has_stack_effect:
+            # Copied verbatim
+            block = instr.inst.block
+            if block.indent != out.prefix:
+                raise instr.error("badly indented")
+            out.emit(f"TARGET({instr.name}) {block.text}")
+            return
+        out.emit(f"TARGET({instr.name}) {{")
+        out.indent()
+        instr.write_stack_effect_body(out)
+        out.emit("DISPATCH();")
+        out.dedent()
+        out.emit("}")
+
+    def write_super(self, out, sup):
+        out.emit(f"TARGET({sup.name}) {{")
+        out.indent()
+        for i, op in enumerate(sup.ops):
+            if i:
+                out.emit("NEXTOPARG();")
+                out.emit("next_instr++;")
+            out.emit("{")
+            out.indent()
+            self.instrs[op].write_stack_effect_body(out, in_super=True)
+            out.dedent()
+            out.emit("}")
+        out.emit("NOTRACE_DISPATCH();")
+        out.dedent()
+        out.emit("}")
+
+    def write_metadata(self, stream):
+        stream.write(HEADER)
+        out = Writer(stream)
+        out.emit("")
+        out.emit("#ifndef Py_BUILD_CORE")
+        out.emit('#  error "this header requires Py_BUILD_CORE define"')
+        out.emit("#endif")
+        for which in "popped", "pushed":
+            out.emit("")
+            self.write_stack_effect_function(out, which)
+        out.emit("")
+        self.write_super_function(out)
+
+    def write_stack_effect_function(self, out, which):
+        out.emit(f"/* The number of stack items {which} by an instruction, or "
+                 f"-1 if it doesn't")
+        out.emit("   declare its stack effect in Python/bytecodes.c. */")
+        out.emit("static inline int")
+        out.emit(f"_PyOpcode_num_{which}(int opcode, int oparg)")
+        out.emit("{")
+        out.indent()
+        out.emit("switch (opcode) {")
+        out.indent()
+        for instr in self.instrs.values():
+            if not instr.has_stack_effect:
+                continue
+            size = getattr(instr, which)
+            out.emit(f"case {instr.name}:")
+            out.emit(f"{INDENT}return {size.to_c()};")
+        out.emit("default:")
+        out.emit(f"{INDENT}return -1;")
+        out.dedent()
+        out.emit("}")
+        out.dedent()
+        out.emit("}")
+
+    def write_super_function(self, out):
+        out.emit("/* The superinstruction made of the instructions first and "
+                 "second, or 0. */")
+        out.emit("static inline int")
+        out.emit("_PyOpcode_super_instruction(int first, int second)")
+        out.emit("{")
+        out.indent()
+        by_first = collections.defaultdict(list)
+        for sup in self.supers.values():
+            by_first[sup.ops[0]].append(sup)
+        if by_first:
+            out.emit("switch (first) {")
+            out.indent()
+            for first in sorted(by_first):
+                out.emit(f"case {first}:")
+                out.indent()
+                out.emit("switch (second) {")
+                out.indent()
+                for sup in sorted(by_first[first], key=lambda s: s.ops[1]):
+                    out.emit(f"case {sup.ops[1]}:")
+                    out.emit(f"{INDENT}return {sup.name};")
+                out.dedent()
+                out.emit("}")
+                out.emit("break;")
+                out.dedent()
+            out.dedent()
+            out.emit("}")
+        out.emit("return 0;")
+        out.dedent()
+        out.emit("}")
+
+
+def write_file(filename, write):
+    tmp = filename + ".tmp"
+    with open(tmp, "w") as stream:
+        write(stream)
+    os.replace(tmp, filename)
+
+
+arg_parser = argparse.ArgumentParser(
+    description="Generate the interpreter cases from Python/bytecodes.c")
+arg_parser.add_argument("-i", "--input", default=DEFAULT_INPUT,
+                        help="instruction definitions")
+arg_parser.add_argument("-o", "--output", default=DEFAULT_OUTPUT,
+                        help="generated interpreter cases")
+arg_parser.add_argument("-m", "--metadata", default=DEFAULT_METADATA,
+                        help="generated instruction metadata")
+arg_parser.add_argument("--opcode-py", default=DEFAULT_OPCODE_PY,
+                        help="path to Lib/opcode.py")
+arg_parser.add_argument("--pair-counts", metavar="FILE",
+                        help="select superinstructions from the pair counts "
+                             "written by Tools/scripts/summarize_stats.py "
+                             "--pair-counts")
+arg_parser.add_argument("-n", "--superinstructions", type=int, default=8,
+                        metavar="N",
+                        help="number of superinstructions to select "
+                             "(default: %(default)s)")
+
+
+def main(argv=None):
+    args = arg_parser.parse_args(argv)
+    try:
+        analyzer = Analyzer(args.input, args.opcode_py)
+        if args.pair_counts:
+            pairs = analyzer.select_supers(args.pair_counts,
+                                           args.superinstructions)
+            missing = analyzer.rewrite_supers(pairs)
+            print(f"Selected {len(pairs)} superinstructions in {args.input}")
+            if missing:
+                print("Add them to Lib/opcode.py and regenerate the opcode "
+                      "tables (make regen-opcode regen-opcode-targets):")
+                for first, name in missing:
+                    print(f"    _specializations[{first!r}]: {name!r}")
+                return 1
+            analyzer = Analyzer(args.input, args.opcode_py)
+        analyzer.check()
+    except (GeneratorError, parser.ParseError, lexer.LexError) as exc:
+        print(exc, file=sys.stderr)
+        return 1
+    write_file(args.output, analyzer.write_cases)
+    write_file(args.metadata, analyzer.write_metadata)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
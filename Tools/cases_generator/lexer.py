@@ -0,0 +1,69 @@
+"""A lexer for the subset of C used in Python/bytecodes.c.
+
+It only needs to be good enough to find the instruction definitions and to
+match parentheses and braces; everything else is passed through verbatim.
+"""
+
+import re
+from dataclasses import dataclass
+
+
+@dataclass
+class Token:
+    kind: str
+    text: str
+    begin: int  # Offset of the first character
+    end: int  # Offset after the last character
+    line: int
+
+    def __repr__(self):
+        return f"{self.kind}({self.text!r})@{self.line}"
+
+
+COMMENT = r"/\*(?:.|\n)*?\*/|//[^\n]*"
+STRING = r'"(?:\\.|[^"\\\n])*"'
+CHARACTER = r"'(?:\\.|[^'\\\n])*'"
+IDENTIFIER = r"[A-Za-z_][A-Za-z_0-9]*"
+NUMBER = r"(?:0[xX][0-9a-fA-F]+|[0-9]+\.?[0-9]*(?:[eE][-+]?[0-9]+)?)[uUlLfF]*"
+NEWLINE = r"\n"
+WHITESPACE = r"[ \t\f\v\r]+"
+PREPROCESSOR = r"^[ \t]*\#(?:\\\n|[^\n])*"
+OPERATOR = r"--|->|<<=|>>=|[-+*/%&|^=!<>]=|&&|\|\||<<|>>|\+\+|[-+*/%&|^~!=<>?:.,;()\[\]{}]"
+
+_TOKENS = [
+    ("COMMENT", COMMENT),
+    ("PREPROCESSOR", PREPROCESSOR),
+    ("STRING", STRING),
+    ("CHARACTER", CHARACTER),
+    ("IDENTIFIER", IDENTIFIER),
+    ("NUMBER", NUMBER),
+    ("NEWLINE", NEWLINE),
+    ("WHITESPACE", WHITESPACE),
+    ("OPERATOR", OPERATOR),
+]
+_REGEX = re.compile(
+    "|".join(f"(?P<{kind}>{pattern})" for kind, pattern in _TOKENS),
+    re.MULTILINE,
+)
+
+# Tokens which are of no interest to the parser
+TRIVIA = frozenset({"COMMENT", "PREPROCESSOR", "NEWLINE", "WHITESPACE"})
+
+
+class LexError(Exception):
+    pass
+
+
+def tokenize(src, line=1, trivia=False):
+    """Yield the tokens of src; line is the line number of its start."""
+    pos = 0
+    while pos < len(src):
+        m = _REGEX.match(src, pos)
+        if m is None:
+            raise LexError(f"line {line}: unexpected character {src[pos]!r}")
+        kind = m.lastgroup
+        text = m.group()
+        if trivia or kind not in TRIVIA:
+            yield Token(kind, text, pos, m.end(), line)
+        line += text.count("\n")
+        pos = m.end()
@@ -0,0 +1,244 @@
+"""Parser for the instruction definitions in Python/bytecodes.c.
+
+The definitions are found between the "// BEGIN BYTECODES //" and
+"// END BYTECODES //" markers, and between "// BEGIN SUPERINSTRUCTIONS //"
+and "// END SUPERINSTRUCTIONS //":
+
+    inst(NAME) { ... }
+    inst(NAME, (input1, input2[oparg] -- output1)) { ... }
+    super(NAME) = FIRST + SECOND;
+
+See Tools/cases_generator/README.md for their meaning.
+"""
+
+from __future__ import annotations
+
+import re
+from dataclasses import dataclass, field
+
+import lexer
+
+BEGIN_MARKER = "// BEGIN BYTECODES //"
+END_MARKER = "// END BYTECODES //"
+BEGIN_SUPER_MARKER = "// BEGIN SUPERINSTRUCTIONS //"
+END_SUPER_MARKER = "// END SUPERINSTRUCTIONS //"
+
+
+class ParseError(Exception):
+    pass
+
+
+def find_marker(src, marker, pos=0):
+    """Return the offset of the marker, which must be on a line of its
+    own, or -1."""
+    m = re.compile(rf"^{re.escape(marker)}$", re.M).search(src, pos)
+    return m.start() if m else -1
+
+
+@dataclass
+class StackItem:
+    name: str
+    size: str = ""  # C expression for arrays, "" for a single item
+
+    @property
+    def is_unused(self):
+        return self.name == "unused"
+
+
+@dataclass
+class Block:
+    text: str  # The source text, including the braces
+    line: int  # The line number of the opening brace
+    indent: str  # The indentation of the line holding the closing brace
+
+
+@dataclass
+class InstDef:
+    name: str
+    block: Block
+    # None if the instruction doesn't declare its stack effect
+    inputs: list[StackItem] | None = None
+    outputs: list[StackItem] | None = None
+
+    @property
+    def has_stack_effect(self):
+        return self.inputs is not None
+
+
+@dataclass
+class SuperDef:
+    name: str
+    ops: list[str]
+    line: int
+
+
+@dataclass
+class Definitions:
+    instrs: dict[str, InstDef] = field(default_factory=dict)
+    supers: dict[str, SuperDef] = field(default_factory=dict)
+
+
+class Parser:
+
+    def __init__(self, src, filename):
+        self.src = src
+        self.filename = filename
+
+    def error(self, msg, token=None):
+        line = token.line if token is not None else "?"
+        return ParseError(f"{self.filename}:{line}: {msg}")
+
+    def section(self, begin, end):
+        # The markers must be on lines of their own
+        start = find_marker(self.src, begin)
+        stop = find_marker(self.src, end, start)
+        if start < 0 or stop < 0:
+            raise self.error(f"missing {begin!r} or {end!r}")
+        start += len(begin)
+        line = self.src.count("\n", 0, start) + 1
+        return start, stop, line
+
+    def parse(self):
+        defs = Definitions()
+        start, stop, line = self.section(BEGIN_MARKER, END_MARKER)
+        self.tokens = list(lexer.tokenize(self.src[start:stop], line))
+        self.offset = start
+        self.pos = 0
+        while not self.at_end():
+            inst = self.inst_def()
+            if inst.name in defs.instrs:
+                raise self.error(f"duplicate definition of {inst.name}")
+            defs.instrs[inst.name] = inst
+        start, stop, line = self.section(BEGIN_SUPER_MARKER, END_SUPER_MARKER)
+        self.tokens = list(lexer.tokenize(self.src[start:stop], line))
+        self.offset = start
+        self.pos = 0
+        while not self.at_end():
+            sup = self.super_def()
+            if sup.name in defs.supers or sup.name in defs.instrs:
+                raise self.error(f"duplicate definition of {sup.name}")
+            defs.supers[sup.name] = sup
+        return defs
+
+    # Token helpers
+
+    def at_end(self):
+        return self.pos >= len(self.tokens)
+
+    def peek(self):
+        if self.at_end():
+            return None
+        return self.tokens[self.pos]
+
+    def next(self):
+        token = self.peek()
+        if token is None:
+            raise self.error("unexpected end of input", self.tokens[-1])
+        self.pos += 1
+        return token
+
+    def expect(self, text=None, kind=None):
+        token = self.next()
+        if (text is not None and token.text != text or
+                kind is not None and token.kind != kind):
+            raise self.error(f"expected {text or kind}, got {token.text!r}",
+                             token)
+        return token
+
+    def accept(self, text):
+        token = self.peek()
+        if token is not None and token.text == text:
+            self.pos += 1
+            return token
+        return None
+
+    # Grammar
+
+    def inst_def(self):
+        self.expect("inst")
+        self.expect("(")
+        name = self.expect(kind="IDENTIFIER").text
+        inputs = outputs = None
+        if self.accept(","):
+            inputs, outputs = self.stack_effect()
+        self.expect(")")
+        block = self.block()
+        return InstDef(name, block, inputs, outputs)
+
+    def stack_effect(self):
+        # '(' [items] '--' [items] ')'
+        self.expect("(")
+        inputs = self.stack_items("--")
+        self.expect("--")
+        outputs = self.stack_items(")")
+        close = self.expect(")")
+        for items in inputs, outputs:
+            names = [item.name for item in items if not item.is_unused]
+            for name in names:
+                if names.count(name) > 1:
+                    raise self.error(f"duplicate stack item {name!r}", close)
+        return inputs, outputs
+
+    def stack_items(self, stop):
+        items = []
+        while self.peek() is not None and self.peek().text != stop:
+            items.append(self.stack_item())
+            if not self.accept(","):
+                break
+        return items
+
+    def stack_item(self):
+        name = self.expect(kind="IDENTIFIER").text
+        size = ""
+        if self.accept("["):
+            size = self.balanced("[", "]")
+        return StackItem(name, size)
+
+    def balanced(self, opening, closing):
+        """Return the text up to the matching closing token, consuming it."""
+        depth = 1
+        first = self.peek()
+        while True:
+            token = self.next()
+            if token.text == opening:
+                depth += 1
+            elif token.text == closing:
+                depth -= 1
+                if depth == 0:
+                    break
+        if first is token:
+            raise self.error(f"empty {opening}{closing}", token)
+        return self.src[self.offset + first.begin:self.offset + token.begin]
+
+    def block(self):
+        start = self.expect("{")
+        depth = 1
+        while depth:
+            token = self.next()
+            if token.text == "{":
+                depth += 1
+            elif token.text == "}":
+                depth -= 1
+        begin = self.offset + start.begin
+        end = self.offset + token.end
+        line_start = self.src.rfind("\n", 0, end - 1) + 1
+        indent = self.src[line_start:end - 1]
+        if indent.strip():
+            raise self.error("closing brace must be on its own line", token)
+        return Block(self.src[begin:end], start.line, indent)
+
+    def super_def(self):
+        token = self.expect("super")
+        self.expect("(")
+        name = self.expect(kind="IDENTIFIER").text
+        self.expect(")")
+        self.expect("=")
+        first = self.expect(kind="IDENTIFIER").text
+        self.expect("+")
+        second = self.expect(kind="IDENTIFIER").text
+        self.expect(";")
+        return SuperDef(name, [first, second], token.line)
+
+
+def parse(src, filename="<string>"):
+    return Parser(src, filename).parse()
@@ -28,6 +28,11 @@
 except AttributeError:
     pass
 
+try:
+    import queue
+except ImportError:
+    import Queue as queue
+
 
 THROUGHPUT_DURATION = 2.0
 
@@ -37,6 +42,9 @@
 BANDWIDTH_PACKET_SIZE = 1024
 BANDWIDTH_DURATION = 2.0
 
+QUEUE_ITEMS = 100000
+QUEUE_BATCH_SIZE = 100
+
 
 def task_pidigits():
     """Pi calculation (Python)"""
@@ -520,6 +528,83 @@ def run_bandwidth_tests(max_threads):
         print()
 
 
+def _make_queue():
+    # SimpleQueue is new in Python 3.7
+    if hasattr(queue, 'SimpleQueue'):
+        return queue.SimpleQueue()
+    return queue.Queue()
+
+def _queue_producer(q, nitems, batch_size):
+    if batch_size:
+        batch = list(range(batch_size))
+        _put_many = q.put_many
+        for i in xrange(nitems // batch_size):
+            _put_many(batch)
+    else:
+        _put = q.put
+        for i in xrange(nitems):
+            _put(i)
+
+def _queue_consumer(q, nitems, batch_size):
+    if batch_size:
+        _get_many = q.get_many
+        n = 0
+        while n < nitems:
+            # Don't take items another consumer is waiting for
+            n += len(_get_many(min(batch_size, nitems - n)))
+    else:
+        _get = q.get
+        for i in xrange(nitems):
+            _get()
+
+def run_queue_test(nthreads, batch_size):
+    # nthreads producers hand QUEUE_ITEMS items each over to nthreads
+    # consumers through a single queue.
+    q = _make_queue()
+    nitems = QUEUE_ITEMS
+    if batch_size:
+        nitems -= nitems % batch_size
+
+    threads = []
+    for i in range(nthreads):
+        threads.append(threading.Thread(target=_queue_producer,
+                                        args=(q, nitems, batch_size)))
+        threads.append(threading.Thread(target=_queue_consumer,
+                                        args=(q, nitems, batch_size)))
+    start_time = time.time()
+    for t in threads:
+        t.daemon = True
+        t.start()
+    for t in threads:
+        t.join()
+    end_time = time.time()
+
+    return nthreads * nitems / (end_time - start_time)
+
+def run_queue_tests(max_threads):
+    q = _make_queue()
+    modes = [("%s.put() / get()" % type(q).__name__, 0)]
+    if hasattr(q, 'put_many'):
+        modes.append(("%s.put_many() / get_many(), batches of %d"
+                      % (type(q).__name__, QUEUE_BATCH_SIZE),
+                      QUEUE_BATCH_SIZE))
+    for desc, batch_size in modes:
+        print(desc)
+        print()
+        nthreads = 1
+        baseline_speed = None
+        while nthreads <= max_threads:
+            speed = run_queue_test(nthreads, batch_size)
+            print("producers=consumers=%d: %d" % (nthreads, speed), end="")
+            if baseline_speed is None:
+                print(" items/s.")
+                baseline_speed = speed
+            else:
+                print(" ( %d %%)" % (speed / baseline_speed * 100))
+            nthreads += 1
+        print()
+
+
 def main():
     usage = "usage: %prog [-h|--help] [options]"
     parser = OptionParser(usage=usage)
@@ -532,6 +617,9 @@ def main():
     parser.add_option("-b", "--bandwidth",
                       action="store_true", dest="bandwidth", default=False,
                       help="run I/O bandwidth tests")
+    parser.add_option("-q", "--queue",
+                      action="store_true", dest="queue", default=False,
+                      help="run queue handoff tests")
     parser.add_option("-i", "--interval",
                       action="store", type="int", dest="check_interval", default=None,
                       help="sys.setcheckinterval() value "
@@ -540,6 +628,10 @@ def main():
                       action="store", type="float", dest="switch_interval", default=None,
                       help="sys.setswitchinterval() value "
                            "(Python 3.2 and newer)")
+    parser.add_option("-P", "--gil-priority",
+                      action="store_true", dest="gil_priority", default=False,
+                      help="hand the GIL first to threads leaving I/O "
+                           "(sys._setgilpriority(), Python 3.12 and newer)")
     parser.add_option("-n", "--num-threads",
                       action="store", type="int", dest="nthreads", default=4,
                       help="max number of threads in tests")
@@ -566,12 +658,16 @@ def main():
         bandwidth_client(**kwargs)
         return
 
-    if not options.throughput and not options.latency and not options.bandwidth:
+    if (not options.throughput and not options.latency
+        and not options.bandwidth and not options.queue):
         options.throughput = options.latency = options.bandwidth = True
+        options.queue = True
     if options.check_interval:
         sys.setcheckinterval(options.check_interval)
     if options.switch_interval:
         sys.setswitchinterval(options.switch_interval)
+    if options.gil_priority:
+        sys._setgilpriority(True)
 
     print("== %s %s (%s) ==" % (
         platform.python_implementation(),
@@ -602,5 +698,10 @@ def main():
         print()
         run_bandwidth_tests(options.nthreads)
 
+    if options.queue:
+        print("--- Queue handoff ---")
+        print()
+        run_queue_tests(options.nthreads)
+
 if __name__ == "__main__":
     main()
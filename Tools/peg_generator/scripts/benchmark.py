@@ -4,16 +4,14 @@
 import ast
 import sys
 import os
-from time import time
+from time import perf_counter
 
 try:
     import memory_profiler
 except ModuleNotFoundError:
-    print(
-        "Please run `make venv` to create a virtual environment and install"
-        " all the dependencies, before running this script."
-    )
-    sys.exit(1)
+    # Only the memory usage is not reported: run `make venv` to create a
+    # virtual environment with all the dependencies.
+    memory_profiler = None
 
 sys.path.insert(0, os.getcwd())
 from scripts.test_parse_directory import parse_directory
@@ -28,6 +26,11 @@
     default="xxl",
     help="Which target to use for the benchmark (default is xxl.py)",
 )
+argparser.add_argument(
+    "--file",
+    action="store",
+    help="Benchmark this file instead of the target",
+)
 
 subcommands = argparser.add_subparsers(title="Benchmarks", dest="subcommand")
 command_compile = subcommands.add_parser(
@@ -37,17 +40,21 @@
 
 
 def benchmark(func):
-    def wrapper(*args):
+    def wrapper(source):
         times = list()
         for _ in range(3):
-            start = time()
-            result = func(*args)
-            end = time()
+            start = perf_counter()
+            result = func(source)
+            end = perf_counter()
             times.append(end - start)
-        memory = memory_profiler.memory_usage((func, args))
+        size = len(source.encode("utf-8")) / 2**20
         print(f"{func.__name__}")
         print(f"\tTime: {sum(times)/3:.3f} seconds on an average of 3 runs")
-        print(f"\tMemory: {max(memory)} MiB on an average of 3 runs")
+        print(f"\tThroughput: {size / min(times):.2f} MB/s on the best of 3 runs"
+              f" ({size:.2f} MB of source)")
+        if memory_profiler is not None:
+            memory = memory_profiler.memory_usage((func, (source,)))
+            print(f"\tMemory: {max(memory)} MiB on an average of 3 runs")
         return result
 
     return wrapper
@@ -63,7 +70,7 @@ def time_parse(source):
     return ast.parse(source)
 
 
-def run_benchmark_xxl(subcommand, source):
+def run_benchmark_source(subcommand, source):
     if subcommand == "compile":
         time_compile(source)
     elif subcommand == "parse":
@@ -93,10 +100,13 @@ def main():
     if subcommand is None:
         argparser.error("A benchmark to run is required")
 
-    if target == "xxl":
+    if args.file is not None:
+        with open(args.file, "r", encoding="utf-8") as f:
+            run_benchmark_source(subcommand, f.read())
+    elif target == "xxl":
         with open(os.path.join("data", "xxl.py"), "r") as f:
             source = f.read()
-            run_benchmark_xxl(subcommand, source)
+            run_benchmark_source(subcommand, source)
     elif target == "stdlib":
         run_benchmark_stdlib(subcommand)
 
@@ -2,6 +2,7 @@
 default stats folders.
 """
 
+import argparse
 import collections
 import os.path
 import opcode
@@ -324,7 +325,7 @@ def get_total(opcode_stats):
             total += opcode_stat['execution_count']
     return total
 
-def emit_pair_counts(opcode_stats, total):
+def get_pair_counts(opcode_stats):
     pair_counts = []
     for i, opcode_stat in enumerate(opcode_stats):
         if i == 0:
@@ -334,6 +335,20 @@ def emit_pair_counts(opcode_stats, total):
                 x, _, _ = key[11:].partition("]")
                 if value:
                     pair_counts.append((value, (i, int(x))))
+    return pair_counts
+
+def write_pair_counts(opcode_stats, filename):
+    """Write the pair counts, as read by
+    Tools/cases_generator/generate_cases.py --pair-counts."""
+    pair_counts = get_pair_counts(opcode_stats)
+    pair_counts.sort(reverse=True)
+    with open(filename, "w") as fp:
+        fp.write("# first second count\n")
+        for count, (i, j) in pair_counts:
+            fp.write(f"{opname[i]} {opname[j]} {count}\n")
+
+def emit_pair_counts(opcode_stats, total):
+    pair_counts = get_pair_counts(opcode_stats)
     with Section("Pair counts", summary="Pair counts for top 100 pairs"):
         pair_counts.sort(reverse=True)
         cumulative = 0
@@ -378,8 +393,16 @@ def emit_pair_counts(opcode_stats, total):
                 )
 
 def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--pair-counts", metavar="FILE",
+                        help="only write the instruction pair counts to FILE, "
+                             "for Tools/cases_generator/generate_cases.py")
+    args = parser.parse_args()
     stats = gather_stats()
     opcode_stats = extract_opcode_stats(stats)
+    if args.pair_counts:
+        write_pair_counts(opcode_stats, args.pair_counts)
+        return
     total = get_total(opcode_stats)
     emit_execution_counts(opcode_stats, total)
     emit_pair_counts(opcode_stats, total)